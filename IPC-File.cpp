@@ -3,10 +3,1625 @@
 using namespace IPCFile;
 
 /**
- * Debug Tests
- * TODO make a proper test harness
+ * Every consumed response has to take its GET out of the pending buffer,
+ * or plain GETs start failing once a full buffer of them has been answered
  */
-int main(int argc, char* argv[])
+static bool TestPendingGetsDrainOnResponse()
+{
+    // Drop from the GET buffer so only the pending buffer can fill up
+    FBufferCapacityConfig GetConfig;
+    GetConfig.Policy = EBackpressurePolicy::DROP_OLDEST;
+    IPCFileManager::UE_ConfigureGetRequestBuffer(GetConfig);
+
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestPendingDrain");
+    FPlayerAttributeList Response;
+    Response.SetPlayerAuthID(PlayerAuth);
+    const size_t NumberOfGets = FBufferCapacityConfig().Capacity + 1024;
+    bool bPassed = true;
+    for(size_t i = 0; i < NumberOfGets && bPassed; ++i)
+    {
+        const FRequestID RequestID = IPCFileManager::GenerateUniqueRequestID();
+        bPassed = IPCFileManager::UE_AddGetRequestToBuffer(FGetRequest(
+            PlayerAuth, RequestID, { EAttributeName::IS_ONLINE }));
+        IPCFileManager::UE_ResolveGetResponse(RequestID, Response);
+    }
+
+    IPCFileManager::UE_Shutdown();
+    IPCFileManager::UE_ConfigureGetRequestBuffer(FBufferCapacityConfig());
+    return bPassed;
+}
+
+/**
+ * A GET dropped to make room will never be answered, so its future has to
+ * fail and its pending entry has to go, while the GETs that stayed still wait
+ */
+static bool TestDroppedGetFailsItsFuture()
+{
+    FBufferCapacityConfig GetConfig;
+    GetConfig.Capacity = 16;
+    GetConfig.Policy = EBackpressurePolicy::DROP_OLDEST;
+    IPCFileManager::UE_ConfigureGetRequestBuffer(GetConfig);
+
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestDroppedGet");
+    std::vector<FGetFuture> Futures;
+    for(size_t i = 0; i <= GetConfig.Capacity; ++i)
+    {
+        Futures.push_back(IPCFileManager::UE_GetAsync(FGetRequest(
+            PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), { EAttributeName::IS_ONLINE })));
+    }
+
+    FPendingGetRequest PendingRequest;
+    bool bPassed = Futures.front().GetStatus() == EAsyncGetStatus::FAILED &&
+        !IPCFileManager::UE_TakePendingGetRequest(Futures.front().GetRequestID(), PendingRequest) &&
+        Futures.back().GetStatus() == EAsyncGetStatus::PENDING &&
+        IPCFileManager::UE_TakePendingGetRequest(Futures.back().GetRequestID(), PendingRequest);
+
+    IPCFileManager::UE_Shutdown();
+    IPCFileManager::UE_ConfigureGetRequestBuffer(FBufferCapacityConfig());
+    return bPassed;
+}
+
+/**
+ * Taking an answered GET out of the pending table must not reorder the rest,
+ * or dropping the oldest pending GET drops a newer one instead
+ */
+static bool TestPendingTakeKeepsOrder()
+{
+    FBufferCapacityConfig PendingConfig;
+    PendingConfig.Capacity = 8;
+    PendingConfig.Policy = EBackpressurePolicy::DROP_OLDEST;
+    IPCFileManager::UE_ConfigurePendingGetRequestBuffer(PendingConfig);
+
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestPendingOrder");
+    std::vector<FRequestID> RequestIDs;
+    const auto AddGet = [&]()
+    {
+        RequestIDs.push_back(IPCFileManager::GenerateUniqueRequestID());
+        IPCFileManager::UE_AddGetRequestToBuffer(FGetRequest(
+            PlayerAuth, RequestIDs.back(), { EAttributeName::IS_ONLINE }));
+    };
+    for(size_t i = 0; i < PendingConfig.Capacity; ++i)
+    {
+        AddGet();
+    }
+
+    // The first is answered, then the table overflows by one
+    FPendingGetRequest PendingRequest;
+    bool bPassed = IPCFileManager::UE_TakePendingGetRequest(RequestIDs[0], PendingRequest);
+    AddGet();
+    AddGet();
+    bPassed = bPassed &&
+        !IPCFileManager::UE_TakePendingGetRequest(RequestIDs[1], PendingRequest);
+    for(size_t i = 2; i < RequestIDs.size(); ++i)
+    {
+        bPassed = bPassed &&
+            IPCFileManager::UE_TakePendingGetRequest(RequestIDs[i], PendingRequest) &&
+            PendingRequest.GetRequestID() == RequestIDs[i];
+    }
+
+    IPCFileManager::UE_Shutdown();
+    IPCFileManager::UE_ConfigurePendingGetRequestBuffer(FBufferCapacityConfig());
+    return bPassed;
+}
+
+static FSetRequest MakeNameSetRequest(const IAttributeString& PlayerAuth, const std::string& Name)
+{
+    FPlayerAttributeList Attributes;
+    Attributes.SetPlayerAuthID(PlayerAuth);
+    Attributes.SetPlayerName(IAttributeString(EAttributeName::PLAYER_NAME, Name));
+    return FSetRequest(PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), Attributes);
+}
+
+/**
+ * A full buffer has to reject, spill or block as configured, a blocked push
+ * has to go through as soon as the write thread makes room, and the watermark
+ * callback has to fire once on the way up and once on the way down
+ */
+static bool TestBufferPoliciesAndWatermarks()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCBufferPolicies";
+    std::filesystem::create_directories(Directory);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestBufferPolicies");
+
+    std::vector<std::pair<EWatermarkEvent, size_t>> Events;
+    FBufferCapacityConfig Config;
+    Config.Capacity = 4;
+    Config.Policy = EBackpressurePolicy::REJECT;
+    Config.HighWatermark = 3;
+    Config.LowWatermark = 1;
+    Config.WatermarkCallback = [&Events](const EWatermarkEvent Event, const size_t Size)
+    {
+        Events.emplace_back(Event, Size);
+    };
+    IPCFileManager::UE_ConfigureSetRequestBuffer(Config);
+    bool bPassed = true;
+    for(size_t i = 0; i < Config.Capacity; ++i)
+    {
+        bPassed = IPCFileManager::UE_AddSetRequestToBuffer(
+            MakeNameSetRequest(PlayerAuth, std::to_string(i))) && bPassed;
+    }
+    bPassed = bPassed && !IPCFileManager::UE_AddSetRequestToBuffer(
+        MakeNameSetRequest(PlayerAuth, "Rejected"));
+    // Emptying the buffer takes it past the low watermark
+    IPCFileManager::UE_Shutdown();
+    bPassed = bPassed && Events.size() == 2 &&
+        Events[0].first == EWatermarkEvent::HIGH && Events[0].second == 3 &&
+        Events[1].first == EWatermarkEvent::LOW && Events[1].second == 0;
+
+    // SPILL_TO_DISK writes the full buffer out and takes the push
+    Config.Policy = EBackpressurePolicy::SPILL_TO_DISK;
+    Config.SpillDirectory = Directory.string() + "/";
+    Config.WatermarkCallback = nullptr;
+    IPCFileManager::UE_ConfigureSetRequestBuffer(Config);
+    for(size_t i = 0; i <= Config.Capacity; ++i)
+    {
+        bPassed = IPCFileManager::UE_AddSetRequestToBuffer(
+            MakeNameSetRequest(PlayerAuth, std::to_string(i))) && bPassed;
+    }
+    bPassed = bPassed && !std::filesystem::is_empty(Directory);
+    IPCFileManager::UE_Shutdown();
+
+    // BLOCK waits for the write thread's flush rather than the whole timeout
+    Config.Policy = EBackpressurePolicy::BLOCK;
+    Config.BlockTimeoutMS = 5000;
+    IPCFileManager::UE_ConfigureSetRequestBuffer(Config);
+    IPCFileManager::UE_Initialize();
+    for(size_t i = 0; i < Config.Capacity; ++i)
+    {
+        IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, std::to_string(i)));
+    }
+    std::thread Flusher([&Directory, &Config]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        FFlushTriggerConfig FlushConfig;
+        FlushConfig.FlushDirectory = Directory.string() + "/";
+        FlushConfig.MaxCount = Config.Capacity;
+        IPCFileManager::UE_ConfigureSetRequestFlush(FlushConfig);
+    });
+    const auto BlockStart = std::chrono::steady_clock::now();
+    bPassed = IPCFileManager::UE_AddSetRequestToBuffer(
+        MakeNameSetRequest(PlayerAuth, "Blocked")) && bPassed;
+    bPassed = bPassed &&
+        std::chrono::steady_clock::now() - BlockStart < std::chrono::milliseconds(2500);
+    Flusher.join();
+
+    IPCFileManager::UE_ConfigureSetRequestFlush(FFlushTriggerConfig());
+    IPCFileManager::UE_Shutdown();
+    IPCFileManager::UE_ConfigureSetRequestBuffer(FBufferCapacityConfig());
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * A bulk GET add that only partly fits has to leave exactly the added GETs
+ * pending and the rest untouched, and emplaced and moved SETs have to be
+ * written just like copied ones
+ */
+static bool TestBulkAndEmplaceAdds()
+{
+    FBufferCapacityConfig GetConfig;
+    GetConfig.Capacity = 4;
+    IPCFileManager::UE_ConfigureGetRequestBuffer(GetConfig);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestBulkAdds");
+    std::vector<FGetRequest> GetRequests;
+    std::vector<FRequestID> RequestIDs;
+    for(size_t i = 0; i < GetConfig.Capacity + 2; ++i)
+    {
+        RequestIDs.push_back(IPCFileManager::GenerateUniqueRequestID());
+        GetRequests.emplace_back(PlayerAuth, RequestIDs.back(),
+            std::vector<EAttributeName>{ EAttributeName::IS_ONLINE });
+    }
+    const size_t NumberAdded = IPCFileManager::UE_MoveGetRequestsToBuffer(
+        GetRequests.data(), GetRequests.size());
+    bool bPassed = NumberAdded == GetConfig.Capacity;
+    FPendingGetRequest PendingRequest;
+    for(size_t i = 0; i < GetRequests.size(); ++i)
+    {
+        const bool bWasAdded = i < NumberAdded;
+        bPassed = bPassed &&
+            IPCFileManager::UE_TakePendingGetRequest(RequestIDs[i], PendingRequest) == bWasAdded &&
+            (bWasAdded || GetRequests[i].GetPlayerAuthIDString() == "TestBulkAdds");
+    }
+    IPCFileManager::UE_Shutdown();
+    IPCFileManager::UE_ConfigureGetRequestBuffer(FBufferCapacityConfig());
+
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCBulkAdds";
+    std::filesystem::create_directories(Directory);
+    FPlayerAttributeList Attributes;
+    Attributes.SetPlayerAuthID(PlayerAuth);
+    Attributes.SetPlayerName(IAttributeString(EAttributeName::PLAYER_NAME, "0"));
+    bPassed = IPCFileManager::UE_EmplaceSetRequestToBuffer(
+        PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), Attributes) && bPassed;
+    std::vector<FSetRequest> SetRequests;
+    SetRequests.push_back(MakeNameSetRequest(PlayerAuth, "1"));
+    SetRequests.push_back(MakeNameSetRequest(PlayerAuth, "2"));
+    bPassed = bPassed &&
+        IPCFileManager::UE_MoveSetRequestsToBuffer(SetRequests.data(), SetRequests.size()) == 2;
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+
+    std::vector<FSetRequest> Written;
+    std::error_code Error;
+    for(const auto& Entry : std::filesystem::directory_iterator(Directory, Error))
+    {
+        IPCFileManager::ReadSetRequestsFromFile(Entry.path().string(), Written);
+    }
+    bPassed = bPassed && Written.size() == 3;
+    for(size_t i = 0; i < Written.size() && bPassed; ++i)
+    {
+        bPassed = Written[i].GetPlayerAttributeList().GetPlayerName().Value == std::to_string(i);
+    }
+
+    IPCFileManager::UE_Shutdown();
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * A delta SET that undoes a SET still waiting to be written has to go out,
+ * it is only unchanged against the newest value staged for the player
+ */
+static bool TestDeltaSetUndoesUnwrittenSet()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCDeltaSetUndo";
+    std::filesystem::create_directories(Directory);
+    IPCFileManager::UE_SetUseDeltaSetRequests(true);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestDeltaSetUndo");
+
+    // A is written and acknowledged, B is buffered but not written yet
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "A"));
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "B"));
+
+    const uint64_t DroppedBefore = IPCFileManager::UE_GetNumberOfUnchangedSetsDropped();
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "A"));
+    bool bPassed = IPCFileManager::UE_GetNumberOfUnchangedSetsDropped() == DroppedBefore;
+    // Against the staged A a repeat is unchanged
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "A"));
+    bPassed = bPassed && IPCFileManager::UE_GetNumberOfUnchangedSetsDropped() == DroppedBefore + 1;
+
+    IPCFileManager::UE_Shutdown();
+    IPCFileManager::UE_SetUseDeltaSetRequests(false);
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * The compact buffers have to follow the same backpressure policies as the
+ * regular ones instead of always rejecting once full
+ */
+static bool TestCompactBufferPolicies()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCCompactPolicies";
+    std::filesystem::create_directories(Directory);
+    IPCFileManager::UE_SetUseCompactRequestBuffers(true);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestCompactPolicies");
+
+    // DROP_OLDEST makes room, and the dropped GET's future fails
+    FBufferCapacityConfig Config;
+    Config.Capacity = 4;
+    Config.Policy = EBackpressurePolicy::DROP_OLDEST;
+    IPCFileManager::UE_ConfigureGetRequestBuffer(Config);
+    std::vector<FGetFuture> Futures;
+    for(size_t i = 0; i <= Config.Capacity; ++i)
+    {
+        Futures.push_back(IPCFileManager::UE_GetAsync(FGetRequest(
+            PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), { EAttributeName::IS_ONLINE })));
+    }
+    bool bPassed = Futures.front().GetStatus() == EAsyncGetStatus::FAILED &&
+        Futures.back().GetStatus() == EAsyncGetStatus::PENDING;
+
+    // SPILL_TO_DISK writes the full buffer out and takes the push
+    Config.Policy = EBackpressurePolicy::SPILL_TO_DISK;
+    Config.SpillDirectory = Directory.string() + "/";
+    IPCFileManager::UE_ConfigureSetRequestBuffer(Config);
+    for(size_t i = 0; i <= Config.Capacity; ++i)
+    {
+        bPassed = IPCFileManager::UE_AddSetRequestToBuffer(
+            MakeNameSetRequest(PlayerAuth, std::to_string(i))) && bPassed;
+    }
+    bPassed = bPassed && !std::filesystem::is_empty(Directory);
+
+    // BLOCK waits out its timeout, then rejects
+    Config.Capacity = 1;
+    Config.Policy = EBackpressurePolicy::BLOCK;
+    Config.BlockTimeoutMS = 5;
+    IPCFileManager::UE_ConfigureSetRequestBuffer(Config);
+    bPassed = bPassed && !IPCFileManager::UE_AddSetRequestToBuffer(
+        MakeNameSetRequest(PlayerAuth, "Blocked"));
+
+    IPCFileManager::UE_Shutdown();
+    IPCFileManager::UE_ConfigureGetRequestBuffer(FBufferCapacityConfig());
+    IPCFileManager::UE_ConfigureSetRequestBuffer(FBufferCapacityConfig());
+    IPCFileManager::UE_SetUseCompactRequestBuffers(false);
+    std::filesystem::remove_all(Directory);
+    return bPassed;
+}
+
+/**
+ * A HIGH SET has to be written as soon as it is added, or by its lane's
+ * deadline, while NORMAL SETs wait for the caller to flush them
+ */
+static bool TestHighSetFlushedByItsLane()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCHighSetLane";
+    std::filesystem::create_directories(Directory);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestHighSetLane");
+    const auto CountFiles = [&Directory](const std::string& Type)
+    {
+        size_t NumberOfFiles = 0;
+        std::error_code Error;
+        for(const auto& Entry : std::filesystem::directory_iterator(Directory, Error))
+        {
+            NumberOfFiles += Entry.path().filename().string().find(Type) != std::string::npos;
+        }
+        return NumberOfFiles;
+    };
+    const std::string HighFile = std::string("SET") + '!';
+    const std::string NormalFile = std::string("SET") + '#';
+
+    FPriorityLaneConfig LaneConfig;
+    LaneConfig.FlushDirectory = Directory.string() + "/";
+    IPCFileManager::UE_ConfigurePriorityLanes(LaneConfig);
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "Normal"));
+    FSetRequest HighRequest = MakeNameSetRequest(PlayerAuth, "High");
+    HighRequest.SetPriority(ERequestPriority::HIGH);
+    IPCFileManager::UE_AddSetRequestToBuffer(HighRequest);
+    bool bPassed = CountFiles(HighFile) == 1 && CountFiles(NormalFile) == 0;
+
+    // With a deadline the write thread flushes the lane instead
+    LaneConfig.FlushDeadlineMS = 20;
+    IPCFileManager::UE_ConfigurePriorityLanes(LaneConfig);
+    IPCFileManager::UE_Initialize();
+    IPCFileManager::UE_AddSetRequestToBuffer(HighRequest);
+    bPassed = bPassed && CountFiles(HighFile) == 1;
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(CountFiles(HighFile) == 1 && std::chrono::steady_clock::now() < Deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    bPassed = bPassed && CountFiles(HighFile) == 2 && CountFiles(NormalFile) == 0;
+
+    IPCFileManager::UE_ConfigurePriorityLanes(FPriorityLaneConfig());
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * Queued completions have to wait for the dispatching thread, come out in
+ * the order they finished and stop at the dispatch limit, with SET
+ * acknowledgements delivered the same way
+ */
+static bool TestQueuedCompletionsDispatchInOrder()
+{
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestQueuedCompletions");
+    std::vector<FIPCCompletion> Delivered;
+    bool bSlowHandler = false;
+    IPCFileManager::UE_SetCompletionHandler([&](const FIPCCompletion& Completion)
+    {
+        Delivered.push_back(Completion);
+        if(bSlowHandler)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    });
+
+    FPlayerAttributeList Response;
+    Response.SetPlayerAuthID(PlayerAuth);
+    std::vector<FGetFuture> Futures;
+    for(int i = 0; i < 5; ++i)
+    {
+        Futures.push_back(IPCFileManager::UE_GetAsync(FGetRequest(
+            PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), { EAttributeName::IS_ONLINE }),
+            5000, ECompletionDelivery::QUEUED));
+        IPCFileManager::UE_ResolveGetResponse(Futures.back().GetRequestID(), Response);
+    }
+    bool bPassed = std::none_of(Futures.begin(), Futures.end(),
+        [](const FGetFuture& Future) { return Future.IsReady(); });
+
+    bPassed = bPassed && IPCFileManager::UE_DispatchCompletions(2, 0) == 2 &&
+        Futures[0].IsReady() && Futures[1].IsReady() && !Futures[2].IsReady() &&
+        Delivered.size() == 2 &&
+        Delivered[0].RequestID == Futures[0].GetRequestID() &&
+        Delivered[1].RequestID == Futures[1].GetRequestID();
+
+    // The completion that runs past the time budget is the last one delivered
+    bSlowHandler = true;
+    bPassed = bPassed && IPCFileManager::UE_DispatchCompletions(0, 1000) == 1 &&
+        Futures[2].IsReady() && !Futures[3].IsReady();
+    bSlowHandler = false;
+
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCQueuedCompletions";
+    std::filesystem::create_directories(Directory);
+    IPCFileManager::UE_SetAcknowledgeSetRequests(true);
+    const FSetRequest SetRequest = MakeNameSetRequest(PlayerAuth, "A");
+    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+    bPassed = bPassed && IPCFileManager::UE_DispatchCompletions(0, 0) == 3 &&
+        std::all_of(Futures.begin(), Futures.end(),
+            [](const FGetFuture& Future) { return Future.GetStatus() == EAsyncGetStatus::READY; }) &&
+        Delivered.size() == 6 &&
+        Delivered.back().Type == ECompletionType::SET &&
+        Delivered.back().RequestID == SetRequest.GetRequestID() &&
+        Delivered.back().Status == EAsyncGetStatus::READY;
+
+    IPCFileManager::UE_SetAcknowledgeSetRequests(false);
+    IPCFileManager::UE_SetCompletionHandler(nullptr);
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * The in-memory backend has to merge SETs into what it already holds,
+ * throttle past its rate and refill over time, and the request processor
+ * has to keep retrying throttled rows until every one is stored
+ */
+static bool TestBackendThrottlesAndRetries()
+{
+    FInMemoryBackendConfig BackendConfig;
+    BackendConfig.MaxPlayersPerSecond = 50;
+    IPCFileManager::FInMemoryBackend Backend(BackendConfig);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestBackendThrottle");
+    FPlayerAttributeList Name;
+    Name.SetPlayerAuthID(PlayerAuth);
+    Name.SetPlayerName(IAttributeString(EAttributeName::PLAYER_NAME, "A"));
+    FPlayerAttributeList Online;
+    Online.SetPlayerAuthID(PlayerAuth);
+    Online.SetIsOnline(IAttributeBool(EAttributeName::IS_ONLINE, true));
+    FPlayerAttributeList Stored;
+    bool bPassed = Backend.GetPlayer(PlayerAuth.Value, Stored) == EBackendResult::NOT_FOUND &&
+        Backend.SetPlayer(Name) == EBackendResult::OK &&
+        Backend.SetPlayer(Online) == EBackendResult::OK &&
+        Backend.GetPlayer(PlayerAuth.Value, Stored) == EBackendResult::OK &&
+        Stored.GetPlayerName().Value == "A" && Stored.GetIsOnline().Value;
+
+    // 4 of the burst of 50 players are spent, so a batch of 50 is refused whole
+    std::vector<EBackendResult> Results;
+    Backend.SetPlayers(std::vector<FPlayerAttributeList>(50, Name), Results);
+    bPassed = bPassed && Results.size() == 50 &&
+        std::all_of(Results.begin(), Results.end(),
+            [](const EBackendResult Result) { return Result == EBackendResult::THROTTLED; }) &&
+        Backend.GetNumberThrottled() == 50;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    bPassed = bPassed && Backend.SetPlayer(Name) == EBackendResult::OK;
+
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCBackendThrottle";
+    std::filesystem::create_directories(Directory);
+    const std::shared_ptr<IPCFileManager::FInMemoryBackend> SharedBackend =
+        std::make_shared<IPCFileManager::FInMemoryBackend>(BackendConfig);
+    IPCFileManager::AWS_SetBackend(SharedBackend);
+    FAWSProcessorConfig ProcessorConfig;
+    ProcessorConfig.InboxDirectory = Directory.string() + "/";
+    ProcessorConfig.BatchSize = 25;
+    if(!IPCFileManager::AWS_StartRequestProcessor(ProcessorConfig))
+    {
+        return false;
+    }
+    IPCFileManager::AWS_Initialize();
+    const size_t NumberOfSets = 100;
+    for(size_t i = 0; i < NumberOfSets; ++i)
+    {
+        IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(IAttributeString(
+            EAttributeName::PLAYER_AUTH, "TestBackendThrottle" + std::to_string(i)), "A"));
+    }
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(SharedBackend->GetNumberOfSets() < NumberOfSets && std::chrono::steady_clock::now() < Deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bPassed = bPassed && SharedBackend->GetNumberOfSets() == NumberOfSets &&
+        SharedBackend->GetNumberThrottled() > 0;
+
+    IPCFileManager::AWS_StopRequestProcessor();
+    IPCFileManager::AWS_Shutdown();
+    IPCFileManager::AWS_SetBackend(nullptr);
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * The SET write thread has to flush on whichever of the count, bytes, age
+ * and request deadline triggers is reached, and not before
+ */
+static bool TestFlushTriggers()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCFlushTriggers";
+    std::filesystem::create_directories(Directory);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestFlushTriggers");
+    const auto CountFiles = [&Directory]()
+    {
+        size_t NumberOfFiles = 0;
+        std::error_code Error;
+        for(auto It = std::filesystem::directory_iterator(Directory, Error);
+            It != std::filesystem::directory_iterator(); ++It)
+        {
+            ++NumberOfFiles;
+        }
+        return NumberOfFiles;
+    };
+    const auto WaitForFiles = [&CountFiles](const size_t NumberOfFiles)
+    {
+        const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while(CountFiles() < NumberOfFiles && std::chrono::steady_clock::now() < Deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return CountFiles() == NumberOfFiles;
+    };
+    IPCFileManager::UE_Initialize();
+
+    // Count, with every other trigger off
+    FFlushTriggerConfig Config;
+    Config.FlushDirectory = Directory.string() + "/";
+    Config.MaxCount = 3;
+    Config.MaxAgeMS = 0;
+    IPCFileManager::UE_ConfigureSetRequestFlush(Config);
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "0"));
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "1"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    bool bPassed = CountFiles() == 0;
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "2"));
+    bPassed = bPassed && WaitForFiles(1);
+
+    // Bytes
+    Config.MaxCount = 0;
+    Config.MaxBytes = 1;
+    IPCFileManager::UE_ConfigureSetRequestFlush(Config);
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "3"));
+    bPassed = bPassed && WaitForFiles(2);
+
+    // Age
+    Config.MaxBytes = 0;
+    Config.MaxAgeMS = 20;
+    IPCFileManager::UE_ConfigureSetRequestFlush(Config);
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "4"));
+    bPassed = bPassed && WaitForFiles(3);
+
+    // The request's own deadline, with no trigger on the buffer at all
+    Config.MaxAgeMS = 0;
+    IPCFileManager::UE_ConfigureSetRequestFlush(Config);
+    FSetRequest Request = MakeNameSetRequest(PlayerAuth, "5");
+    Request.SetFlushDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(20));
+    IPCFileManager::UE_AddSetRequestToBuffer(Request);
+    bPassed = bPassed && WaitForFiles(4);
+
+    IPCFileManager::UE_ConfigureSetRequestFlush(FFlushTriggerConfig());
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+#if !defined(_WIN64) && !defined(_WIN32) // the socket transport is linux only
+/**
+ * A batch sent without a credit has to stay buffered until the AWS end
+ * hands one back, and once the AWS end goes away the UE end has to write
+ * files and then reconnect by itself when it is back
+ */
+static bool TestSocketCreditsAndReconnect()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCSocketTransport";
+    std::filesystem::create_directories(Directory);
+    FInMemoryBackendConfig BackendConfig;
+    BackendConfig.LatencyUs = 200000;
+    const std::shared_ptr<IPCFileManager::FInMemoryBackend> Backend =
+        std::make_shared<IPCFileManager::FInMemoryBackend>(BackendConfig);
+    IPCFileManager::AWS_SetBackend(Backend);
+    FSocketTransportConfig TransportConfig;
+    TransportConfig.SocketPath = (Directory / "IPC.sock").string();
+    TransportConfig.Credits = 1;
+    TransportConfig.ReconnectIntervalMS = 20;
+    if(!IPCFileManager::AWS_ListenTransport(TransportConfig) ||
+        !IPCFileManager::UE_ConnectTransport(TransportConfig))
+    {
+        IPCFileManager::AWS_CloseTransport();
+        IPCFileManager::AWS_SetBackend(nullptr);
+        return false;
+    }
+    FPriorityLaneConfig LaneConfig;
+    LaneConfig.FlushDirectory = Directory.string() + "/";
+    IPCFileManager::UE_ConfigurePriorityLanes(LaneConfig);
+
+    const auto AddHighSet = [](const std::string& Name)
+    {
+        FSetRequest Request = MakeNameSetRequest(IAttributeString(
+            EAttributeName::PLAYER_AUTH, "TestSocket" + Name), Name);
+        Request.SetPriority(ERequestPriority::HIGH);
+        IPCFileManager::UE_AddSetRequestToBuffer(Request);
+    };
+    const auto WaitFor = [](const std::function<bool()>& Condition)
+    {
+        const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while(!Condition() && std::chrono::steady_clock::now() < Deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return Condition();
+    };
+    const auto CountFiles = [&Directory]()
+    {
+        size_t NumberOfFiles = 0;
+        std::error_code Error;
+        for(const auto& Entry : std::filesystem::directory_iterator(Directory, Error))
+        {
+            NumberOfFiles += Entry.path().extension() != ".sock";
+        }
+        return NumberOfFiles;
+    };
+    const auto FlushUntilSent = [&](const uint64_t BatchesSent)
+    {
+        return WaitFor([&]()
+        {
+            IPCFileManager::UE_FlushPriorityLanes(Directory.string() + "/");
+            return IPCFileManager::UE_GetTransportStats().BatchesSent == BatchesSent;
+        });
+    };
+
+    // The AWS end grants the credit once it has accepted the connection
+    AddHighSet("A");
+    bool bPassed = FlushUntilSent(1);
+    // While A is with the backend the only credit is taken, so B stays in its lane
+    const uint64_t SendsWithoutCredit = IPCFileManager::UE_GetTransportStats().SendsWithoutCredit;
+    AddHighSet("B");
+    bPassed = bPassed && CountFiles() == 0 &&
+        IPCFileManager::UE_GetTransportStats().BatchesSent == 1 &&
+        IPCFileManager::UE_GetTransportStats().SendsWithoutCredit == SendsWithoutCredit + 1 &&
+        FlushUntilSent(2);
+    bPassed = bPassed && WaitFor([&]() { return Backend->GetNumberOfSets() == 2; });
+
+    // With the AWS end gone batches are written to files
+    IPCFileManager::AWS_CloseTransport();
+    bPassed = bPassed && WaitFor([]()
+    {
+        return IPCFileManager::UE_GetTransportStats().NumberOfPeers == 0;
+    });
+    AddHighSet("C");
+    bPassed = bPassed && CountFiles() == 1;
+
+    // And sent over the socket again once it is back
+    bPassed = bPassed && IPCFileManager::AWS_ListenTransport(TransportConfig) &&
+        WaitFor([]() { return IPCFileManager::UE_GetTransportStats().Reconnects == 1; });
+    AddHighSet("D");
+    bPassed = bPassed && FlushUntilSent(3) &&
+        WaitFor([&]() { return Backend->GetNumberOfSets() == 3; });
+
+    IPCFileManager::UE_DisconnectTransport();
+    IPCFileManager::AWS_CloseTransport();
+    IPCFileManager::AWS_SetBackend(nullptr);
+    IPCFileManager::UE_ConfigurePriorityLanes(FPriorityLaneConfig());
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+#endif
+
+/**
+ * With the backend as the bottleneck, a producer with three times the
+ * weight has to get through its backlog well before an equal backlog from
+ * a producer of weight 1, and both have to be drained in the end
+ */
+static bool TestProducersScheduledByWeight()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCProducerWeights";
+    std::filesystem::create_directories(Directory);
+    const std::string Inbox = Directory.string() + "/";
+    const size_t FilesPerProducer = 24;
+    for(const char* Producer : { "Light", "Heavy" })
+    {
+        const std::string ProducerDirectory = IPCFileManager::GetProducerDirectory(Inbox, Producer);
+        for(size_t i = 0; i < FilesPerProducer; ++i)
+        {
+            IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(IAttributeString(
+                EAttributeName::PLAYER_AUTH, std::string("TestProducerWeights") + Producer), "A"));
+            IPCFileManager::UE_WriteSetRequestBufferToFile(ProducerDirectory);
+            IPCFileManager::UE_Shutdown();
+        }
+    }
+
+    FInMemoryBackendConfig BackendConfig;
+    BackendConfig.LatencyUs = 5000;
+    IPCFileManager::AWS_SetBackend(std::make_shared<IPCFileManager::FInMemoryBackend>(BackendConfig));
+    IPCFileManager::AWS_RegisterProducer("Light", 1);
+    IPCFileManager::AWS_RegisterProducer("Heavy", 3);
+    FAWSProcessorConfig ProcessorConfig;
+    ProcessorConfig.InboxDirectory = Inbox;
+    ProcessorConfig.MaxInFlightBatches = 1;
+    ProcessorConfig.QueueCapacity = 2;
+    ProcessorConfig.FairShareQuantumBytes = 8;
+    if(!IPCFileManager::AWS_StartRequestProcessor(ProcessorConfig))
+    {
+        return false;
+    }
+    IPCFileManager::AWS_Initialize();
+
+    const auto GetFilesIngested = [](const std::string& Name)
+    {
+        std::vector<FProducerStats> Stats;
+        IPCFileManager::AWS_GetProducerStats(Stats);
+        for(const FProducerStats& Producer : Stats)
+        {
+            if(Producer.Name == Name)
+            {
+                return Producer.FilesIngested;
+            }
+        }
+        return uint64_t(0);
+    };
+    uint64_t LightWhenHeavyDone = FilesPerProducer;
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(GetFilesIngested("Light") < FilesPerProducer && std::chrono::steady_clock::now() < Deadline)
+    {
+        const uint64_t Light = GetFilesIngested("Light");
+        if(GetFilesIngested("Heavy") == FilesPerProducer && LightWhenHeavyDone == FilesPerProducer)
+        {
+            LightWhenHeavyDone = Light;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const bool bPassed = GetFilesIngested("Light") == FilesPerProducer &&
+        LightWhenHeavyDone <= FilesPerProducer / 2;
+
+    IPCFileManager::AWS_StopRequestProcessor();
+    IPCFileManager::AWS_Shutdown();
+    IPCFileManager::AWS_SetBackend(nullptr);
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * A scanner has to hand back each request file once, HIGH files first, skip
+ * the types outside its mask, and hand a file back again once it's forgotten
+ */
+static bool TestDirectoryScannerManifest()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCDirectoryScanner";
+    std::filesystem::create_directories(Directory);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestDirectoryScanner");
+    IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, "Normal"));
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+    IPCFileManager::UE_AddGetRequestToBuffer(FGetRequest(PlayerAuth,
+        IPCFileManager::GenerateUniqueRequestID(), { EAttributeName::PLAYER_NAME }));
+    IPCFileManager::UE_WriteGetRequestBufferToFile(Directory.string() + "/");
+    FPriorityLaneConfig LaneConfig;
+    LaneConfig.FlushDirectory = Directory.string() + "/";
+    IPCFileManager::UE_ConfigurePriorityLanes(LaneConfig);
+    FSetRequest HighRequest = MakeNameSetRequest(PlayerAuth, "High");
+    HighRequest.SetPriority(ERequestPriority::HIGH);
+    IPCFileManager::UE_AddSetRequestToBuffer(HighRequest);
+    std::ofstream(Directory / "NotAnIPCFile.txt") << "Skipped";
+
+    IPCFileManager::FDirectoryScanner Scanner;
+    Scanner.SetDirectory(Directory.string(), 1 << static_cast<uint8_t>(ERequestType::SET));
+    std::vector<IPCFileManager::FDirectoryScanner::FScannedFile> Files;
+    bool bPassed = Scanner.Scan(Files) && Files.size() == 2 &&
+        Files[0].RequestType == ERequestType::SET && Files[0].Priority == ERequestPriority::HIGH &&
+        Files[1].RequestType == ERequestType::SET && Files[1].Priority == ERequestPriority::NORMAL &&
+        Scanner.GetNumberOfKnownFiles() == 3;
+
+    // Nothing changed, so there's nothing new
+    std::vector<IPCFileManager::FDirectoryScanner::FScannedFile> Rescanned;
+    bPassed = bPassed && Scanner.Scan(Rescanned) && Rescanned.empty();
+
+    // A forgotten file is new again, by its name alone
+    if(bPassed)
+    {
+        Scanner.Forget(std::filesystem::path(Files[1].Path).filename().string());
+        bPassed = Scanner.Scan(Rescanned) && Rescanned.size() == 1 &&
+            Rescanned[0].Path == Files[1].Path;
+    }
+
+    // A file that's gone drops out of the manifest
+    if(bPassed)
+    {
+        std::filesystem::remove(Files[0].Path);
+        Rescanned.clear();
+        bPassed = Scanner.Scan(Rescanned) && Rescanned.empty() &&
+            Scanner.GetNumberOfKnownFiles() == 2;
+    }
+
+    // Pointing the scanner again starts over with every type
+    Scanner.SetDirectory(Directory.string());
+    Rescanned.clear();
+    bPassed = bPassed && Scanner.Scan(Rescanned) && Rescanned.size() == 2 &&
+        Rescanned[0].RequestType == ERequestType::SET && Rescanned[1].RequestType == ERequestType::GET;
+
+    IPCFileManager::UE_ConfigurePriorityLanes(FPriorityLaneConfig());
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * Buffers spanning several chunks have to write every request in order, and
+ * keep doing so once their chunks have gone back to the free list and been
+ * handed out again
+ */
+static bool TestRecycledChunksKeepOrder()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCRecycledChunks";
+    std::filesystem::create_directories(Directory);
+    const size_t SetsPerChunk = IPCFileManager::GetRequestFootprint().BytesPerSetBufferChunk /
+        IPCFileManager::GetRequestFootprint().BytesPerSetRequest;
+    const size_t NumberOfRequests = SetsPerChunk * 3 + SetsPerChunk / 2;
+
+    bool bPassed = true;
+    for(int Round = 0; Round < 4 && bPassed; ++Round)
+    {
+        const std::string Prefix = "TestRecycledChunks" + std::to_string(Round) + "_";
+        for(size_t i = 0; i < NumberOfRequests; ++i)
+        {
+            IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(
+                IAttributeString(EAttributeName::PLAYER_AUTH, Prefix + std::to_string(i)), "A"));
+        }
+        IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+        // Empties the buffer, so every chunk goes back to the free list
+        IPCFileManager::UE_Shutdown();
+
+        std::vector<FSetRequest> Requests;
+        std::error_code Error;
+        for(const auto& Entry : std::filesystem::directory_iterator(Directory, Error))
+        {
+            bPassed = bPassed && IPCFileManager::ReadSetRequestsFromFile(Entry.path().string(), Requests);
+            std::filesystem::remove(Entry.path(), Error);
+        }
+        bPassed = bPassed && Requests.size() == NumberOfRequests;
+        for(size_t i = 0; i < Requests.size() && bPassed; ++i)
+        {
+            bPassed = Requests[i].GetPlayerAuthIDString() == Prefix + std::to_string(i);
+        }
+    }
+
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * A GET from a HIGH file has to be answered in a HIGH response file, so the
+ * response isn't held up behind the bulk responses
+ */
+static bool TestHighGetAnsweredOnHighLane()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCHighGetLane";
+    const std::filesystem::path Outbox =
+        std::filesystem::temp_directory_path() / "IPCHighGetLaneOut";
+    std::filesystem::create_directories(Directory);
+    std::filesystem::create_directories(Outbox);
+    IPCFileManager::AWS_SetBackend(std::make_shared<IPCFileManager::FInMemoryBackend>());
+    FAWSProcessorConfig ProcessorConfig;
+    ProcessorConfig.InboxDirectory = Directory.string() + "/";
+    ProcessorConfig.OutboxDirectory = Outbox.string() + "/";
+    if(!IPCFileManager::AWS_StartRequestProcessor(ProcessorConfig))
+    {
+        return false;
+    }
+    IPCFileManager::AWS_Initialize();
+    FPriorityLaneConfig LaneConfig;
+    LaneConfig.FlushDirectory = Directory.string() + "/";
+    IPCFileManager::UE_ConfigurePriorityLanes(LaneConfig);
+
+    FGetRequest GetRequest(IAttributeString(EAttributeName::PLAYER_AUTH, "TestHighGetLane"),
+        IPCFileManager::GenerateUniqueRequestID(), { EAttributeName::IS_ONLINE });
+    GetRequest.SetPriority(ERequestPriority::HIGH);
+    IPCFileManager::UE_AddGetRequestToBuffer(GetRequest);
+
+    const std::string HighResponse = std::string("SET") + '!';
+    const std::string NormalResponse = std::string("SET") + '#';
+    bool bHasHighResponse = false;
+    bool bHasNormalResponse = false;
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(!bHasHighResponse && !bHasNormalResponse && std::chrono::steady_clock::now() < Deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::error_code Error;
+        for(const auto& Entry : std::filesystem::directory_iterator(Outbox, Error))
+        {
+            const std::string Name = Entry.path().filename().string();
+            bHasHighResponse |= Name.find(HighResponse) != std::string::npos;
+            bHasNormalResponse |= Name.find(NormalResponse) != std::string::npos;
+        }
+    }
+
+    IPCFileManager::AWS_StopRequestProcessor();
+    IPCFileManager::AWS_Shutdown();
+    IPCFileManager::AWS_SetBackend(nullptr);
+    IPCFileManager::UE_ConfigurePriorityLanes(FPriorityLaneConfig());
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    std::filesystem::remove_all(Outbox, Error);
+    return bHasHighResponse && !bHasNormalResponse;
+}
+
+/**
+ * With a response directory set, the UE read thread has to pick up the
+ * response files on its own and resolve the futures they answer
+ */
+static bool TestReadThreadResolvesResponses()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCReadThread";
+    const std::filesystem::path Outbox =
+        std::filesystem::temp_directory_path() / "IPCReadThreadOut";
+    std::filesystem::create_directories(Directory);
+    std::filesystem::create_directories(Outbox);
+    IPCFileManager::AWS_SetBackend(std::make_shared<IPCFileManager::FInMemoryBackend>());
+    FAWSProcessorConfig ProcessorConfig;
+    ProcessorConfig.InboxDirectory = Directory.string() + "/";
+    ProcessorConfig.OutboxDirectory = Outbox.string() + "/";
+    if(!IPCFileManager::AWS_StartRequestProcessor(ProcessorConfig))
+    {
+        return false;
+    }
+    IPCFileManager::AWS_Initialize();
+    FPriorityLaneConfig LaneConfig;
+    LaneConfig.FlushDirectory = Directory.string() + "/";
+    IPCFileManager::UE_ConfigurePriorityLanes(LaneConfig);
+    IPCFileManager::UE_SetResponseDirectory(Outbox.string() + "/");
+    IPCFileManager::UE_Initialize();
+
+    FGetRequest GetRequest(IAttributeString(EAttributeName::PLAYER_AUTH, "TestReadThread"),
+        IPCFileManager::GenerateUniqueRequestID(), { EAttributeName::IS_ONLINE });
+    GetRequest.SetPriority(ERequestPriority::HIGH);
+    const FGetFuture Future = IPCFileManager::UE_GetAsync(GetRequest);
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(!Future.IsReady() && std::chrono::steady_clock::now() < Deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bool bPassed = Future.GetStatus() == EAsyncGetStatus::READY;
+    // Consumed response files are removed
+    while(bPassed && !std::filesystem::is_empty(Outbox) && std::chrono::steady_clock::now() < Deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bPassed = bPassed && std::filesystem::is_empty(Outbox);
+
+    IPCFileManager::AWS_StopRequestProcessor();
+    IPCFileManager::AWS_Shutdown();
+    IPCFileManager::AWS_SetBackend(nullptr);
+    IPCFileManager::UE_ConfigurePriorityLanes(FPriorityLaneConfig());
+    IPCFileManager::UE_Shutdown();
+    IPCFileManager::UE_SetResponseDirectory("");
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    std::filesystem::remove_all(Outbox, Error);
+    return bPassed;
+}
+
+/**
+ * Coalescing the AWS SETs must not merge two GET responses for one player,
+ * each GET has to get a response carrying its own request ID
+ */
+static bool TestCoalescedResponsesAnswerEveryGet()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCCoalescedGets";
+    const std::filesystem::path Outbox =
+        std::filesystem::temp_directory_path() / "IPCCoalescedGetsOut";
+    std::filesystem::create_directories(Directory);
+    std::filesystem::create_directories(Outbox);
+    IPCFileManager::AWS_SetBackend(std::make_shared<IPCFileManager::FInMemoryBackend>());
+    IPCFileManager::AWS_SetCoalesceSetRequests(true);
+    FAWSProcessorConfig ProcessorConfig;
+    ProcessorConfig.InboxDirectory = Directory.string() + "/";
+    ProcessorConfig.OutboxDirectory = Outbox.string() + "/";
+    if(!IPCFileManager::AWS_StartRequestProcessor(ProcessorConfig))
+    {
+        return false;
+    }
+    IPCFileManager::AWS_Initialize();
+
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestCoalescedGets");
+    const FGetFuture First = IPCFileManager::UE_GetAsync(FGetRequest(
+        PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), { EAttributeName::IS_ONLINE }));
+    const FGetFuture Second = IPCFileManager::UE_GetAsync(FGetRequest(
+        PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), { EAttributeName::PLAYER_NAME }));
+    IPCFileManager::UE_WriteGetRequestBufferToFile(Directory.string() + "/");
+
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(!(First.IsReady() && Second.IsReady()) && std::chrono::steady_clock::now() < Deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::error_code Error;
+        for(const auto& Entry : std::filesystem::directory_iterator(Outbox, Error))
+        {
+            IPCFileManager::UE_ConsumeGetResponseFile(Entry.path().string());
+            std::filesystem::remove(Entry.path(), Error);
+        }
+    }
+    const bool bPassed = First.GetStatus() == EAsyncGetStatus::READY &&
+        Second.GetStatus() == EAsyncGetStatus::READY;
+
+    IPCFileManager::AWS_StopRequestProcessor();
+    IPCFileManager::AWS_Shutdown();
+    IPCFileManager::AWS_SetBackend(nullptr);
+    IPCFileManager::AWS_SetCoalesceSetRequests(false);
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    std::filesystem::remove_all(Outbox, Error);
+    return bPassed;
+}
+
+#if !defined(_WIN64) && !defined(_WIN32) // segment pools are linux only
+/**
+ * A flush directory has to reach the segment pool whether or not it, or the
+ * pool's directory, ends in a separator
+ */
+static bool TestSegmentPoolTrailingSeparator()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCSegmentTrailingSeparator";
+    std::filesystem::create_directories(Directory);
+    FSegmentPoolConfig Config;
+    Config.Directory = Directory.string() + "/";
+    Config.NumberOfSegments = 2;
+    Config.SegmentBytes = 65536;
+    if(!IPCFileManager::UE_OpenSegmentPool(Config))
+    {
+        return false;
+    }
+
+    IPCFileManager::UE_Initialize();
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestSegmentTrailingSeparator");
+    FPlayerAttributeList Attributes;
+    Attributes.SetPlayerAuthID(PlayerAuth);
+    IPCFileManager::UE_AddSetRequestToBuffer(FSetRequest(
+        PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), Attributes));
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string());
+    const bool bPassed = IPCFileManager::UE_GetSegmentPoolStats().BatchesWritten == 1;
+
+    IPCFileManager::UE_CloseSegmentPool();
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * A segment range that can't be finished, because there is no backend yet,
+ * has to be handed out again rather than hold its segment for good
+ */
+static bool TestSegmentRangeRetriedWithoutBackend()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCSegmentNoBackend";
+    const std::filesystem::path Outbox =
+        std::filesystem::temp_directory_path() / "IPCSegmentNoBackendOut";
+    std::filesystem::create_directories(Directory);
+    std::filesystem::create_directories(Outbox);
+    IPCFileManager::AWS_SetBackend(nullptr);
+    FAWSProcessorConfig ProcessorConfig;
+    ProcessorConfig.InboxDirectory = Directory.string() + "/";
+    ProcessorConfig.OutboxDirectory = Outbox.string() + "/";
+    FSegmentPoolConfig PoolConfig;
+    PoolConfig.Directory = Directory.string() + "/";
+    PoolConfig.NumberOfSegments = 2;
+    PoolConfig.SegmentBytes = 65536;
+    if(!IPCFileManager::AWS_StartRequestProcessor(ProcessorConfig) ||
+        !IPCFileManager::UE_OpenSegmentPool(PoolConfig))
+    {
+        IPCFileManager::AWS_StopRequestProcessor();
+        return false;
+    }
+    IPCFileManager::AWS_Initialize();
+
+    const size_t NumberOfSets = 10;
+    for(size_t i = 0; i < NumberOfSets; ++i)
+    {
+        IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(IAttributeString(
+            EAttributeName::PLAYER_AUTH, "TestSegmentNoBackend" + std::to_string(i)), "A"));
+    }
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+    // Let the range be ingested and given back with nowhere to send it
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    const std::shared_ptr<IPCFileManager::FInMemoryBackend> Backend =
+        std::make_shared<IPCFileManager::FInMemoryBackend>();
+    IPCFileManager::AWS_SetBackend(Backend);
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while((Backend->GetNumberOfSets() < NumberOfSets ||
+        IPCFileManager::UE_GetSegmentPoolStats().SegmentsFree != PoolConfig.NumberOfSegments) &&
+        std::chrono::steady_clock::now() < Deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const bool bPassed = Backend->GetNumberOfSets() == NumberOfSets &&
+        IPCFileManager::UE_GetSegmentPoolStats().SegmentsFree == PoolConfig.NumberOfSegments;
+
+    IPCFileManager::AWS_StopRequestProcessor();
+    IPCFileManager::AWS_Shutdown();
+    IPCFileManager::AWS_SetBackend(nullptr);
+    IPCFileManager::UE_CloseSegmentPool();
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    std::filesystem::remove_all(Outbox, Error);
+    return bPassed;
+}
+#endif
+
+/**
+ * Every binary value has to decode to what was encoded, including negative
+ * ints, a float's exact bits and strings holding newlines and zero bytes
+ */
+static bool TestBinaryRecordCodecRoundTrip()
+{
+    using namespace ValueCodecStatics;
+    bool bPassed = ZigZagEncode(0) == 0 && ZigZagEncode(-1) == 1 &&
+        ZigZagEncode(1) == 2 && ZigZagEncode(-2) == 3;
+
+    const int64_t Ints[] = { 0, -1, 63, -64, 64, -65, (std::numeric_limits<int64_t>::max)(),
+        (std::numeric_limits<int64_t>::min)() };
+    const float Floats[] = { 0.0f, -0.0f, 1.5f, -3.25e-7f, (std::numeric_limits<float>::max)() };
+    const std::string String("Line\nBreak\0Zero", 15);
+    FBatchWriter Writer;
+    size_t ExpectedSize = 0;
+    for(const int64_t Int : Ints)
+    {
+        TValueCodec<EAttributeTypes::INT>::Encode(Writer, Int);
+        ExpectedSize += TValueCodec<EAttributeTypes::INT>::Size(Int);
+    }
+    for(const float Float : Floats)
+    {
+        TValueCodec<EAttributeTypes::FLOAT>::Encode(Writer, Float);
+        ExpectedSize += TValueCodec<EAttributeTypes::FLOAT>::Size(Float);
+    }
+    TValueCodec<EAttributeTypes::STRING>::Encode(Writer, String);
+    ExpectedSize += TValueCodec<EAttributeTypes::STRING>::Size(String);
+    bPassed = bPassed && Writer.Size() == ExpectedSize;
+
+    const std::string_view Encoded = Writer.View();
+    const char* In = Encoded.data();
+    const char* End = Encoded.data() + Encoded.size();
+    for(const int64_t Int : Ints)
+    {
+        int64_t Decoded = 0;
+        bPassed = bPassed && TValueCodec<EAttributeTypes::INT>::Decode(In, End, Decoded) &&
+            Decoded == Int;
+    }
+    for(const float Float : Floats)
+    {
+        float Decoded = 0.0f;
+        bPassed = bPassed && TValueCodec<EAttributeTypes::FLOAT>::Decode(In, End, Decoded) &&
+            std::memcmp(&Decoded, &Float, sizeof(Float)) == 0;
+    }
+    std::string DecodedString;
+    bPassed = bPassed && TValueCodec<EAttributeTypes::STRING>::Decode(In, End, DecodedString) &&
+        DecodedString == String && In == End;
+
+    // A whole SET record, through the same parse the files go through
+    Writer.Reset();
+    RecordStatics::FBinarySetRecordEncoder Encoder(Writer);
+    const FRequestID RequestID = IPCFileManager::GenerateUniqueRequestID();
+    Encoder.SetRequestID(RequestID);
+    Encoder.AddString(EAttributeName::PLAYER_AUTH, String);
+    Encoder.AddString(EAttributeName::PLAYER_NAME, "Bob");
+    Encoder.AddBool(EAttributeName::IS_ONLINE, true);
+    Encoder.Write();
+    FPlayerAttributeList Attributes;
+    FRequestID DecodedRequestID = RequestIDStatics::None;
+    bPassed = bPassed &&
+        IPCFileManager::ParseSetRecord(std::string(Writer.View()), Attributes, DecodedRequestID) &&
+        DecodedRequestID == RequestID &&
+        Attributes.GetPlayerAuthID().Value == String &&
+        Attributes.GetPlayerName().Value == "Bob" &&
+        Attributes.GetIsOnline().Value;
+    return bPassed;
+}
+
+/**
+ * Binary records can hold newlines, so chunks have to split between whole
+ * records and every record has to verify rather than be cut at a newline
+ */
+static bool TestBinaryRecordsWithNewlines()
+{
+    const int NumberOfRecords = 32;
+    FBatchWriter Writer;
+    std::vector<size_t> RecordEnds;
+    std::vector<std::string> PlayerAuths;
+    for(int i = 0; i < NumberOfRecords; ++i)
+    {
+        PlayerAuths.push_back("Player\n" + std::to_string(i) + std::string(i, '\n'));
+        RecordStatics::FBinarySetRecordEncoder Encoder(Writer);
+        Encoder.SetRequestID(IPCFileManager::GenerateUniqueRequestID());
+        Encoder.AddString(EAttributeName::PLAYER_AUTH, PlayerAuths.back());
+        Encoder.AddBool(EAttributeName::IS_ONLINE, (i % 2) == 0);
+        Encoder.Write();
+        Writer.EndRecord();
+        RecordEnds.push_back(Writer.Size());
+    }
+    Writer.EndFile();
+
+    // The smallest chunks are one record each, whatever newlines it holds
+    const std::string Text(Writer.View());
+    bool bPassed = true;
+    size_t ChunkStart = 0;
+    for(const size_t RecordEnd : RecordEnds)
+    {
+        const size_t ChunkEnd = RecordStatics::FindChunkEnd(Text, ChunkStart, 1);
+        bPassed = bPassed && ChunkEnd == RecordEnd;
+        ChunkStart = RecordEnd;
+    }
+    bPassed = bPassed && RecordStatics::FindChunkEnd(Text, 0, RecordEnds[4] - 1) == RecordEnds[4];
+
+    const std::filesystem::path File =
+        std::filesystem::temp_directory_path() / "IPCBinaryRecordsWithNewlines.ipcf";
+    const uint64_t QuarantinedBefore = IPCFileManager::GetIntegrityStats().RecordsQuarantined;
+    std::vector<FSetRequest> Requests;
+    bPassed = bPassed && Writer.WriteToFile(File.string()) &&
+        IPCFileManager::ReadSetRequestsFromFile(File.string(), Requests) &&
+        Requests.size() == NumberOfRecords &&
+        IPCFileManager::GetIntegrityStats().RecordsQuarantined == QuarantinedBefore;
+    for(size_t i = 0; i < Requests.size() && bPassed; ++i)
+    {
+        bPassed = Requests[i].GetPlayerAuthIDString() == PlayerAuths[i];
+    }
+
+    std::error_code Error;
+    std::filesystem::remove(File, Error);
+    return bPassed;
+}
+
+/**
+ * A batch spread over several chunks, with a record bigger than a chunk, has
+ * to reach the file whole, and a reset writer has to reuse its chunks
+ */
+static bool TestBatchWriterSpansChunks()
+{
+    const int NumberOfRecords = 4000;
+    const int LargeRecord = NumberOfRecords / 2;
+    FBatchWriter Writer;
+    std::vector<std::string> PlayerAuths;
+    for(int i = 0; i < NumberOfRecords; ++i)
+    {
+        PlayerAuths.push_back((i == LargeRecord) ?
+            (std::string(FBatchWriter::ChunkSize * 2, 'L')) :
+            ("TestBatchWriter" + std::to_string(i)));
+    }
+    const std::filesystem::path File =
+        std::filesystem::temp_directory_path() / "IPCBatchWriterSpansChunks.ipcf";
+    const auto WriteAndReadBack = [&]()
+    {
+        Writer.Reset();
+        for(const std::string& PlayerAuth : PlayerAuths)
+        {
+            RecordStatics::FBinarySetRecordEncoder Encoder(Writer);
+            Encoder.SetRequestID(IPCFileManager::GenerateUniqueRequestID());
+            Encoder.AddString(EAttributeName::PLAYER_AUTH, PlayerAuth);
+            Encoder.Write();
+            Writer.EndRecord();
+        }
+        Writer.EndFile();
+        std::vector<FSetRequest> Requests;
+        std::error_code Error;
+        bool bRead = Writer.Size() > FBatchWriter::ChunkSize * 3 &&
+            Writer.View().size() == Writer.Size() &&
+            Writer.WriteToFile(File.string()) &&
+            std::filesystem::file_size(File, Error) == Writer.Size() &&
+            IPCFileManager::ReadSetRequestsFromFile(File.string(), Requests) &&
+            Requests.size() == PlayerAuths.size();
+        for(size_t i = 0; i < Requests.size() && bRead; ++i)
+        {
+            bRead = Requests[i].GetPlayerAuthIDString() == PlayerAuths[i];
+        }
+        return bRead;
+    };
+    const uint64_t QuarantinedBefore = IPCFileManager::GetIntegrityStats().RecordsQuarantined;
+    bool bPassed = WriteAndReadBack() && WriteAndReadBack() &&
+        IPCFileManager::GetIntegrityStats().RecordsQuarantined == QuarantinedBefore;
+
+    // A batch that fits one chunk is written where the last batch started
+    Writer.Reset();
+    Writer.Append("First");
+    const char* const FirstChunk = Writer.View().data();
+    Writer.Reset();
+    Writer.AppendNumber(12345);
+    bPassed = bPassed && Writer.View() == "12345" && Writer.View().data() == FirstChunk;
+
+    std::error_code Error;
+    std::filesystem::remove(File, Error);
+    return bPassed;
+}
+
+/**
+ * The attribute masks have to agree with the attributes added, keep the order
+ * they were added in and turn away duplicates and unknown names
+ */
+static bool TestAttributeMasks()
+{
+    using EName = EAttributeName;
+    FAttributeNameSet Set;
+    bool bPassed = Set.IsEmpty() && Set.Add(EName::IS_ONLINE) && Set.Add(EName::PLAYER_NAME) &&
+        !Set.Add(EName::IS_ONLINE) &&
+        !Set.Add(static_cast<EName>(FAttributeNameSet::Capacity)) &&
+        Set.Size() == 2 && Set[0] == EName::IS_ONLINE && Set[1] == EName::PLAYER_NAME &&
+        Set.Contains(EName::PLAYER_NAME) && !Set.Contains(EName::PLAYER_AUTH) &&
+        Set.GetMask() == (FAttributeNameSet::Bit(EName::IS_ONLINE) | FAttributeNameSet::Bit(EName::PLAYER_NAME)) &&
+        BitStatics::PopCount(Set.GetMask()) == 2;
+    std::vector<EName> ByName;
+    Set.ForEachByName([&ByName](const EName Name) { ByName.push_back(Name); });
+    bPassed = bPassed && ByName == std::vector<EName>{ EName::PLAYER_NAME, EName::IS_ONLINE } &&
+        BitStatics::PopCount(0) == 0 && BitStatics::PopCount(0xFFFFFFFFu) == 32 &&
+        BitStatics::CountTrailingZeros(8) == 3;
+
+    const IAttributeString PlayerAuth = IAttributeString(EName::PLAYER_AUTH, "TestAttributeMasks");
+    FPlayerAttributeList Attributes;
+    Attributes.SetPlayerAuthID(PlayerAuth);
+    Attributes.SetIsOnline(IAttributeBool(EName::IS_ONLINE, true));
+    bPassed = bPassed && Attributes.HasAttribute(EName::IS_ONLINE) &&
+        !Attributes.HasAttribute(EName::PLAYER_NAME) &&
+        Attributes.GetAttributeMask() ==
+            (FAttributeNameSet::Bit(EName::PLAYER_AUTH) | FAttributeNameSet::Bit(EName::IS_ONLINE));
+
+    // The player auth ID is the key of a GET, never one of its attributes
+    FGetRequest GetRequest(PlayerAuth, IPCFileManager::GenerateUniqueRequestID(), { EName::PLAYER_NAME });
+    bPassed = bPassed && !GetRequest.AddAttributeToGet(EName::PLAYER_AUTH) &&
+        !GetRequest.AddAttributeToGet(EName::PLAYER_NAME) &&
+        GetRequest.AddAttributeToGet(EName::IS_ONLINE) &&
+        GetRequest.HasAttribute(EName::IS_ONLINE) && !GetRequest.HasAttribute(EName::PLAYER_AUTH) &&
+        GetRequest.GetAttributeMask() == Set.GetMask();
+    return bPassed;
+}
+
+/**
+ * The footprint report has to describe the objects that are buffered, and
+ * packed requests must stay well below three cache line aligned attributes
+ */
+static bool TestRequestFootprint()
+{
+    constexpr FRequestFootprint Footprint = IPCFileManager::GetRequestFootprint();
+    std::printf("Footprint GET %zu SET %zu pending GET %zu compact %zu attributes %zu "
+        "GET chunk %zu SET chunk %zu bytes\n",
+        Footprint.BytesPerGetRequest, Footprint.BytesPerSetRequest,
+        Footprint.BytesPerPendingGetRequest, Footprint.BytesPerCompactRequest,
+        Footprint.BytesPerAttributeList, Footprint.BytesPerGetBufferChunk,
+        Footprint.BytesPerSetBufferChunk);
+
+    const size_t CacheLineAlignedAttributes = 3 * 64;
+    return Footprint.BytesPerGetRequest == sizeof(FGetRequest) &&
+        Footprint.BytesPerSetRequest == sizeof(FSetRequest) &&
+        Footprint.BytesPerAttributeList == sizeof(FPlayerAttributeList) &&
+        Footprint.BytesPerGetBufferChunk > 0 &&
+        Footprint.BytesPerGetBufferChunk % Footprint.BytesPerGetRequest == 0 &&
+        Footprint.BytesPerSetBufferChunk > 0 &&
+        Footprint.BytesPerSetBufferChunk % Footprint.BytesPerSetRequest == 0 &&
+        Footprint.BytesPerAttributeList < CacheLineAlignedAttributes &&
+        Footprint.BytesPerSetRequest < CacheLineAlignedAttributes;
+}
+
+/**
+ * A record changed after it was written has to fail its own checksum and be
+ * quarantined, while the records around it are still read
+ */
+static bool TestCorruptRecordIsQuarantined()
+{
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCCorruptRecord";
+    std::filesystem::create_directories(Directory);
+    std::vector<FQuarantinedRecord> Quarantined;
+    IPCFileManager::DrainQuarantinedRecords(Quarantined);
+    Quarantined.clear();
+
+    for(const char* Name : { "TestCorruptRecordA", "TestCorruptRecordB", "TestCorruptRecordC" })
+    {
+        IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(
+            IAttributeString(EAttributeName::PLAYER_AUTH, Name), "A"));
+    }
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+
+    bool bPassed = false;
+    std::error_code Error;
+    for(const auto& Entry : std::filesystem::directory_iterator(Directory, Error))
+    {
+        std::string Text;
+        {
+            std::ifstream In(Entry.path(), std::ios::binary);
+            std::stringstream Buffer;
+            Buffer << In.rdbuf();
+            Text = Buffer.str();
+        }
+        const size_t Found = Text.find("TestCorruptRecordB");
+        if(Found == std::string::npos)
+        {
+            continue;
+        }
+        Text[Found + 17] = 'Z';
+        {
+            std::ofstream Out(Entry.path(), std::ios::binary | std::ios::trunc);
+            Out << Text;
+        }
+
+        const FIntegrityStats Before = IPCFileManager::GetIntegrityStats();
+        std::vector<FSetRequest> Requests;
+        bPassed = !IPCFileManager::ReadSetRequestsFromFile(Entry.path().string(), Requests) &&
+            Requests.size() == 2 &&
+            Requests[0].GetPlayerAuthIDString() == "TestCorruptRecordA" &&
+            Requests[1].GetPlayerAuthIDString() == "TestCorruptRecordC" &&
+            IPCFileManager::GetIntegrityStats().FilesFailed == Before.FilesFailed + 1 &&
+            IPCFileManager::DrainQuarantinedRecords(Quarantined) &&
+            Quarantined.size() == 1 &&
+            Quarantined[0].Reason == EIntegrityError::RECORD_CHECKSUM_MISMATCH &&
+            Quarantined[0].Record.find("TestCorruptRecordZ") != std::string::npos;
+    }
+
+    IPCFileManager::UE_Shutdown();
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * A stream of corrupt records fills the quarantine up to its cap, and the
+ * records past it are dropped and counted rather than kept
+ */
+static bool TestQuarantineIsCapped()
+{
+    std::vector<FQuarantinedRecord> Quarantined;
+    IPCFileManager::DrainQuarantinedRecords(Quarantined);
+    Quarantined.clear();
+
+    const size_t NumberOfRecords = 10000;
+    std::string Text;
+    for(size_t i = 0; i < NumberOfRecords; ++i)
+    {
+        Text += "NotARecord" + std::to_string(i) + "\n";
+    }
+
+    const std::filesystem::path File =
+        std::filesystem::temp_directory_path() / "IPCQuarantineIsCapped.ipcf";
+    {
+        std::ofstream Out(File, std::ios::binary);
+        Out << Text;
+    }
+
+    const FIntegrityStats Before = IPCFileManager::GetIntegrityStats();
+    std::vector<FSetRequest> Records;
+    const bool bVerified = IPCFileManager::ReadSetRequestsFromFile(File.string(), Records);
+    const FIntegrityStats After = IPCFileManager::GetIntegrityStats();
+    IPCFileManager::DrainQuarantinedRecords(Quarantined);
+
+    std::error_code Error;
+    std::filesystem::remove(File, Error);
+
+    const uint64_t Dropped = After.RecordsQuarantineDropped - Before.RecordsQuarantineDropped;
+    return !bVerified && Records.empty() &&
+        After.RecordsQuarantined - Before.RecordsQuarantined == NumberOfRecords &&
+        Dropped > 0 &&
+        Quarantined.size() + Dropped == NumberOfRecords &&
+        Quarantined.back().Record == "NotARecord" + std::to_string(Quarantined.size() - 1);
+}
+
+/**
+ * Request IDs made on several threads at once have to be unique, increase
+ * on each thread and carry the instance ID. File names have to sort back into
+ * the order they were written in, with no gap in their sequence.
+ */
+static bool TestUniqueIDsAreOrdered()
+{
+    const size_t NumberOfThreads = 4;
+    const size_t IDsPerThread = 10000;
+    std::vector<std::vector<FRequestID>> ThreadIDs(NumberOfThreads);
+    std::vector<std::thread> Threads;
+    for(size_t i = 0; i < NumberOfThreads; ++i)
+    {
+        Threads.emplace_back([&IDs = ThreadIDs[i], IDsPerThread]()
+        {
+            for(size_t j = 0; j < IDsPerThread; ++j)
+            {
+                IDs.push_back(IPCFileManager::GenerateUniqueRequestID());
+            }
+        });
+    }
+    for(std::thread& Thread : Threads)
+    {
+        Thread.join();
+    }
+
+    bool bPassed = true;
+    std::unordered_set<FRequestID> Seen;
+    for(const std::vector<FRequestID>& IDs : ThreadIDs)
+    {
+        bPassed = bPassed && std::is_sorted(IDs.begin(), IDs.end());
+        for(const FRequestID ID : IDs)
+        {
+            bPassed = bPassed && ID != RequestIDStatics::None &&
+                (ID >> FUniqueIDGenerator::RequestIDSequenceBits) ==
+                    FUniqueIDGenerator::GetInstanceID() &&
+                Seen.insert(ID).second;
+        }
+    }
+
+    const std::filesystem::path Directory =
+        std::filesystem::temp_directory_path() / "IPCUniqueIDs";
+    std::filesystem::create_directories(Directory);
+    const IAttributeString PlayerAuth = IAttributeString(
+        EAttributeName::PLAYER_AUTH, "TestUniqueIDs");
+    std::vector<std::string> Files;
+    for(int i = 0; i < 3; ++i)
+    {
+        IPCFileManager::UE_AddSetRequestToBuffer(MakeNameSetRequest(PlayerAuth, std::to_string(i)));
+        IPCFileManager::UE_WriteSetRequestBufferToFile(Directory.string() + "/");
+        std::error_code Error;
+        for(const auto& Entry : std::filesystem::directory_iterator(Directory, Error))
+        {
+            if(std::find(Files.begin(), Files.end(), Entry.path().string()) == Files.end())
+            {
+                Files.push_back(Entry.path().string());
+            }
+        }
+    }
+    const std::vector<std::string> Written = Files;
+    std::reverse(Files.begin(), Files.end());
+    Files.push_back(Directory.string() + "/NotAnIPCFile");
+    IPCFileManager::SortFilesByUniqueID(Files);
+    bPassed = bPassed && Files.size() == 4 &&
+        std::equal(Written.begin(), Written.end(), Files.begin()) &&
+        Files.back() == Directory.string() + "/NotAnIPCFile";
+
+    FSequenceGapTracker GapTracker;
+    FUniqueID ID;
+    for(size_t i = 0; i < Written.size() && bPassed; ++i)
+    {
+        ERequestType RequestType;
+        bPassed = IPCFileManager::ParseUniqueFileName(Written[i], RequestType, ID) &&
+            RequestType == ERequestType::SET &&
+            ID.InstanceID == FUniqueIDGenerator::GetInstanceID() &&
+            GapTracker.Observe(RequestType, ID) == 0;
+    }
+    // A file that never arrived shows up as a gap
+    ID.Sequence += 2;
+    bPassed = bPassed && GapTracker.Observe(ERequestType::SET, ID) == 1 &&
+        GapTracker.GetTotalGaps() == 1;
+
+    IPCFileManager::UE_Shutdown();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return bPassed;
+}
+
+/**
+ * Write a GET file and a SET file into Directory, to look at by hand
+ */
+static void WriteSampleFiles(const std::string& Directory)
 {
     const IAttributeString PlayerAuth = IAttributeString(
         EAttributeName::PLAYER_AUTH, "TestPlayerAuthID238476981723");
@@ -20,8 +1635,7 @@ int main(int argc, char* argv[])
     IPCFileManager::UE_Initialize();
 
     IPCFileManager::UE_AddGetRequestToBuffer(GetRequest);
-    IPCFileManager::UE_WriteGetRequestBufferToFile(
-        "C:\\Users\\josh_\\Documents\\IPCtest");
+    IPCFileManager::UE_WriteGetRequestBufferToFile(Directory);
 
     FPlayerAttributeList AttList;
     AttList.SetPlayerAuthID(PlayerAuth);
@@ -31,19 +1645,67 @@ int main(int argc, char* argv[])
         IPCFileManager::GenerateUniqueRequestID(),
         AttList);
 
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
-    IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
+    for(int i = 0; i < 9; ++i)
+    {
+        IPCFileManager::UE_AddSetRequestToBuffer(SetRequest);
+    }
     
-    IPCFileManager::UE_WriteSetRequestBufferToFile(
-        "C:\\Users\\josh_\\Documents\\IPCtest");
-    
-    system("pause");
-    return 0;
+    IPCFileManager::UE_WriteSetRequestBufferToFile(Directory);
+    IPCFileManager::UE_Shutdown();
+}
+
+static int NumberOfFailures = 0;
+
+static void RunTest(const char* Name, bool (*Test)())
+{
+    const bool bPassed = Test();
+    std::printf("%s %s\n", Name, bPassed ? "passed" : "FAILED");
+    if(!bPassed)
+    {
+        ++NumberOfFailures;
+    }
+}
+
+/**
+ * Debug Tests, the exit code is the number of tests that failed. Pass a
+ * directory to also write sample request files into it.
+ */
+int main(int argc, char* argv[])
+{
+    RunTest("PendingGetsDrainOnResponse", TestPendingGetsDrainOnResponse);
+    RunTest("DroppedGetFailsItsFuture", TestDroppedGetFailsItsFuture);
+    RunTest("PendingTakeKeepsOrder", TestPendingTakeKeepsOrder);
+    RunTest("BufferPoliciesAndWatermarks", TestBufferPoliciesAndWatermarks);
+    RunTest("BulkAndEmplaceAdds", TestBulkAndEmplaceAdds);
+    RunTest("BinaryRecordCodecRoundTrip", TestBinaryRecordCodecRoundTrip);
+    RunTest("BinaryRecordsWithNewlines", TestBinaryRecordsWithNewlines);
+    RunTest("BatchWriterSpansChunks", TestBatchWriterSpansChunks);
+    RunTest("AttributeMasks", TestAttributeMasks);
+    RunTest("RequestFootprint", TestRequestFootprint);
+    RunTest("CorruptRecordIsQuarantined", TestCorruptRecordIsQuarantined);
+    RunTest("QuarantineIsCapped", TestQuarantineIsCapped);
+    RunTest("UniqueIDsAreOrdered", TestUniqueIDsAreOrdered);
+    RunTest("DeltaSetUndoesUnwrittenSet", TestDeltaSetUndoesUnwrittenSet);
+    RunTest("CompactBufferPolicies", TestCompactBufferPolicies);
+    RunTest("HighSetFlushedByItsLane", TestHighSetFlushedByItsLane);
+    RunTest("QueuedCompletionsDispatchInOrder", TestQueuedCompletionsDispatchInOrder);
+    RunTest("BackendThrottlesAndRetries", TestBackendThrottlesAndRetries);
+    RunTest("FlushTriggers", TestFlushTriggers);
+    RunTest("ProducersScheduledByWeight", TestProducersScheduledByWeight);
+    RunTest("DirectoryScannerManifest", TestDirectoryScannerManifest);
+    RunTest("RecycledChunksKeepOrder", TestRecycledChunksKeepOrder);
+    RunTest("HighGetAnsweredOnHighLane", TestHighGetAnsweredOnHighLane);
+    RunTest("ReadThreadResolvesResponses", TestReadThreadResolvesResponses);
+    RunTest("CoalescedResponsesAnswerEveryGet", TestCoalescedResponsesAnswerEveryGet);
+#if !defined(_WIN64) && !defined(_WIN32)
+    RunTest("SocketCreditsAndReconnect", TestSocketCreditsAndReconnect);
+    RunTest("SegmentPoolTrailingSeparator", TestSegmentPoolTrailingSeparator);
+    RunTest("SegmentRangeRetriedWithoutBackend", TestSegmentRangeRetriedWithoutBackend);
+#endif
+
+    if(argc > 1)
+    {
+        WriteSampleFiles(argv[1]);
+    }
+    return NumberOfFailures;
 }
@@ -4,33 +4,91 @@
 // C
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 // C++
+#include <array>
+#include <atomic>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
 #include <vector>
 #include <filesystem>
 #include <thread>
+#include <chrono>
+#include <deque>
 #include <functional>
+#include <random>
 #include <immintrin.h>
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	#include <coroutine>
+	#define IPC_HAS_COROUTINES 1
+#else
+	#define IPC_HAS_COROUTINES 0
+#endif
+
+#if !defined(_WIN64) && !defined(_WIN32)
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <sys/socket.h>
+	#include <sys/uio.h>
+	#include <sys/un.h>
+	#define IPC_HAS_UNIX_SOCKETS 1
+	#define IPC_HAS_SEGMENT_FILES 1
+#else
+	#define IPC_HAS_UNIX_SOCKETS 0
+	#define IPC_HAS_SEGMENT_FILES 0
+#endif
+
 #if defined(_WIN64) || defined(_WIN32) // windows
+	#include <intrin.h>
+	#include <process.h>
+	// Only the wait on address API, windows.h would leak its macros into every includer
+	#if !defined(_AMD64_) && !defined(_X86_)
+		#if defined(_M_X64)
+			#define _AMD64_
+		#else
+			#define _X86_
+		#endif
+	#endif
+	#include <windef.h>
+	#include <synchapi.h>
+	#if defined(_MSC_VER) && !defined(IPC_NO_AUTOLINK)
+		#pragma comment(lib, "Synchronization.lib")
+	#endif
 	#if !defined(FORCEINLINE)
 		#define FORCEINLINE __forceinline
 	#endif
 	#define SPIN_LOOP_PAUSE _mm_pause
+	#define IPC_SSE42_TARGET
 #else // linux
 	#if !defined(FORCEINLINE)
 		#define FORCEINLINE inline 
 	#endif
 	#define SPIN_LOOP_PAUSE __builtin_ia32_pause
+	#define IPC_SSE42_TARGET __attribute__((target("sse4.2")))
+	#include <unistd.h>
+	#include <dirent.h>
+	#include <sys/stat.h>
+	#include <sys/syscall.h>
+	#include <linux/futex.h>
 #endif
 
 #define NEWLINE_CHAR					'\n'
 #define DELIM_CHAR						','
-#define WRITE_MODE						"w"
-#define READ_MODE						"r"
+#define WRITE_MODE						"wb"
+#define READ_MODE						"rb"
 #define FILE_EXTENSION					".ipcf"
+#define UNVERIFIED_FILE_EXTENSION		".unverified"
 #define ATTRIBUTE_DELIM_CHAR			':'
 #define TRUE_STRING						"1"
 #define FALSE_STRING					"0"
@@ -41,22 +99,71 @@
 #define GET_RESPONSE_REQUEST_STRING		"GETRESPONSE"
 #define SET_REQUEST_STRING				"SET"
 #define FILE_DELIM_CHAR					'#'
-#define FILE_TIME_DELIM_CHAR			'-'
+#define PRIORITY_FILE_MARKER_CHAR		'!'
 #define FILE_FOOTER_STRING				"EOF"
+#define CHECKSUM_DELIM_CHAR				'|'
+#define CHECKSUM_HEX_LENGTH				8
+#define BINARY_RECORD_MARKER			'\x01'
 #define FILE_DIRECTORY_DELIM			"\\"
 
 #define ATTRIBUTE_CHAR_MAX				1024
 
-#define UE_BUFFER_MAX					65536
-#define AWS_BUFFER_MAX					65536
+#define REQUEST_BUFFER_CHUNK_BYTES		16384
+#define REQUEST_BUFFER_MAX_FREE_CHUNKS	64
 #define PENDING_REQUEST_RESERVE_SIZE	8192
+#define MAX_QUARANTINED_RECORDS			4096
+
+#define UE_BUFFER_CAPACITY				1048576
+#define AWS_BUFFER_CAPACITY				1048576
+#define BUFFER_BLOCK_TIMEOUT_MS			100
+#define ASYNC_GET_TIMEOUT_MS			5000
+#define PLAYER_SHADOW_CAPACITY			262144
+
+#define COMPACT_BATCH_RESERVE_SIZE		4096
+#define COMPACT_ARENA_RESERVE_SIZE		262144
 
 #define UE_BUFFER_TICK_RATE				8
 #define AWS_BUFFER_TICK_RATE			8
 
+#define AWS_PIPELINE_IN_FLIGHT			4
+#define AWS_PIPELINE_BATCH_SIZE			100
+#define AWS_PIPELINE_QUEUE_CAPACITY		64
+#define AWS_PIPELINE_PARSE_WORKERS		1
+#define AWS_PARSE_CHUNK_BYTES			262144
+#define AWS_PRODUCER_QUANTUM_BYTES		65536
+
+#define SOCKET_FRAME_MAGIC				0x49504346u
+#define SOCKET_DEFAULT_CREDITS			8
+#define SOCKET_MAX_FRAME_BYTES			(64u * 1024u * 1024u)
+#define SOCKET_RECONNECT_INTERVAL_MS	100
+
+#define SEGMENT_MAGIC					0x49504353u
+#define SEGMENT_FILE_PREFIX				"SEGMENT"
+#define SEGMENT_FILE_EXTENSION			".ipcs"
+#define SEGMENT_PAYLOAD_OFFSET			64
+#define SEGMENT_DEFAULT_COUNT			8
+#define SEGMENT_DEFAULT_BYTES			(8u * 1024u * 1024u)
+#define SEGMENT_RESCAN_INTERVAL_MS		1000
+#define SEGMENT_COMMIT_BYTES			(64u * 1024u)
+#define SEGMENT_ROTATE_AFTER_MS			1000
+#define SEGMENT_TAIL_POLL_MS			5
+#define SEGMENT_CURSOR_EXTENSION		".cursor"
+
 #define IPC_PLATFORM_CACHE_LINE_SIZE	64
 #define IPC_ALIGN_TO_CACHE_LINE			alignas(IPC_PLATFORM_CACHE_LINE_SIZE)
 
+// Requests and attributes are packed tightly by default, only the structures
+// shared between threads are cache line aligned. Define as 0 to align every
+// request and attribute to a cache line as well.
+#if !defined(IPC_PACK_REQUESTS)
+	#define IPC_PACK_REQUESTS 1
+#endif
+#if IPC_PACK_REQUESTS
+	#define IPC_ALIGN_REQUEST_PAYLOAD
+#else
+	#define IPC_ALIGN_REQUEST_PAYLOAD		IPC_ALIGN_TO_CACHE_LINE
+#endif
+
 #define SPIN_LOOP_SLEEP_TIME_MS			10
 
 namespace IPCFile
@@ -94,6 +201,77 @@ namespace IPCFile
 		SET
 	};
 
+	/**
+	 * \brief Which lane a request travels in. HIGH requests skip the bulk
+	 * buffers and are written, and read on the other side, before NORMAL ones.
+	 */
+	enum class ERequestPriority : uint8_t
+	{
+		NORMAL,
+		HIGH
+	};
+
+	/**
+	 * \brief How records are written. Readers take either, even mixed in one file.
+	 */
+	enum class ERecordEncoding : uint8_t
+	{
+		/** Key:Value, text, the default */
+		TEXT,
+		/** Typed binary values, see @link ValueCodecStatics */
+		BINARY
+	};
+
+	/**
+	 * \brief Why a record or file failed its integrity check.
+	 */
+	enum class EIntegrityError : uint8_t
+	{
+		NONE,
+		RECORD_MALFORMED,
+		RECORD_CHECKSUM_MISMATCH,
+		FILE_FOOTER_MISSING,
+		FILE_CHECKSUM_MISMATCH
+	};
+
+	/**
+	 * \brief Identifies one request from the moment it is made until its
+	 * response is matched. Only turned into text when written to a file.
+	 */
+	using FRequestID = uint64_t;
+
+	namespace RequestIDStatics
+	{
+		/** Enough characters for any FRequestID in base 10 */
+		static constexpr int MaxDigits = 20;
+		/** Never generated, marks a request or record that carries no ID */
+		static constexpr FRequestID None = 0;
+
+		/**
+		 * \brief Append the text form of a request ID.
+		 */
+		static FORCEINLINE void Append(std::string& Out, const FRequestID InRequestID)
+		{
+			char Buffer[MaxDigits];
+			const std::to_chars_result Result =
+				std::to_chars(Buffer, Buffer + MaxDigits, InRequestID);
+			Out.append(Buffer, Result.ptr);
+		}
+
+		/**
+		 * \brief Parse the text form of a request ID.
+		 * \return Fails unless the whole of the input is a number.
+		 */
+		static FORCEINLINE bool Parse(
+			const std::string_view In,
+			FRequestID& OutRequestID) noexcept
+		{
+			const std::from_chars_result Result =
+				std::from_chars(In.data(), In.data() + In.size(), OutRequestID);
+			return Result.ec == std::errc() && Result.ptr == In.data() + In.size();
+		}
+	}
+	
 	/*
 	 * TODO
 	 */
@@ -183,471 +361,1165 @@ namespace IPCFile
 		inline static std::atomic<uint64_t> Incrementor = {0};
 	};
 	
-	/*
-	 * TODO
-	 */
-	struct FAttributeStringPair
+	namespace Crc32CStatics
 	{
-		std::string KeyString;
-		std::string ValueString;
-	};
-	
-	/*
-	 * TODO
+		static constexpr uint32_t Polynomial = 0x82F63B78;
+		
+		using FTable = std::array<std::array<uint32_t, 256>, 8>;
+
+		/**
+		 * \brief Build the slice-by-8 lookup tables for the software CRC32C path.
+		 */
+		static constexpr FTable BuildTable() noexcept
+		{
+			FTable Table{};
+			for(uint32_t i = 0; i < 256; ++i)
+			{
+				uint32_t Crc = i;
+				for(int j = 0; j < 8; ++j)
+				{
+					Crc = (Crc & 1) ? ((Crc >> 1) ^ Polynomial) : (Crc >> 1);
+				}
+				Table[0][i] = Crc;
+			}
+			for(uint32_t i = 0; i < 256; ++i)
+			{
+				for(int j = 1; j < 8; ++j)
+				{
+					Table[j][i] = (Table[j - 1][i] >> 8) ^
+						Table[0][Table[j - 1][i] & 0xFF];
+				}
+			}
+			return Table;
+		}
+
+		static constexpr FTable Table = BuildTable();
+	}
+
+	/**
+	 * \brief CRC32C (Castagnoli) checksum used to verify records and files.
+	 * Uses the SSE4.2 crc32 instruction when the CPU supports it, otherwise
+	 * falls back to a slice-by-8 table implementation.
 	 */
-	template<typename T, EAttributeTypes TAttributeType>
-	class IPC_ALIGN_TO_CACHE_LINE IAttribute
+	struct FCrc32C
 	{
-		// TODO: add static_asserts on constructibility of template T
-		
-	public:
-		static constexpr EAttributeTypes Type = TAttributeType;
-		EAttributeName Name;
-		T Value;
-	
-		IAttribute()
-			: Name(EAttributeName::NONE),
-			Value(T())
+		/**
+		 * \brief Compute the CRC32C of a block of memory.
+		 * \param Data Pointer to the first byte.
+		 * \param Length Number of bytes to checksum.
+		 * \param PreviousCrc The result of a previous call, to continue a running checksum.
+		 * \return The checksum of the data.
+		 */
+		static FORCEINLINE uint32_t Compute(
+			const void* Data,
+			const size_t Length,
+			const uint32_t PreviousCrc = 0) noexcept
 		{
+			const uint8_t* Bytes = static_cast<const uint8_t*>(Data);
+			return ~(bHasHardwareSupport ?
+				(ComputeHardware(Bytes, Length, ~PreviousCrc)) :
+				(ComputeSoftware(Bytes, Length, ~PreviousCrc)));
 		}
-		
-		IAttribute(const EAttributeName& InName,
-			const T& InValue)
-			: Name(InName),
-			Value(InValue)
+
+		/**
+		 * \brief Compute the CRC32C of a string.
+		 */
+		static FORCEINLINE uint32_t Compute(
+			const std::string& InString,
+			const uint32_t PreviousCrc = 0) noexcept
 		{
+			return Compute(InString.data(), InString.size(), PreviousCrc);
 		}
 
-		FORCEINLINE EAttributeName& GetName() 
+		/**
+		 * \return Whether or not the hardware crc32 instruction is being used.
+		 */
+		static FORCEINLINE bool IsHardwareAccelerated() noexcept
 		{
-			return Name;
+			return bHasHardwareSupport;
 		}
 
-		FORCEINLINE T& GetValue()
+	private:
+		static bool DetectHardwareSupport() noexcept
 		{
-			return Value;
+#if defined(_WIN64) || defined(_WIN32)
+			int CpuInfo[4];
+			__cpuid(CpuInfo, 1);
+			return (CpuInfo[2] & (1 << 20)) != 0;
+#else
+			return __builtin_cpu_supports("sse4.2");
+#endif
 		}
 
-		FORCEINLINE void SetName(const EAttributeName& InName)
+		static IPC_SSE42_TARGET uint32_t ComputeHardware(
+			const uint8_t* Bytes,
+			size_t Length,
+			uint32_t Crc) noexcept
 		{
-			Name = InName;
+			uint64_t Crc64 = Crc;
+			while(Length >= sizeof(uint64_t))
+			{
+				uint64_t Word;
+				memcpy(&Word, Bytes, sizeof(uint64_t));
+				Crc64 = _mm_crc32_u64(Crc64, Word);
+				Bytes += sizeof(uint64_t);
+				Length -= sizeof(uint64_t);
+			}
+			Crc = static_cast<uint32_t>(Crc64);
+			while(Length > 0)
+			{
+				Crc = _mm_crc32_u8(Crc, *Bytes);
+				++Bytes;
+				--Length;
+			}
+			return Crc;
 		}
 
-		FORCEINLINE void SetValue(const T& InValue)
+		static uint32_t ComputeSoftware(
+			const uint8_t* Bytes,
+			size_t Length,
+			uint32_t Crc) noexcept
 		{
-			Value = InValue;
+			while(Length >= sizeof(uint64_t))
+			{
+				uint32_t Low;
+				uint32_t High;
+				memcpy(&Low, Bytes, sizeof(uint32_t));
+				memcpy(&High, Bytes + sizeof(uint32_t), sizeof(uint32_t));
+				Low ^= Crc;
+				Crc = Table[7][Low & 0xFF] ^
+					Table[6][(Low >> 8) & 0xFF] ^
+					Table[5][(Low >> 16) & 0xFF] ^
+					Table[4][Low >> 24] ^
+					Table[3][High & 0xFF] ^
+					Table[2][(High >> 8) & 0xFF] ^
+					Table[1][(High >> 16) & 0xFF] ^
+					Table[0][High >> 24];
+				Bytes += sizeof(uint64_t);
+				Length -= sizeof(uint64_t);
+			}
+			while(Length > 0)
+			{
+				Crc = (Crc >> 8) ^ Table[0][(Crc ^ *Bytes) & 0xFF];
+				++Bytes;
+				--Length;
+			}
+			return Crc;
 		}
+
+		static constexpr const Crc32CStatics::FTable& Table =
+			Crc32CStatics::Table;
+		inline static const bool bHasHardwareSupport = DetectHardwareSupport();
 	};
 
-	class IAttributeString : public IAttribute<std::string, EAttributeTypes::STRING>
+	namespace BitStatics
 	{
-	public:
-		IAttributeString()
-			: IAttribute<std::string, EAttributeTypes::STRING>()
+		/**
+		 * \brief Index of the lowest set bit, Value must not be 0.
+		 */
+		static FORCEINLINE uint32_t CountTrailingZeros(const uint32_t Value) noexcept
 		{
+#if defined(_WIN64) || defined(_WIN32)
+			unsigned long Index;
+			_BitScanForward(&Index, Value);
+			return static_cast<uint32_t>(Index);
+#else
+			return static_cast<uint32_t>(__builtin_ctz(Value));
+#endif
 		}
-		
-		IAttributeString(const EAttributeName& InName, const std::string& InValue)
-			: IAttribute<std::string, EAttributeTypes::STRING>(InName, InValue)
+
+		/** \brief Number of set bits, so the number of attributes in a mask. */
+		static FORCEINLINE uint32_t PopCount(const uint32_t Value) noexcept
 		{
+#if defined(_WIN64) || defined(_WIN32)
+			return static_cast<uint32_t>(__popcnt(Value));
+#else
+			return static_cast<uint32_t>(__builtin_popcount(Value));
+#endif
 		}
-	};
-
-	// typedef IAttribute<std::string> IAttributeString;
-	typedef IAttribute<int, EAttributeTypes::INT>			IAttributeInt;
-	typedef IAttribute<float, EAttributeTypes::FLOAT>		IAttributeFloat;
-	typedef IAttribute<bool, EAttributeTypes::BOOL>			IAttributeBool;
+	}
 	
-	namespace TableDataStatics
+	namespace HexStatics
 	{
-		namespace Internal
+		static constexpr char Digits[] = "0123456789ABCDEF";
+
+		/**
+		 * \brief Write the lowest NumDigits nibbles of a value as upper case hex,
+		 * most significant first, so fixed width values sort lexically.
+		 */
+		static FORCEINLINE void Write(
+			char* Out,
+			const uint64_t Value,
+			const int NumDigits) noexcept
 		{
-			/*
-			 * TODO
-			 */
-			template<typename T, EAttributeTypes TAttributeType>
-			class IPC_ALIGN_TO_CACHE_LINE IColumnAttribute final
-				: public IAttribute<T, TAttributeType>
+			for(int i = 0; i < NumDigits; ++i)
 			{
-			public:
-				T Key = IAttribute<T, TAttributeType>::Value;
-				
-				IColumnAttribute()
-					: IAttribute<T, TAttributeType>()
+				Out[i] = Digits[(Value >> ((NumDigits - 1 - i) * 4)) & 0xF];
+			}
+		}
+
+		/**
+		 * \brief Parse NumDigits upper case hex characters.
+		 * \return Fails if any of the characters are not hex digits.
+		 */
+		static FORCEINLINE bool Parse(
+			const char* In,
+			const int NumDigits,
+			uint64_t& OutValue) noexcept
+		{
+			OutValue = 0;
+			for(int i = 0; i < NumDigits; ++i)
+			{
+				const char Char = In[i];
+				uint64_t Nibble;
+				if(Char >= '0' && Char <= '9')
 				{
+					Nibble = Char - '0';
 				}
-
-				IColumnAttribute(const EAttributeName& InName,
-									const T& InKey)
-					: IAttribute<T, TAttributeType>(InName, InKey)
+				else if(Char >= 'A' && Char <= 'F')
 				{
+					Nibble = Char - 'A' + 10;
 				}
-			};
-
-			typedef IColumnAttribute<std::string, EAttributeTypes::STRING> IColumnAttributeString;
+				else
+				{
+					return false;
+				}
+				OutValue = (OutValue << 4) | Nibble;
+			}
+			return true;
 		}
-		
-		static constexpr int NumberOfAttributes = 3;
-		
-		static const Internal::IColumnAttributeString TableKey_PlayerAuthID =
-			Internal::IColumnAttributeString(
-				EAttributeName::PLAYER_AUTH,
-				std::string("PlayerAuthID"));
-		
-		static const Internal::IColumnAttributeString TableKey_PlayerName =
-			Internal::IColumnAttributeString(
-				EAttributeName::PLAYER_NAME,
-				std::string("PlayerName"));
-		
-		static const Internal::IColumnAttributeString TableKey_IsOnline =
-			Internal::IColumnAttributeString(
-				EAttributeName::IS_ONLINE,
-				std::string("IsOnline"));
 	}
-	
-	/*
-	 * TODO
+
+	/**
+	 * \brief An ID that is unique across every process on the host, and that
+	 * sorts in creation order both as a value and as its string form.
+	 *
+	 * String form: TTTTTTTTTTTTTTTT#IIIIIIII#SSSSSSSS (monotonic time in ns,
+	 * instance ID, sequence number), all fixed width upper case hex.
 	 */
-	class IPC_ALIGN_TO_CACHE_LINE FPlayerAttributeList final
+	struct FUniqueID
 	{
-	public:
-		static constexpr int TotalNumberOfAttributes =
-			TableDataStatics::NumberOfAttributes;
+		static constexpr int TimeDigits = 16;
+		static constexpr int InstanceDigits = 8;
+		static constexpr int SequenceDigits = 8;
+		static constexpr int StringLength =
+			TimeDigits + 1 + InstanceDigits + 1 + SequenceDigits;
 		
-		FPlayerAttributeList()
-			: AttributesInUse{},
-			PlayerAuthID(),
-			PlayerName(),
-			IsOnline()
+		uint64_t TimeNs = 0;
+		uint32_t InstanceID = 0;
+		uint32_t Sequence = 0;
+
+		FORCEINLINE bool operator<(const FUniqueID& Other) const noexcept
 		{
+			if(TimeNs != Other.TimeNs)
+			{
+				return TimeNs < Other.TimeNs;
+			}
+			if(InstanceID != Other.InstanceID)
+			{
+				return InstanceID < Other.InstanceID;
+			}
+			return Sequence < Other.Sequence;
 		}
 
-		/*
-		 * TODO
-		 */
-		EAttributeName& operator[](const int Index)
+		FORCEINLINE bool operator==(const FUniqueID& Other) const noexcept
 		{
-			return AttributesInUse[Index];
+			return TimeNs == Other.TimeNs &&
+				InstanceID == Other.InstanceID &&
+				Sequence == Other.Sequence;
 		}
-		
-		/*
-		 * TODO
+
+		/**
+		 * \brief Append the fixed width string form of this ID.
 		 */
-		EAttributeName operator[](const int Index) const
+		FORCEINLINE void AppendTo(std::string& Out) const
 		{
-			return AttributesInUse[Index];
+			char Buffer[StringLength];
+			HexStatics::Write(Buffer, TimeNs, TimeDigits);
+			Buffer[TimeDigits] = FILE_DELIM_CHAR;
+			HexStatics::Write(Buffer + TimeDigits + 1, InstanceID, InstanceDigits);
+			Buffer[TimeDigits + 1 + InstanceDigits] = FILE_DELIM_CHAR;
+			HexStatics::Write(Buffer + StringLength - SequenceDigits,
+				Sequence, SequenceDigits);
+			Out.append(Buffer, StringLength);
 		}
-		
-		/*
-		 * TODO
+
+		/**
+		 * \brief Parse the string form written by @link AppendTo.
+		 * \param In Points at the first character of the ID.
+		 * \param InLength Number of characters available from In.
 		 */
-		FORCEINLINE void SetPlayerAuthID(const IAttributeString& InPlayerAuthID)
+		static FORCEINLINE bool FromString(
+			const char* In,
+			const size_t InLength,
+			FUniqueID& OutID) noexcept
 		{
-			if(!CheckIfAttributeIsAlreadySet(InPlayerAuthID.Name))
+			uint64_t Instance;
+			uint64_t Sequence;
+			if(InLength < StringLength ||
+				In[TimeDigits] != FILE_DELIM_CHAR ||
+				In[TimeDigits + 1 + InstanceDigits] != FILE_DELIM_CHAR ||
+				!HexStatics::Parse(In, TimeDigits, OutID.TimeNs) ||
+				!HexStatics::Parse(In + TimeDigits + 1, InstanceDigits, Instance) ||
+				!HexStatics::Parse(In + StringLength - SequenceDigits,
+					SequenceDigits, Sequence))
 			{
-				AttributesInUse.push_back(InPlayerAuthID.Name);
+				return false;
 			}
-			PlayerAuthID = InPlayerAuthID;
+			OutID.InstanceID = static_cast<uint32_t>(Instance);
+			OutID.Sequence = static_cast<uint32_t>(Sequence);
+			return true;
 		}
+	};
 
-		/*
-		 * TODO
+	/**
+	 * \brief Generates @link FUniqueID file IDs and 64 bit request IDs.
+	 *
+	 * The time component comes from the monotonic clock (CLOCK_MONOTONIC on
+	 * linux, QueryPerformanceCounter on windows), which is shared by every
+	 * process on the host, and is forced to strictly increase within a process.
+	 * Each @link ERequestType has its own sequence so that a reader can spot a
+	 * missing file from a producer.
+	 *
+	 * The instance ID is InstanceIDBits (24) wide, so that it fits above the
+	 * sequence in a request ID. It defaults to the low 24 bits of the process
+	 * ID. Processes in separate containers can share a PID, and PIDs past
+	 * 2^24 can share their low bits, so such processes should call
+	 * @link SetInstanceID with a value that is unique on the host before
+	 * generating any IDs.
+	 */
+	struct FUniqueIDGenerator
+	{
+		static constexpr int RequestIDSequenceBits = 40;
+		static constexpr uint64_t RequestIDSequenceMask =
+			(uint64_t(1) << RequestIDSequenceBits) - 1;
+		static constexpr int InstanceIDBits = 64 - RequestIDSequenceBits;
+		static constexpr uint32_t InstanceIDMask = (uint32_t(1) << InstanceIDBits) - 1;
+		
+		/**
+		 * \brief Override the instance ID used in every generated ID.
+		 * \return Fails, leaving the instance ID as it was, if InInstanceID is
+		 * wider than InstanceIDBits.
 		 */
-		FORCEINLINE void SetPlayerName(const IAttributeString& InPlayerName)
+		static FORCEINLINE bool SetInstanceID(const uint32_t InInstanceID) noexcept
 		{
-			if(!CheckIfAttributeIsAlreadySet(InPlayerName.Name))
+			if(InInstanceID > InstanceIDMask)
 			{
-				AttributesInUse.push_back(InPlayerName.Name);
+				return false;
 			}
-			PlayerName = InPlayerName;
+			InstanceID.store(InInstanceID, std::memory_order_release);
+			return true;
 		}
 
-		/*
-		 * TODO
+		/**
+		 * \brief The instance ID in every generated ID, at most InstanceIDBits wide.
 		 */
-		FORCEINLINE void SetIsOnline(const IAttributeBool& InIsOnline)
+		static FORCEINLINE uint32_t GetInstanceID() noexcept
 		{
-			if(!CheckIfAttributeIsAlreadySet(InIsOnline.Name))
-			{
-				AttributesInUse.push_back(InIsOnline.Name);
-			}
-			IsOnline = InIsOnline;
+			return InstanceID.load(std::memory_order_acquire);
 		}
 
-		/*
-		 * TODO
+		/**
+		 * \brief Nanoseconds on the host wide monotonic clock.
 		 */
-		FORCEINLINE IAttributeString GetPlayerAuthID() const noexcept
+		static FORCEINLINE uint64_t GetMonotonicTimeNs() noexcept
 		{
-			return PlayerAuthID;
+			return static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count());
 		}
 
-		/*
-		 * TODO
+		/**
+		 * \brief Generate the ID for a new file.
+		 * \param RequestType The type of request the file holds, each has its own sequence.
 		 */
-		FORCEINLINE IAttributeString GetPlayerName() const noexcept
+		static FORCEINLINE FUniqueID GenerateFileID(
+			const ERequestType RequestType) noexcept
 		{
-			return PlayerName;
+			FUniqueID ID;
+			ID.Sequence = FileSequences[static_cast<uint8_t>(RequestType)].fetch_add(
+				1, std::memory_order_relaxed);
+			ID.InstanceID = GetInstanceID();
+			ID.TimeNs = NextTimeNs();
+			return ID;
 		}
 
-		/*
-		 * TODO
+		/**
+		 * \brief Generate a 64 bit request ID, the top 24 bits are the instance
+		 * ID and the bottom 40 bits are a per process sequence number.
 		 */
-		FORCEINLINE IAttributeBool GetIsOnline() const noexcept
+		static FORCEINLINE uint64_t GenerateRequestID() noexcept
 		{
-			return IsOnline;
+			const uint64_t Sequence = RequestSequence.fetch_add(
+				1, std::memory_order_relaxed);
+			return (static_cast<uint64_t>(GetInstanceID() & InstanceIDMask) << RequestIDSequenceBits) |
+				(Sequence & RequestIDSequenceMask);
 		}
 
-		/*
-		 * TODO
+	private:
+		/**
+		 * \brief Read the monotonic clock, bumping the value if another ID in
+		 * this process already used it.
 		 */
-		FORCEINLINE bool IsEmpty() const noexcept
+		static FORCEINLINE uint64_t NextTimeNs() noexcept
 		{
-			return AttributesInUse.size() == 0;
+			const uint64_t Now = GetMonotonicTimeNs();
+			uint64_t Last = LastTimeNs.load(std::memory_order_relaxed);
+			uint64_t Next;
+			do
+			{
+				Next = (Now > Last) ? (Now) : (Last + 1);
+			}
+			while(!LastTimeNs.compare_exchange_weak(
+				Last, Next, std::memory_order_relaxed));
+			return Next;
 		}
 
-		/*
-		 * TODO
-		 */
-		FORCEINLINE size_t Size() const noexcept
+		static FORCEINLINE uint32_t GetProcessID() noexcept
 		{
-			return AttributesInUse.size();
+#if defined(_WIN64) || defined(_WIN32)
+			return static_cast<uint32_t>(_getpid());
+#else
+			return static_cast<uint32_t>(getpid());
+#endif
 		}
-		
-	private:
-		/*
-		 * TODO
+
+		inline static std::atomic<uint32_t> InstanceID = {GetProcessID() & InstanceIDMask};
+		inline static std::atomic<uint64_t> LastTimeNs = {0};
+		/** Starts at 1 so that no generated ID is @link RequestIDStatics::None */
+		inline static std::atomic<uint64_t> RequestSequence = {1};
+		inline static std::atomic<uint32_t> FileSequences[3] = {{0}, {0}, {0}};
+	};
+
+	/**
+	 * \brief Tracks the file sequence numbers seen from each producer so that a
+	 * reader can tell when a file has gone missing, using only file names.
+	 */
+	class FSequenceGapTracker
+	{
+	public:
+		/**
+		 * \brief Record that a file has been consumed.
+		 * \param RequestType The type of request the file held.
+		 * \param ID The ID parsed from the file name.
+		 * \return How many sequence numbers were skipped since the previous
+		 * file from the same producer, 0 when there was no gap.
 		 */
-		FORCEINLINE bool CheckIfAttributeIsAlreadySet(
-			const EAttributeName& InAttributeName) const noexcept
+		FORCEINLINE uint64_t Observe(
+			const ERequestType RequestType,
+			const FUniqueID& ID)
 		{
-			if(AttributesInUse.empty())
+			const uint64_t Key = (static_cast<uint64_t>(ID.InstanceID) << 8) |
+				static_cast<uint8_t>(RequestType);
+			uint64_t Gap = 0;
+			const auto Found = NextExpectedSequence.find(Key);
+			if(Found != NextExpectedSequence.end() && ID.Sequence > Found->second)
 			{
-				return false;
+				Gap = ID.Sequence - Found->second;
 			}
-			
-			for(int i = 0; i < AttributesInUse.size(); ++i)
+			if(Found == NextExpectedSequence.end() || ID.Sequence >= Found->second)
 			{
-				if(AttributesInUse[i] == InAttributeName)
-				{
-					return true;
-				}
+				NextExpectedSequence[Key] = ID.Sequence + uint64_t(1);
 			}
-			
-			return false;
+			TotalGaps += Gap;
+			return Gap;
+		}
+
+		/** \brief How many sequence numbers have been missed, over every source. */
+		FORCEINLINE uint64_t GetTotalGaps() const noexcept
+		{
+			return TotalGaps;
 		}
 
 	private:
-		std::vector<EAttributeName> AttributesInUse;
-		
-		IAttributeString	PlayerAuthID;
-		IAttributeString	PlayerName;
-		IAttributeBool		IsOnline;
+		std::unordered_map<uint64_t, uint64_t> NextExpectedSequence;
+		uint64_t TotalGaps = 0;
+	};
+	
+	/*
+	 * TODO
+	 */
+	struct FAttributeStringPair
+	{
+		std::string KeyString;
+		std::string ValueString;
+	};
+
+	/**
+	 * \brief A record that failed its integrity check, kept for inspection
+	 * instead of being applied.
+	 */
+	struct FQuarantinedRecord
+	{
+		std::string FileLocation;
+		std::string Record;
+		EIntegrityError Reason;
+	};
+
+	/**
+	 * \brief Snapshot of the integrity counters kept by @link IPCFileManager.
+	 */
+	struct FIntegrityStats
+	{
+		uint64_t RecordsVerified = 0;
+		uint64_t RecordsQuarantined = 0;
+		/** Quarantined records that were dropped because the quarantine was full */
+		uint64_t RecordsQuarantineDropped = 0;
+		uint64_t FilesVerified = 0;
+		uint64_t FilesFailed = 0;
+	};
+
+	/**
+	 * \brief What a request buffer does with a push once it is at capacity.
+	 */
+	enum class EBackpressurePolicy : uint8_t
+	{
+		/** Wait up to BlockTimeoutMS for room, then fail the push */
+		BLOCK,
+		/** Fail the push straight away */
+		REJECT,
+		/** Throw away the oldest requests to make room */
+		DROP_OLDEST,
+		/** Write the whole buffer to SpillDirectory, then empty it */
+		SPILL_TO_DISK
+	};
+
+	/**
+	 * \brief Which way a request buffer crossed a watermark.
+	 */
+	enum class EWatermarkEvent : uint8_t
+	{
+		/** The size rose to the high watermark */
+		HIGH,
+		/** The size fell back to the low watermark */
+		LOW
+	};
+
+	/**
+	 * \brief Capacity limit and backpressure settings for a request buffer.
+	 */
+	struct FBufferCapacityConfig
+	{
+		/** The most elements the buffer will ever hold */
+		size_t Capacity = UE_BUFFER_CAPACITY;
+		EBackpressurePolicy Policy = EBackpressurePolicy::REJECT;
+		/** How long a push waits for room with @link EBackpressurePolicy::BLOCK */
+		uint32_t BlockTimeoutMS = BUFFER_BLOCK_TIMEOUT_MS;
+		/** Where @link EBackpressurePolicy::SPILL_TO_DISK writes the buffer */
+		std::string SpillDirectory;
+		/** Size that fires @link EWatermarkEvent::HIGH, 0 disables the callback */
+		size_t HighWatermark = 0;
+		/** Size that fires @link EWatermarkEvent::LOW after a HIGH */
+		size_t LowWatermark = 0;
+		/**
+		 * Called on the pushing (or clearing) thread when a watermark is
+		 * crossed, without the buffer lock held. Use it to shed load.
+		 */
+		std::function<void(EWatermarkEvent, size_t)> WatermarkCallback;
 	};
 
+	/**
+	 * \brief Flush settings for the @link ERequestPriority::HIGH lanes.
+	 */
+	struct FPriorityLaneConfig
+	{
+		/** Where the lanes flush themselves to, empty leaves flushing to the caller */
+		std::string FlushDirectory;
+		/**
+		 * The longest a request waits in a lane before it is flushed, checked
+		 * every write thread tick. 0 flushes on the adding thread as soon as
+		 * the request is in the lane.
+		 */
+		uint32_t FlushDeadlineMS = 0;
+	};
+	
+	/**
+	 * \brief When a buffer's write thread flushes it. Whichever limit is reached
+	 * first wins, a request's own flush deadline is always honoured too.
+	 */
+	struct FFlushTriggerConfig
+	{
+		/** Where the buffer is flushed to, empty leaves flushing to the caller */
+		std::string FlushDirectory;
+		/** Flush once the buffer holds this many requests, 0 turns the limit off */
+		size_t MaxCount = 0;
+		/** Flush once roughly this many bytes would be written, 0 turns the limit off */
+		size_t MaxBytes = 0;
+		/** Flush once the oldest request has waited this long, 0 turns the limit off */
+		uint32_t MaxAgeMS = 1000 / UE_BUFFER_TICK_RATE;
+	};
+	
 	/*
 	 * TODO
 	 */
-	class IPC_ALIGN_TO_CACHE_LINE FIPCRequest
+	template<typename T, EAttributeTypes TAttributeType>
+	class IPC_ALIGN_REQUEST_PAYLOAD IAttribute
 	{
+		// TODO: add static_asserts on constructibility of template T
+		
 	public:
-		static constexpr int TotalNumberOfAttributes =
-			TableDataStatics::NumberOfAttributes;
+		static constexpr EAttributeTypes Type = TAttributeType;
+		EAttributeName Name;
+		T Value;
+	
+		IAttribute()
+			: Name(EAttributeName::NONE),
+			Value(T())
+		{
+		}
+		
+		IAttribute(const EAttributeName& InName,
+			const T& InValue)
+			: Name(InName),
+			Value(InValue)
+		{
+		}
 
-		FIPCRequest() = default;
-		FIPCRequest(const IAttributeString& InPlayerAuthID,
-			const std::string& InRequestID)
-			: PlayerAuthID(InPlayerAuthID),
-			RequestID(InRequestID)
+		FORCEINLINE EAttributeName& GetName() 
 		{
+			return Name;
 		}
 
-		virtual ~FIPCRequest() = default;
-		
-		/*
-		 * TODO
-		 */
-		virtual FORCEINLINE IAttributeString GetPlayerAuthID() const noexcept
+		FORCEINLINE T& GetValue()
 		{
-			return PlayerAuthID;
+			return Value;
 		}
-		
-		/*
-		 * TODO
-		 */
-		virtual FORCEINLINE std::string GetPlayerAuthIDString() const noexcept
+
+		FORCEINLINE void SetName(const EAttributeName& InName)
 		{
-			return PlayerAuthID.Value;
+			Name = InName;
 		}
 
-		virtual FORCEINLINE std::string GetRequestID() const noexcept
+		FORCEINLINE void SetValue(const T& InValue)
 		{
-			return RequestID;
+			Value = InValue;
 		}
-		
-		virtual FORCEINLINE bool IsEmpty() const noexcept = 0;
-		virtual FORCEINLINE size_t Size() const noexcept = 0;
-		
-	protected:
-		const IAttributeString PlayerAuthID;
-		const std::string RequestID;
 	};
 
-	/*
-	 * GetRequest
-	 */
-	class IPC_ALIGN_TO_CACHE_LINE FGetRequest : public FIPCRequest
+	class IAttributeString : public IAttribute<std::string, EAttributeTypes::STRING>
 	{
 	public:
-		FGetRequest() = default;
-		FGetRequest(const FGetRequest& InRequest)
-			: FIPCRequest(InRequest.GetPlayerAuthID(), InRequest.GetRequestID())
+		IAttributeString()
+			: IAttribute<std::string, EAttributeTypes::STRING>()
 		{
-			for(int i = 0; i < InRequest.Size(); ++i)
-			{
-				AddAttributeToGet(InRequest[i]);
-			}
 		}
 		
-		FGetRequest(const IAttributeString& InPlayerAuthID,
-			const std::string& InRequestID)
-			: FIPCRequest(InPlayerAuthID, InRequestID),
-			AttributesToGet{}
+		IAttributeString(const EAttributeName& InName, const std::string& InValue)
+			: IAttribute<std::string, EAttributeTypes::STRING>(InName, InValue)
 		{
 		}
+	};
 
-		FGetRequest(
-			const IAttributeString& InPlayerAuthID,
-			const std::string& InRequestID,
-			const std::vector<EAttributeName>& InAttributesToGet)
-				: FIPCRequest(InPlayerAuthID, InRequestID),
-				AttributesToGet(InAttributesToGet)
+	// typedef IAttribute<std::string> IAttributeString;
+	typedef IAttribute<int, EAttributeTypes::INT>			IAttributeInt;
+	typedef IAttribute<float, EAttributeTypes::FLOAT>		IAttributeFloat;
+	typedef IAttribute<bool, EAttributeTypes::BOOL>			IAttributeBool;
+	
+	namespace TableDataStatics
+	{
+		namespace Internal
 		{
+			/*
+			 * TODO
+			 */
+			template<typename T, EAttributeTypes TAttributeType>
+			class IPC_ALIGN_REQUEST_PAYLOAD IColumnAttribute final
+				: public IAttribute<T, TAttributeType>
+			{
+			public:
+				T Key = IAttribute<T, TAttributeType>::Value;
+				
+				IColumnAttribute()
+					: IAttribute<T, TAttributeType>()
+				{
+				}
+
+				IColumnAttribute(const EAttributeName& InName,
+									const T& InKey)
+					: IAttribute<T, TAttributeType>(InName, InKey)
+				{
+				}
+			};
+
+			typedef IColumnAttribute<std::string, EAttributeTypes::STRING> IColumnAttributeString;
 		}
+		
+		static constexpr int NumberOfAttributes = 3;
+		
+		static const Internal::IColumnAttributeString TableKey_PlayerAuthID =
+			Internal::IColumnAttributeString(
+				EAttributeName::PLAYER_AUTH,
+				std::string("PlayerAuthID"));
+		
+		static const Internal::IColumnAttributeString TableKey_PlayerName =
+			Internal::IColumnAttributeString(
+				EAttributeName::PLAYER_NAME,
+				std::string("PlayerName"));
+		
+		static const Internal::IColumnAttributeString TableKey_IsOnline =
+			Internal::IColumnAttributeString(
+				EAttributeName::IS_ONLINE,
+				std::string("IsOnline"));
 
-		/*
-		 * TODO
+		/**
+		 * \brief The type of the value stored under an attribute, which is
+		 * what decides how the value is encoded.
 		 */
-		EAttributeName operator[](const int Index) const
+		static FORCEINLINE constexpr EAttributeTypes GetAttributeType(
+			const EAttributeName InAttributeName) noexcept
 		{
-			return AttributesToGet[Index];
+			switch(InAttributeName)
+			{
+				case EAttributeName::PLAYER_AUTH:
+				case EAttributeName::PLAYER_NAME:
+					return IAttributeString::Type;
+				case EAttributeName::IS_ONLINE:
+					return IAttributeBool::Type;
+				default:
+					return EAttributeTypes::NONE;
+			}
 		}
+	}
+	
+	/**
+	 * \brief The attributes in use by a list or a request, as one bit per
+	 * @link EAttributeName for O(1) membership, alongside the order they were
+	 * added in, which is the order they are written in. Fixed size, so
+	 * copying it never allocates.
+	 */
+	class FAttributeNameSet final
+	{
+	public:
+		static constexpr int Capacity = TableDataStatics::NumberOfAttributes + 1;
+		static_assert(Capacity <= 8, "attribute masks are 8 bits wide");
 
-		/*
-		 * TODO
+		/**
+		 * \brief The bit of an attribute, the same as @link FCompactRequest::AttributeBit.
 		 */
-		EAttributeName& operator[](const int Index)
+		static FORCEINLINE constexpr uint8_t Bit(const EAttributeName InAttributeName) noexcept
 		{
-			return AttributesToGet[Index];
+			return static_cast<uint8_t>(1u << static_cast<uint8_t>(InAttributeName));
 		}
 
-		/*
-		 * TODO
+		/** \brief The attribute added Index-th, Index must be below @link Size. */
+		FORCEINLINE EAttributeName operator[](const int Index) const noexcept
+		{
+			return Order[Index];
+		}
+
+		/**
+		 * \brief Add an attribute after the ones already in the set.
+		 * \return Fails if it was already in the set or is not a known attribute.
 		 */
-		FORCEINLINE bool AddAttributeToGet(const EAttributeName& InAttributeName)
+		FORCEINLINE bool Add(const EAttributeName InAttributeName) noexcept
 		{
-			if(CheckIfAttributeIsAlreadySet(InAttributeName))
+			if(static_cast<uint8_t>(InAttributeName) >= Capacity || Contains(InAttributeName))
 			{
 				return false;
 			}
-
-			AttributesToGet.push_back(InAttributeName);
+			Mask |= Bit(InAttributeName);
+			Order[Count++] = InAttributeName;
 			return true;
 		}
 
-		/*
-		 * TODO
+		/** \brief Whether the attribute is in the set, a single mask test. */
+		FORCEINLINE bool Contains(const EAttributeName InAttributeName) const noexcept
+		{
+			return (Mask & Bit(InAttributeName)) != 0;
+		}
+
+		/**
+		 * \brief Call a functor with each attribute in the set, lowest
+		 * @link EAttributeName first rather than in the order they were added.
 		 */
-		FORCEINLINE bool GetAttribute(
-			const int Index,
-			EAttributeName& OutAttribute) const
+		template<typename TFunctor>
+		FORCEINLINE void ForEachByName(TFunctor&& Functor) const
 		{
-			if(Index < Size())
+			for(uint32_t Remaining = Mask; Remaining != 0; Remaining &= Remaining - 1)
 			{
-				OutAttribute = AttributesToGet[Index];
-				return true;
+				Functor(static_cast<EAttributeName>(BitStatics::CountTrailingZeros(Remaining)));
 			}
-			return false;
 		}
 
-		/*!
-		 * @return Checks to see if there are no @link FGetRequest
-		 *			stored in the array.
-		 */
-		virtual FORCEINLINE bool IsEmpty() const noexcept override
+		/** \brief One @link Bit per attribute in the set. */
+		FORCEINLINE uint8_t GetMask() const noexcept
 		{
-			return Size() == 0;
+			return Mask;
 		}
 
-		/*
-		 * TODO
-		 */
-		virtual FORCEINLINE size_t Size() const noexcept override
+		/** \brief Whether no attribute has been added. */
+		FORCEINLINE bool IsEmpty() const noexcept
 		{
-			return AttributesToGet.size();
+			return Mask == 0;
 		}
-		
+
+		/** \brief The number of attributes in the set. */
+		FORCEINLINE size_t Size() const noexcept
+		{
+			return Count;
+		}
+
 	private:
+		uint8_t Mask = 0;
+		uint8_t Count = 0;
+		EAttributeName Order[Capacity] = {};
+	};
+	
+	/*
+	 * TODO
+	 */
+	class IPC_ALIGN_REQUEST_PAYLOAD FPlayerAttributeList final
+	{
+	public:
+		static constexpr int TotalNumberOfAttributes =
+			TableDataStatics::NumberOfAttributes;
+		
+		FPlayerAttributeList()
+			: AttributesInUse{},
+			PlayerAuthID(),
+			PlayerName(),
+			IsOnline()
+		{
+		}
+
 		/*
 		 * TODO
 		 */
-		FORCEINLINE bool CheckIfAttributeIsAlreadySet(
-			const EAttributeName& InAttributeName) const noexcept
+		EAttributeName operator[](const int Index) const
 		{
-			if(AttributesToGet.empty())
+			return AttributesInUse[Index];
+		}
+		
+		/*
+		 * TODO
+		 */
+		FORCEINLINE void SetPlayerAuthID(const IAttributeString& InPlayerAuthID)
+		{
+			AttributesInUse.Add(InPlayerAuthID.Name);
+			PlayerAuthID = InPlayerAuthID;
+		}
+
+		/*
+		 * TODO
+		 */
+		FORCEINLINE void SetPlayerName(const IAttributeString& InPlayerName)
+		{
+			AttributesInUse.Add(InPlayerName.Name);
+			PlayerName = InPlayerName;
+		}
+
+		/*
+		 * TODO
+		 */
+		FORCEINLINE void SetIsOnline(const IAttributeBool& InIsOnline)
+		{
+			AttributesInUse.Add(InIsOnline.Name);
+			IsOnline = InIsOnline;
+		}
+
+		/** \brief Whether the attribute is set, without searching the attributes. */
+		FORCEINLINE bool HasAttribute(const EAttributeName InAttributeName) const noexcept
+		{
+			return AttributesInUse.Contains(InAttributeName);
+		}
+
+		/**
+		 * \brief Mask of @link FAttributeNameSet::Bit for every attribute that is set.
+		 */
+		FORCEINLINE uint8_t GetAttributeMask() const noexcept
+		{
+			return AttributesInUse.GetMask();
+		}
+
+		/*
+		 * TODO
+		 */
+		FORCEINLINE const IAttributeString& GetPlayerAuthID() const noexcept
+		{
+			return PlayerAuthID;
+		}
+
+		/*
+		 * TODO
+		 */
+		FORCEINLINE const IAttributeString& GetPlayerName() const noexcept
+		{
+			return PlayerName;
+		}
+
+		/*
+		 * TODO
+		 */
+		FORCEINLINE const IAttributeBool& GetIsOnline() const noexcept
+		{
+			return IsOnline;
+		}
+
+		/*
+		 * TODO
+		 */
+		FORCEINLINE bool IsEmpty() const noexcept
+		{
+			return AttributesInUse.IsEmpty();
+		}
+
+		/*
+		 * TODO
+		 */
+		FORCEINLINE size_t Size() const noexcept
+		{
+			return AttributesInUse.Size();
+		}
+
+	private:
+		FAttributeNameSet AttributesInUse;
+		
+		IAttributeString	PlayerAuthID;
+		IAttributeString	PlayerName;
+		IAttributeBool		IsOnline;
+	};
+
+	/*
+	 * TODO
+	 */
+	class IPC_ALIGN_REQUEST_PAYLOAD FIPCRequest
+	{
+	public:
+		static constexpr int TotalNumberOfAttributes =
+			TableDataStatics::NumberOfAttributes;
+
+		FIPCRequest() = default;
+		FIPCRequest(IAttributeString InPlayerAuthID,
+			const FRequestID InRequestID)
+			: PlayerAuthID(std::move(InPlayerAuthID)),
+			RequestID(InRequestID)
+		{
+		}
+
+		FIPCRequest(const FIPCRequest&) = default;
+		FIPCRequest(FIPCRequest&&) noexcept = default;
+		FIPCRequest& operator=(const FIPCRequest&) = default;
+		FIPCRequest& operator=(FIPCRequest&&) noexcept = default;
+		virtual ~FIPCRequest() = default;
+		
+		/*
+		 * TODO
+		 */
+		virtual FORCEINLINE const IAttributeString& GetPlayerAuthID() const noexcept
+		{
+			return PlayerAuthID;
+		}
+		
+		/*
+		 * TODO
+		 */
+		virtual FORCEINLINE const std::string& GetPlayerAuthIDString() const noexcept
+		{
+			return PlayerAuthID.Value;
+		}
+
+		virtual FORCEINLINE FRequestID GetRequestID() const noexcept
+		{
+			return RequestID;
+		}
+
+		/**
+		 * \brief Which lane this request is buffered in, see @link ERequestPriority.
+		 */
+		FORCEINLINE ERequestPriority GetPriority() const noexcept
+		{
+			return Priority;
+		}
+
+		/** \brief Choose the lane this request is flushed in. */
+		FORCEINLINE void SetPriority(const ERequestPriority InPriority) noexcept
+		{
+			Priority = InPriority;
+		}
+
+		/**
+		 * \brief Make sure the buffer this request is added to is flushed by Deadline,
+		 * even if none of its flush triggers have been reached.
+		 */
+		FORCEINLINE void SetFlushDeadline(
+			const std::chrono::steady_clock::time_point Deadline) noexcept
+		{
+			FlushDeadlineNs = (std::max)(static_cast<int64_t>(1),
+				static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					Deadline.time_since_epoch()).count()));
+		}
+
+		/**
+		 * \return The flush deadline in steady clock nanoseconds, 0 if there isn't one.
+		 */
+		FORCEINLINE int64_t GetFlushDeadlineNs() const noexcept
+		{
+			return FlushDeadlineNs;
+		}
+		
+		virtual FORCEINLINE bool IsEmpty() const noexcept = 0;
+		virtual FORCEINLINE size_t Size() const noexcept = 0;
+		
+	protected:
+		IAttributeString PlayerAuthID;
+		FRequestID RequestID = 0;
+		ERequestPriority Priority = ERequestPriority::NORMAL;
+		int64_t FlushDeadlineNs = 0;
+	};
+
+	/*
+	 * GetRequest
+	 */
+	class IPC_ALIGN_REQUEST_PAYLOAD FGetRequest : public FIPCRequest
+	{
+	public:
+		FGetRequest() = default;
+		FGetRequest(const FGetRequest&) = default;
+		FGetRequest(FGetRequest&&) noexcept = default;
+		FGetRequest& operator=(const FGetRequest&) = default;
+		FGetRequest& operator=(FGetRequest&&) noexcept = default;
+		
+		FGetRequest(IAttributeString InPlayerAuthID,
+			const FRequestID InRequestID)
+			: FIPCRequest(std::move(InPlayerAuthID), InRequestID),
+			AttributesToGet{}
+		{
+		}
+
+		FGetRequest(
+			IAttributeString InPlayerAuthID,
+			const FRequestID InRequestID,
+			const std::initializer_list<EAttributeName> InAttributesToGet)
+				: FIPCRequest(std::move(InPlayerAuthID), InRequestID),
+				AttributesToGet{}
+		{
+			for(const EAttributeName Name : InAttributesToGet)
 			{
-				return false;
+				AttributesToGet.Add(Name);
+			}
+		}
+
+		FGetRequest(
+			IAttributeString InPlayerAuthID,
+			const FRequestID InRequestID,
+			const std::vector<EAttributeName>& InAttributesToGet)
+				: FIPCRequest(std::move(InPlayerAuthID), InRequestID),
+				AttributesToGet{}
+		{
+			for(const EAttributeName Name : InAttributesToGet)
+			{
+				AttributesToGet.Add(Name);
 			}
+		}
+
+		/*
+		 * TODO
+		 */
+		EAttributeName operator[](const int Index) const
+		{
+			return AttributesToGet[Index];
+		}
 
+		/*
+		 * TODO
+		 */
+		FORCEINLINE bool AddAttributeToGet(const EAttributeName& InAttributeName)
+		{
 			// Player Auth ID has to be set upon construction, so it's always
-			// set... It's not actually in the vector tho, it's a variable
+			// set... It's not actually in the set tho, it's a variable
 			// on the parent of this type
-			if(InAttributeName == TableDataStatics::TableKey_PlayerAuthID.Name)
+			if(!AttributesToGet.IsEmpty() &&
+				InAttributeName == TableDataStatics::TableKey_PlayerAuthID.Name)
 			{
-				return true;
+				return false;
 			}
-			
-			for(int i = 0; i < AttributesToGet.size(); ++i)
+			return AttributesToGet.Add(InAttributeName);
+		}
+
+		/** \brief Whether the attribute is one to get, without searching the list. */
+		FORCEINLINE bool HasAttribute(const EAttributeName InAttributeName) const noexcept
+		{
+			return AttributesToGet.Contains(InAttributeName);
+		}
+
+		/**
+		 * \brief Mask of @link FAttributeNameSet::Bit for every attribute to get.
+		 */
+		FORCEINLINE uint8_t GetAttributeMask() const noexcept
+		{
+			return AttributesToGet.GetMask();
+		}
+
+		/*
+		 * TODO
+		 */
+		FORCEINLINE bool GetAttribute(
+			const int Index,
+			EAttributeName& OutAttribute) const
+		{
+			if(Index < Size())
 			{
-				if(AttributesToGet[i] == InAttributeName)
-				{
-					return true;
-				}
+				OutAttribute = AttributesToGet[Index];
+				return true;
 			}
-			
 			return false;
 		}
+
+		/*!
+		 * @return Checks to see if there are no @link FGetRequest
+		 *			stored in the array.
+		 */
+		virtual FORCEINLINE bool IsEmpty() const noexcept override
+		{
+			return Size() == 0;
+		}
+
+		/*
+		 * TODO
+		 */
+		virtual FORCEINLINE size_t Size() const noexcept override
+		{
+			return AttributesToGet.Size();
+		}
 		
 	private:
-		std::vector<EAttributeName> AttributesToGet;
+		FAttributeNameSet AttributesToGet;
 	};
 
 	/*
 	 * SetRequest
 	 */
-	class IPC_ALIGN_TO_CACHE_LINE FPendingGetRequest final : public FGetRequest
+	class IPC_ALIGN_REQUEST_PAYLOAD FPendingGetRequest final : public FGetRequest
 	{
 	public:
 		FPendingGetRequest() = default;
-		FPendingGetRequest(const FPendingGetRequest& InRequest)
-			: FGetRequest(InRequest.GetPlayerAuthID(), InRequest.GetRequestID()),
-			UniqueID(InRequest.GetUniqueID()) 
+		FPendingGetRequest(const FPendingGetRequest&) = default;
+		FPendingGetRequest(FPendingGetRequest&&) noexcept = default;
+		FPendingGetRequest& operator=(const FPendingGetRequest&) = default;
+		FPendingGetRequest& operator=(FPendingGetRequest&&) noexcept = default;
+
+		/**
+		 * \brief Track a @link FGetRequest, using its request ID as the unique ID.
+		 */
+		explicit FPendingGetRequest(const FGetRequest& InRequest)
+			: FGetRequest(InRequest),
+			UniqueID(InRequest.GetRequestID())
 		{
 		}
 
 		FPendingGetRequest(
 			const FGetRequest& InRequest,
-			const std::string& InUniqueID)
-			: FGetRequest(InRequest.GetPlayerAuthID(), InRequest.GetRequestID()),
+			const FRequestID InUniqueID)
+			: FGetRequest(InRequest),
 			UniqueID(InUniqueID)
 		{
 		}
 		
 		FPendingGetRequest(
-			const IAttributeString& InPlayerAuthID,
-			const std::string& InRequestID,
-			const std::string& InUniqueID)
-				: FGetRequest(InPlayerAuthID, InRequestID),
+			IAttributeString InPlayerAuthID,
+			const FRequestID InRequestID,
+			const FRequestID InUniqueID)
+				: FGetRequest(std::move(InPlayerAuthID), InRequestID),
 				UniqueID(InUniqueID)
 		{
 		}
@@ -655,7 +1527,7 @@ namespace IPCFile
 		/*
 		 * TODO
 		 */
-		FORCEINLINE const std::string& GetUniqueID() const
+		FORCEINLINE FRequestID GetUniqueID() const noexcept
 		{
 			return UniqueID;
 		}
@@ -663,34 +1535,33 @@ namespace IPCFile
 		/*
 		 * TODO
 		 */	
-		FORCEINLINE void SetUniqueID(const std::string& InUniqueID) 
+		FORCEINLINE void SetUniqueID(const FRequestID InUniqueID) noexcept
 		{
 			UniqueID = InUniqueID;
 		}
 		
 	private:
-		std::string UniqueID;
+		FRequestID UniqueID = 0;
 	};
 	
 	/*
 	 * SetRequest
 	 */
-	class IPC_ALIGN_TO_CACHE_LINE FSetRequest final : public FIPCRequest
+	class IPC_ALIGN_REQUEST_PAYLOAD FSetRequest final : public FIPCRequest
 	{
 	public:
 		FSetRequest() = default;
-		FSetRequest(const FSetRequest& InRequest)
-			: FIPCRequest(InRequest.GetPlayerAuthID(), InRequest.GetRequestID()),
-			PlayerAttributes(InRequest.GetPlayerAttributeList())
-		{
-		}
+		FSetRequest(const FSetRequest&) = default;
+		FSetRequest(FSetRequest&&) noexcept = default;
+		FSetRequest& operator=(const FSetRequest&) = default;
+		FSetRequest& operator=(FSetRequest&&) noexcept = default;
 		
 		FSetRequest(
-			const IAttributeString& InPlayerAuthID,
-			const std::string& InRequestID,
-			const FPlayerAttributeList& InPlayerAttributes)
-				: FIPCRequest(InPlayerAuthID, InRequestID),
-				PlayerAttributes(InPlayerAttributes)
+			IAttributeString InPlayerAuthID,
+			const FRequestID InRequestID,
+			FPlayerAttributeList InPlayerAttributes)
+				: FIPCRequest(std::move(InPlayerAuthID), InRequestID),
+				PlayerAttributes(std::move(InPlayerAttributes))
 		{
 		}
 
@@ -719,994 +1590,11334 @@ namespace IPCFile
 		}
 		
 	private:
-		const FPlayerAttributeList PlayerAttributes;
+		FPlayerAttributeList PlayerAttributes;
 	};
+
+#if IPC_PACK_REQUESTS
+	// A request buffer reserves tens of thousands of these, keep them packed
+	static_assert(alignof(IAttributeBool) < IPC_PLATFORM_CACHE_LINE_SIZE &&
+		alignof(FGetRequest) < IPC_PLATFORM_CACHE_LINE_SIZE &&
+		alignof(FSetRequest) < IPC_PLATFORM_CACHE_LINE_SIZE,
+		"requests and attributes should not be padded out to a cache line");
+#endif
 	
-	/*
-	 * IPCFileManager main static class
+	/**
+	 * \brief Where a string value lives inside a @link FRequestArena.
 	 */
-	class IPC_ALIGN_TO_CACHE_LINE IPCFileManager final
+	struct FArenaSlice
 	{
-		/** The tick rate for threads on the UE side to use */
-		static constexpr int UE_BufferTickRateMS = 1000 / UE_BUFFER_TICK_RATE;
-		/** The tick rate for threads on the AWS side to use */
-		static constexpr int AWS_BufferTickRateMS = 1000 / AWS_BUFFER_TICK_RATE;
-		
+		uint32_t Offset = 0;
+		uint32_t Length = 0;
+	};
+
+	/**
+	 * \brief Growable byte arena that holds the string values for one batch of
+	 * @link FCompactRequest. Reset keeps the allocation, so a recycled arena
+	 * does not allocate again until a batch outgrows every previous one.
+	 */
+	class FRequestArena
+	{
+	public:
+		FRequestArena() = default;
+
 		/**
-		 * \brief Used to identify which platform a @link FRequestBuffer will be used on.
+		 * \brief Copy a string into the arena.
+		 * \return The slice to read the string back with.
 		 */
-		enum class ERequestBufferType : uint8_t
+		FORCEINLINE FArenaSlice Append(const std::string_view InString)
 		{
-			UE,
-			AWS,
-			BOTH
-		};
+			FArenaSlice Slice;
+			Slice.Offset = static_cast<uint32_t>(Bytes.size());
+			Slice.Length = static_cast<uint32_t>(InString.size());
+			Bytes.insert(Bytes.end(), InString.begin(), InString.end());
+			return Slice;
+		}
+
+		/** \brief The string a slice from @link Append refers to. */
+		FORCEINLINE std::string_view View(const FArenaSlice& Slice) const noexcept
+		{
+			return std::string_view(Bytes.data() + Slice.Offset, Slice.Length);
+		}
+
+		/** \brief Make room for InSize bytes of strings. */
+		FORCEINLINE void Reserve(const size_t InSize)
+		{
+			Bytes.reserve(InSize);
+		}
 
 		/**
- * \brief A basic Spin-lock implementation
- * \tparam bShouldUseSleep Should this SpinLoop use a sleep or not?
- */
-		template<bool bShouldUseSleep = true>
-		struct FSpinLoop
+		 * \brief Forget every string without giving the memory back.
+		 */
+		FORCEINLINE void Reset() noexcept
 		{
-			FSpinLoop()
-				: Flag{false}
-			{
-			}
-			
-			/**
-			 * \brief Run a Lambda functor through the lock
-			 * \param LambdaFunctor The functor to run
-			 * \return TODO this always returns true...
-			 */
-			FORCEINLINE void RunLambdaThroughLock(
-				std::function<void()> LambdaFunctor)
+			Bytes.clear();
+		}
+
+		/** \brief The number of bytes of strings held. */
+		FORCEINLINE size_t Size() const noexcept
+		{
+			return Bytes.size();
+		}
+
+	private:
+		std::vector<char> Bytes;
+	};
+
+	/**
+	 * \brief Reusable output for serializing a batch. Records are written
+	 * straight into chunks that are kept from one batch to the next, numbers
+	 * with std::to_chars and keys with memcpy, so a steady stream of batches
+	 * never allocates. A record never straddles two chunks, so its checksum
+	 * is taken in place, and it is folded into the file checksum as it ends.
+	 * The chunks go to a file with one writev.
+	 */
+	class FBatchWriter
+	{
+		struct FChunk
+		{
+			std::unique_ptr<char[]> Data;
+			size_t Capacity = 0;
+			size_t Used = 0;
+		};
+		
+	public:
+		static constexpr size_t ChunkSize = 64 * 1024;
+
+		FBatchWriter() = default;
+		FBatchWriter(const FBatchWriter&) = delete;
+		FBatchWriter& operator=(const FBatchWriter&) = delete;
+
+		/**
+		 * \brief Start a new batch, keeping the chunks.
+		 */
+		FORCEINLINE void Reset() noexcept
+		{
+			NumberOfChunksUsed = 0;
+			Cursor = nullptr;
+			End = nullptr;
+			RecordStart = nullptr;
+			FileCrc = 0;
+		}
+
+		/** \brief Append Size bytes. */
+		FORCEINLINE void Append(const char* Data, const size_t Size)
+		{
+			if(static_cast<size_t>(End - Cursor) < Size)
 			{
-				Lock();
-				LambdaFunctor();
-				Unlock();
+				Grow(Size);
 			}
-			
-			/*
-			 * TODO
-			 */
-			FORCEINLINE void Lock() noexcept
-			{
-				for(;;)
-				{
-					if(!Flag.exchange(true, std::memory_order_acquire))
-					{
-						return;
-					}
+			std::memcpy(Cursor, Data, Size);
+			Cursor += Size;
+		}
 
-					while(Flag.load(std::memory_order_relaxed))
-					{
-						if(bShouldUseSleep)
-						{
-							std::this_thread::sleep_for(
-								std::chrono::milliseconds(
-									SPIN_LOOP_SLEEP_TIME_MS));
-						}
-						else
-						{
-							SPIN_LOOP_PAUSE();
-						}
-					}
-				}
+		/** \brief Append the characters of Text. */
+		FORCEINLINE void Append(const std::string_view Text)
+		{
+			Append(Text.data(), Text.size());
+		}
+
+		/** \brief Append a single character. */
+		FORCEINLINE void Append(const char Char)
+		{
+			if(Cursor == End)
+			{
+				Grow(1);
 			}
+			*Cursor++ = Char;
+		}
 
-			/*
-			 * TODO
-			 */
-			FORCEINLINE bool TryLock() noexcept
+		/**
+		 * \brief Append an integer in base 10.
+		 */
+		template<typename TInteger>
+		FORCEINLINE void AppendNumber(const TInteger Value)
+		{
+			constexpr size_t MaxDigits = std::numeric_limits<TInteger>::digits10 + 2;
+			if(static_cast<size_t>(End - Cursor) < MaxDigits)
 			{
-				return !Flag.load(std::memory_order_relaxed) &&
-					!Flag.exchange(true, std::memory_order_acquire);
+				Grow(MaxDigits);
 			}
+			Cursor = std::to_chars(Cursor, End, Value).ptr;
+		}
 
-			/*
-			 * TODO
-			 */
-			FORCEINLINE void Unlock()
+		/**
+		 * \brief Finish the record written since the last one ended with its
+		 * CRC32C and a newline.
+		 */
+		FORCEINLINE void EndRecord()
+		{
+			constexpr size_t TerminatorSize = 1 + CHECKSUM_HEX_LENGTH + 1;
+			if(static_cast<size_t>(End - Cursor) < TerminatorSize)
 			{
-				Flag.store(false, std::memory_order_release);
+				Grow(TerminatorSize);
 			}
+			const uint32_t Crc = FCrc32C::Compute(RecordStart, Cursor - RecordStart);
+			*Cursor++ = CHECKSUM_DELIM_CHAR;
+			HexStatics::Write(Cursor, Crc, CHECKSUM_HEX_LENGTH);
+			Cursor += CHECKSUM_HEX_LENGTH;
+			*Cursor++ = NEWLINE_CHAR;
+			FileCrc = FCrc32C::Compute(RecordStart, Cursor - RecordStart, FileCrc);
+			RecordStart = Cursor;
+		}
 
-		private:
-			std::atomic<bool> Flag;
-		};
+		/**
+		 * \brief Append the footer, which holds the CRC32C of every record before it.
+		 */
+		FORCEINLINE void EndFile()
+		{
+			char Footer[sizeof(FILE_FOOTER_STRING) + CHECKSUM_HEX_LENGTH];
+			std::memcpy(Footer, FILE_FOOTER_STRING, sizeof(FILE_FOOTER_STRING) - 1);
+			Footer[sizeof(FILE_FOOTER_STRING) - 1] = CHECKSUM_DELIM_CHAR;
+			HexStatics::Write(Footer + sizeof(FILE_FOOTER_STRING), FileCrc, CHECKSUM_HEX_LENGTH);
+			Append(Footer, sizeof(Footer));
+			RecordStart = Cursor;
+		}
+
+		/** \brief The number of bytes written since the last @link Reset. */
+		FORCEINLINE size_t Size() const noexcept
+		{
+			size_t Total = 0;
+			for(size_t i = 0; i + 1 < NumberOfChunksUsed; ++i)
+			{
+				Total += Chunks[i].Used;
+			}
+			return (NumberOfChunksUsed == 0) ?
+				(0) : (Total + (Cursor - Chunks[NumberOfChunksUsed - 1].Data.get()));
+		}
 
 		/**
-		 * TODO This type currently is using a vector to store the data..
-		 * TODO this is not very efficient memory wise.. a circular buffer
-		 * TODO is required to make this simple
-		 * 
-		 * \brief Base type used for the @link FGetRequest and @link FSetRequest buffer types.
-		 * \tparam T The type of data that will be stored in the buffer.
-		 * \tparam TBufferPlatform The platform (UE/AWS) that this buffer is being used for.
+		 * \brief The whole batch as one piece, only copied if it spans more than one chunk.
 		 */
-		template<typename T, ERequestBufferType TBufferPlatform>
-		class IPC_ALIGN_TO_CACHE_LINE FRequestBuffer
+		FORCEINLINE std::string_view View()
 		{
-		public:
-			FRequestBuffer()
-				: ReserveSize{(TBufferPlatform == ERequestBufferType::UE) ?
-					(UE_BUFFER_MAX) : (AWS_BUFFER_MAX)},
-				CurrentReserveMultiplier{1}
+			if(NumberOfChunksUsed <= 1)
 			{
-				RequestBuffer.reserve(
-					ReserveSize * CurrentReserveMultiplier);
+				return (NumberOfChunksUsed == 0) ?
+					(std::string_view()) :
+					(std::string_view(Chunks[0].Data.get(), Cursor - Chunks[0].Data.get()));
 			}
-			
-			/**
-			 * \brief Initialize this buffer
-			 */
-			virtual FORCEINLINE void Initialize()
+			SealCurrentChunk();
+			Flat.clear();
+			for(size_t i = 0; i < NumberOfChunksUsed; ++i)
 			{
-				FRequestBuffer();
+				Flat.append(Chunks[i].Data.get(), Chunks[i].Used);
 			}
+			return Flat;
+		}
 
-			/**
-			 * \brief Lock the buffer
-			 */
-			virtual FORCEINLINE void LockBuffer() noexcept
+		/**
+		 * \brief Create, or replace, a file holding the batch.
+		 */
+		FORCEINLINE bool WriteToFile(const std::string& FullNameAndPath)
+		{
+			SealCurrentChunk();
+#if defined(_WIN64) || defined(_WIN32)
+			FILE* File;
+			fopen_s(&File, FullNameAndPath.c_str(), WRITE_MODE);
+			if(!File)
 			{
-				BufferLock.Lock();
+				return false;
 			}
-
-			/**
-			 * \brief Unlock the buffer
-			 */
-			virtual FORCEINLINE void UnlockBuffer() noexcept
+			bool bWritten = true;
+			for(size_t i = 0; i < NumberOfChunksUsed && bWritten; ++i)
 			{
-				BufferLock.Unlock();
+				bWritten = fwrite(Chunks[i].Data.get(), 1, Chunks[i].Used, File) == Chunks[i].Used;
 			}
-
-			/**
-			 * \brief Get a reference to the buffer
-			 */
-			virtual FORCEINLINE std::vector<T>& GetBuffer()
+			return fclose(File) == 0 && bWritten;
+#else
+			const int Handle = open(FullNameAndPath.c_str(),
+				O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+			if(Handle < 0)
 			{
-				return RequestBuffer;
+				return false;
 			}
 			
-			/**
-			 * \brief Pushes an element into the buffer, in a thread safe manner. 
-			 * \param InRequest Element to push into the buffer.
-			 */
-			virtual FORCEINLINE void PushBack(const T& InRequest)
+			// IOV_MAX is at least 1024 on linux
+			constexpr size_t MaxChunksPerWrite = 1024;
+			iovec Vectors[MaxChunksPerWrite];
+			size_t Next = 0;
+			size_t Skip = 0;
+			bool bWritten = true;
+			while(Next < NumberOfChunksUsed && bWritten)
 			{
-				const bool ShouldReserve = (Size() == (ReserveSize.load(
-					std::memory_order_relaxed) * CurrentReserveMultiplier.load(
-						std::memory_order_acquire) - 1));
-				uint64_t Old = 0;
-				if(ShouldReserve)
+				int Count = 0;
+				for(size_t i = Next; i < NumberOfChunksUsed && Count < static_cast<int>(MaxChunksPerWrite); ++i)
 				{
-					Old = CurrentReserveMultiplier.fetch_add(
-						1, std::memory_order_acq_rel);
+					const size_t Offset = (i == Next) ? (Skip) : (0);
+					Vectors[Count].iov_base = Chunks[i].Data.get() + Offset;
+					Vectors[Count].iov_len = Chunks[i].Used - Offset;
+					++Count;
 				}
-				
-				BufferLock.RunLambdaThroughLock([=]()
-				{
-					if(ShouldReserve)
-					{
-						RequestBuffer.reserve(ReserveSize * (Old + 1));
-					}
-					RequestBuffer.push_back(InRequest);
-				});
-				BufferSize.fetch_add(1, std::memory_order_acq_rel);
-			}
-
-			virtual FORCEINLINE bool RemoveIndex(const uint32_t Index)
-			{
-				if(IsEmpty())
+				const ssize_t Written = writev(Handle, Vectors, Count);
+				if(Written < 0 && errno == EINTR)
 				{
-					return false;
+					continue;
 				}
-				BufferSize.fetch_sub(1, std::memory_order_acq_rel);
-				BufferLock.RunLambdaThroughLock([=]()
+				bWritten = Written >= 0;
+				// Step past what went out, a short write resumes mid chunk
+				size_t Remaining = (bWritten) ? (static_cast<size_t>(Written)) : (0);
+				while(Next < NumberOfChunksUsed && Remaining >= Chunks[Next].Used - Skip)
 				{
-					// RequestBuffer.erase(Index); TODO
-				});
-				return true;
+					Remaining -= Chunks[Next].Used - Skip;
+					++Next;
+					Skip = 0;
+				}
+				Skip += Remaining;
 			}
-			
-			/**
-			 * \brief Completely erase all elements from the buffer in a thread safe manner.
-			 */
-			virtual FORCEINLINE void Clear()
+			return close(Handle) == 0 && bWritten;
+#endif
+		}
+
+	private:
+		/**
+		 * \brief Move on to the next chunk, taking the unfinished record along.
+		 * \param Needed How many bytes are about to be written.
+		 */
+		FORCEINLINE void Grow(const size_t Needed)
+		{
+			const char* Partial = (RecordStart) ? (RecordStart) : (Cursor);
+			const size_t PartialSize = Cursor - Partial;
+			if(NumberOfChunksUsed > 0)
 			{
-				BufferLock.RunLambdaThroughLock([=]() -> void
-				{
-					RequestBuffer.clear();
-					RequestBuffer.reserve(ReserveSize.load(std::memory_order_relaxed));
-				});
-				CurrentReserveMultiplier.store(1, std::memory_order_release);
-				BufferSize.store(0, std::memory_order_release);
+				Chunks[NumberOfChunksUsed - 1].Used = Partial - Chunks[NumberOfChunksUsed - 1].Data.get();
 			}
-			
-			/**
-			 * \brief Checks if there are no elements in the buffer in a thread safe manner.
-			 * \return Whether or not the buffer is currently empty.
-			 */
-			virtual FORCEINLINE bool IsEmpty() const noexcept
+			if(NumberOfChunksUsed == Chunks.size())
 			{
-				return Size() == 0;
+				Chunks.emplace_back();
 			}
 			
-			/**
-			 * \brief Check how many elements are in the buffer in a thread safe manner. 
-			 * \return The amount of elements currently in the buffer.
-			 */
-			virtual FORCEINLINE size_t Size() const noexcept
+			// A record bigger than a chunk gets a chunk of its own size
+			FChunk& Chunk = Chunks[NumberOfChunksUsed++];
+			const size_t Capacity = (std::max)(ChunkSize, PartialSize + Needed);
+			if(Chunk.Capacity < Capacity)
 			{
-				return BufferSize.load(std::memory_order_acquire);
+				Chunk.Data.reset(new char[Capacity]);
+				Chunk.Capacity = Capacity;
 			}
-			
-			/**
-			 * \brief Runs a given functor that will be protected by the @link FSpinLoop lock.
-			 * \param Lambda Lambda functor to be run through the lock.
-			 */
-			virtual FORCEINLINE void RunLambdaThroughLock(std::function<void()> Lambda)
+			if(PartialSize > 0)
 			{
-				BufferLock.RunLambdaThroughLock(Lambda);
+				std::memcpy(Chunk.Data.get(), Partial, PartialSize);
 			}
-			
-		protected:
-			const std::atomic<uint64_t> ReserveSize;
-			std::atomic<uint64_t> CurrentReserveMultiplier;
-			std::atomic<uint64_t> BufferSize;
+			RecordStart = Chunk.Data.get();
+			Cursor = RecordStart + PartialSize;
+			End = Chunk.Data.get() + Chunk.Capacity;
+		}
 
-			FSpinLoop<true> BufferLock;
-			mutable std::vector<T> RequestBuffer;
-		};
+		FORCEINLINE void SealCurrentChunk() noexcept
+		{
+			if(NumberOfChunksUsed > 0)
+			{
+				Chunks[NumberOfChunksUsed - 1].Used = Cursor - Chunks[NumberOfChunksUsed - 1].Data.get();
+			}
+		}
 		
+		std::vector<FChunk> Chunks;
+		size_t NumberOfChunksUsed = 0;
+		char* Cursor = nullptr;
+		char* End = nullptr;
+		char* RecordStart = nullptr;
+		uint32_t FileCrc = 0;
+		/** Only used when a contiguous view of more than one chunk is asked for */
+		std::string Flat;
+	};
+
+	/**
+	 * \brief The binary form of attribute values, chosen by @link EAttributeTypes.
+	 * Ints are zigzag varints, floats their raw IEEE bits, strings a varint
+	 * length and the bytes as they are, and bools a bit each in one varint
+	 * per record, so nothing has to be converted to or from text.
+	 */
+	namespace ValueCodecStatics
+	{
+		/** Enough bytes for any uint64_t as a varint */
+		static constexpr size_t MaxVarintBytes = 10;
+
 		/**
-		 * \brief A buffer used to store all pending @link FGetRequest while they wait to be written to a file.
-		 * \tparam TBufferPlatform The platform (UE/AWS) that this buffer is being used for.
+		 * \brief Map a signed value to an unsigned one so small magnitudes of
+		 * either sign stay small: 0, -1, 1, -2 become 0, 1, 2, 3.
 		 */
-		template<ERequestBufferType TBufferPlatform>
-		class IPC_ALIGN_TO_CACHE_LINE FGetRequestBuffer final
-			: public FRequestBuffer<FGetRequest, TBufferPlatform>
+		static FORCEINLINE constexpr uint64_t ZigZagEncode(const int64_t Value) noexcept
 		{
-		public:
-			FGetRequestBuffer()
-				: FRequestBuffer<FGetRequest, TBufferPlatform>()
+			return (static_cast<uint64_t>(Value) << 1) ^ static_cast<uint64_t>(Value >> 63);
+		}
+
+		/** \brief Undo @link ZigZagEncode. */
+		static FORCEINLINE constexpr int64_t ZigZagDecode(const uint64_t Value) noexcept
+		{
+			return static_cast<int64_t>(Value >> 1) ^ -static_cast<int64_t>(Value & 1);
+		}
+
+		/** \brief The number of bytes @link WriteVarint writes for the value, 1 to @link MaxVarintBytes. */
+		static FORCEINLINE constexpr size_t VarintSize(uint64_t Value) noexcept
+		{
+			size_t Size = 1;
+			while(Value >= 0x80)
 			{
+				Value >>= 7;
+				++Size;
 			}
+			return Size;
+		}
 
-			/**
-			 * \brief Initialize this buffer
-			 */
-			virtual FORCEINLINE void Initialize() override
+		/**
+		 * \brief Write a varint, 7 bits per byte with the lowest bits first.
+		 * \return The number of bytes written, at most @link MaxVarintBytes.
+		 */
+		static FORCEINLINE size_t WriteVarint(char* Out, uint64_t Value) noexcept
+		{
+			size_t Size = 0;
+			while(Value >= 0x80)
 			{
-				FGetRequestBuffer();
+				Out[Size++] = static_cast<char>((Value & 0x7F) | 0x80);
+				Value >>= 7;
 			}
-			
-			/**
-			 * \brief Write all the current @link FGetRequest in this buffer to a specified file location.
-			 * \param FileLocation The directory to write the file to.
-			 */
-			FORCEINLINE void WriteGetRequestsToFileThroughLock(
-				const std::string& FileLocation)
-			{
-				this->RunLambdaThroughLock([=]()
-				{
-					std::string CompleteFileString = "";
-					for(int i = 0; i < this->Size(); ++i)
-					{
-						const FGetRequest Request = this->RequestBuffer[i];
-						std::string CurrentLine;
-						const std::string RequestID = Request.GetRequestID();
-						CurrentLine.append(RequestID + REQUEST_ID_DELIM_CHAR);
-						// add the player auth to the beginning so we know who it's for
-						const std::string PlayerAuth = Request.GetPlayerAuthIDString() +
-							DELIM_CHAR;
-						CurrentLine.append(PlayerAuth);
-						for(int j = 0; j < Request.Size(); ++j)
-						{
-							switch(Request[j])
-							{
-								case EAttributeName::NONE:
-									break;
-								case EAttributeName::PLAYER_AUTH:
-									CurrentLine.append(TableKey_PlayerAuthID.Key);
-									break;
-								case EAttributeName::PLAYER_NAME:
-									CurrentLine.append(TableKey_PlayerName.Key);
-									break;
-								case EAttributeName::IS_ONLINE:
-									CurrentLine.append(TableKey_IsOnline.Key);
-									break;
-								default:
-									break;
-							}
-							CurrentLine += DELIM_CHAR;
-						}
-						CurrentLine += NEWLINE_CHAR;
-						CompleteFileString.append(CurrentLine);
-					}
-					CompleteFileString.append(FILE_FOOTER_STRING);
+			Out[Size++] = static_cast<char>(Value);
+			return Size;
+		}
 
-					std::string UniqueFileName;
-					GeneratorUniqueFileName(UniqueFileName, ERequestType::GET);
-					if(UniqueFileName == NULL_STRING)
-					{
-						return;
-					}
-					
-					const std::string FullNameAndPath = FileLocation +
-						FILE_DIRECTORY_DELIM + UniqueFileName + FILE_EXTENSION;
-								
-					WriteStringToFile(FullNameAndPath, CompleteFileString);
-				});
-			}
-		};
+		/** \brief Append the value to the batch as a varint. */
+		static FORCEINLINE void AppendVarint(FBatchWriter& Writer, const uint64_t Value)
+		{
+			char Buffer[MaxVarintBytes];
+			Writer.Append(Buffer, WriteVarint(Buffer, Value));
+		}
 
 		/**
-		 * TODO
+		 * \brief Read a varint and step In past it.
+		 * \return Fails if the input ends first or the varint is too long.
 		 */
-		template<ERequestBufferType TBufferPlatform>
-		class IPC_ALIGN_TO_CACHE_LINE FPendingGetRequestBuffer final
-			: public FRequestBuffer<FPendingGetRequest, TBufferPlatform>
+		static FORCEINLINE bool ReadVarint(
+			const char*& In,
+			const char* End,
+			uint64_t& OutValue) noexcept
 		{
-		public:
-			FPendingGetRequestBuffer()
-				: FRequestBuffer<FPendingGetRequest, TBufferPlatform>()
+			OutValue = 0;
+			for(int Shift = 0; In < End && Shift < 64; Shift += 7)
 			{
+				const uint8_t Byte = static_cast<uint8_t>(*In++);
+				OutValue |= static_cast<uint64_t>(Byte & 0x7F) << Shift;
+				if((Byte & 0x80) == 0)
+				{
+					return true;
+				}
 			}
-
-			/**
-			 * \brief Initialize this buffer
-			 */
-			virtual FORCEINLINE void Initialize() override
+			return false;
+		}
+
+		/**
+		 * \brief Encoding of a single value of an @link EAttributeTypes. Bools
+		 * have none of their own, they are packed by @link FBinarySetRecordEncoder.
+		 */
+		template<EAttributeTypes TAttributeType>
+		struct TValueCodec;
+
+		template<>
+		struct TValueCodec<EAttributeTypes::STRING>
+		{
+			static FORCEINLINE size_t Size(const std::string_view Value) noexcept
 			{
-				FPendingGetRequestBuffer();
+				return VarintSize(Value.size()) + Value.size();
 			}
-			
-			/**
-			 * TODO
-			 */
-			FPendingGetRequest operator[](const int Index)
+
+			static FORCEINLINE void Encode(FBatchWriter& Writer, const std::string_view Value)
 			{
-				FPendingGetRequest Out;
-				this->RunLambdaThroughLock([=]()
+				AppendVarint(Writer, Value.size());
+				Writer.Append(Value);
+			}
+
+			static FORCEINLINE bool Decode(const char*& In, const char* End, std::string& OutValue)
+			{
+				uint64_t Length;
+				if(!ReadVarint(In, End, Length) || Length > static_cast<uint64_t>(End - In))
 				{
-					Out = this->RequestBuffer[Index];
-				});
-				return Out;
+					return false;
+				}
+				OutValue.assign(In, static_cast<size_t>(Length));
+				In += Length;
+				return true;
+			}
+		};
+
+		template<>
+		struct TValueCodec<EAttributeTypes::INT>
+		{
+			static FORCEINLINE size_t Size(const int64_t Value) noexcept
+			{
+				return VarintSize(ZigZagEncode(Value));
+			}
+
+			static FORCEINLINE void Encode(FBatchWriter& Writer, const int64_t Value)
+			{
+				AppendVarint(Writer, ZigZagEncode(Value));
+			}
+
+			static FORCEINLINE bool Decode(const char*& In, const char* End, int64_t& OutValue) noexcept
+			{
+				uint64_t Encoded;
+				if(!ReadVarint(In, End, Encoded))
+				{
+					return false;
+				}
+				OutValue = ZigZagDecode(Encoded);
+				return true;
 			}
+		};
+
+		template<>
+		struct TValueCodec<EAttributeTypes::FLOAT>
+		{
+			static_assert(sizeof(float) == sizeof(uint32_t), "floats are written as 32 bit IEEE 754");
 			
+			static FORCEINLINE constexpr size_t Size(const float) noexcept
+			{
+				return sizeof(uint32_t);
+			}
+
 			/**
-			 * TODO
+			 * \brief Write the bits of the float, least significant byte first
+			 * whatever the byte order of the machine.
 			 */
-			FORCEINLINE bool RemoveElement(const uint32_t Index)
+			static FORCEINLINE void Encode(FBatchWriter& Writer, const float Value)
 			{
-				return this->RemoveIndex(Index);
+				uint32_t Bits;
+				std::memcpy(&Bits, &Value, sizeof(Bits));
+				char Buffer[sizeof(Bits)];
+				for(size_t i = 0; i < sizeof(Bits); ++i)
+				{
+					Buffer[i] = static_cast<char>(Bits >> (i * 8));
+				}
+				Writer.Append(Buffer, sizeof(Buffer));
+			}
+
+			static FORCEINLINE bool Decode(const char*& In, const char* End, float& OutValue) noexcept
+			{
+				if(End - In < static_cast<std::ptrdiff_t>(sizeof(uint32_t)))
+				{
+					return false;
+				}
+				uint32_t Bits = 0;
+				for(size_t i = 0; i < sizeof(Bits); ++i)
+				{
+					Bits |= static_cast<uint32_t>(static_cast<uint8_t>(In[i])) << (i * 8);
+				}
+				std::memcpy(&OutValue, &Bits, sizeof(Bits));
+				In += sizeof(Bits);
+				return true;
 			}
 		};
-		
+	}
+
+	/**
+	 * \brief Framing of binary records. A binary record is the marker byte,
+	 * a varint length and that many bytes of payload, then the same checksum
+	 * and newline as a text record. The length is what finds its end, since
+	 * the payload can hold newlines of its own.
+	 */
+	namespace RecordStatics
+	{
 		/**
-		 * \brief A buffer used to store all pending @link FSetRequest while they wait to be written to a file.
-		 * \tparam TBufferPlatform The platform (UE/AWS) that this buffer is being used for.
+		 * \brief Find where the record starting at Start ends.
+		 * \return One past its newline, or npos if the record is not complete.
 		 */
-		template<ERequestBufferType TBufferPlatform>
-		class IPC_ALIGN_TO_CACHE_LINE FSetRequestBuffer final
-			: public FRequestBuffer<FSetRequest, TBufferPlatform>
+		static FORCEINLINE size_t FindRecordEnd(
+			const std::string_view Text,
+			const size_t Start) noexcept
+		{
+			if(Start < Text.size() && Text[Start] == BINARY_RECORD_MARKER)
+			{
+				const char* In = Text.data() + Start + 1;
+				const char* End = Text.data() + Text.size();
+				uint64_t Length;
+				if(ValueCodecStatics::ReadVarint(In, End, Length) && Length <= Text.size())
+				{
+					const size_t RecordEnd = (In - Text.data()) + Length + 1 + CHECKSUM_HEX_LENGTH + 1;
+					if(RecordEnd > Text.size())
+					{
+						return std::string_view::npos;
+					}
+					if(Text[RecordEnd - 1] == NEWLINE_CHAR)
+					{
+						return RecordEnd;
+					}
+				}
+				// Not a well formed binary record, the checksum will catch it
+			}
+			const size_t Newline = Text.find(NEWLINE_CHAR, Start);
+			return (Newline == std::string_view::npos) ? (Newline) : (Newline + 1);
+		}
+
+		/**
+		 * \return One past the newline of the last complete record in Text.
+		 */
+		static FORCEINLINE size_t FindLastRecordEnd(const std::string_view Text) noexcept
+		{
+			size_t LastEnd = 0;
+			while(LastEnd < Text.size())
+			{
+				const size_t RecordEnd = FindRecordEnd(Text, LastEnd);
+				if(RecordEnd == std::string_view::npos)
+				{
+					break;
+				}
+				LastEnd = RecordEnd;
+			}
+			return LastEnd;
+		}
+
+		/**
+		 * \return One past the newline of the first record ending at least
+		 * MinimumBytes after Start, or the end of Text. Text split there is split
+		 * between whole records.
+		 */
+		static FORCEINLINE size_t FindChunkEnd(
+			const std::string_view Text,
+			const size_t Start,
+			const size_t MinimumBytes) noexcept
+		{
+			size_t ChunkEnd = Start;
+			while(ChunkEnd < Text.size() && ChunkEnd - Start < MinimumBytes)
+			{
+				// Binary records may hold newlines, so walk them rather than seek
+				const size_t RecordEnd = FindRecordEnd(Text, ChunkEnd);
+				if(RecordEnd == std::string_view::npos)
+				{
+					return Text.size();
+				}
+				ChunkEnd = RecordEnd;
+			}
+			return ChunkEnd;
+		}
+
+		/**
+		 * \brief The bit of each attribute whose values are bools.
+		 */
+		static FORCEINLINE constexpr uint64_t GetBoolAttributeMask() noexcept
+		{
+			uint64_t Mask = 0;
+			for(int Name = 0; Name <= TableDataStatics::NumberOfAttributes; ++Name)
+			{
+				if(TableDataStatics::GetAttributeType(static_cast<EAttributeName>(Name)) ==
+					EAttributeTypes::BOOL)
+				{
+					Mask |= uint64_t(1) << Name;
+				}
+			}
+			return Mask;
+		}
+
+		/**
+		 * \brief Write a binary GET record: a varint request ID, the player auth
+		 * as a string, a varint count then one byte per attribute to get. The
+		 * caller appends the Count attribute names, then ends the record.
+		 */
+		static FORCEINLINE void BeginBinaryGetRecord(
+			FBatchWriter& Writer,
+			const FRequestID RequestID,
+			const std::string_view PlayerAuthID,
+			const size_t Count)
+		{
+			using namespace ValueCodecStatics;
+			const size_t Length = VarintSize(RequestID) +
+				TValueCodec<EAttributeTypes::STRING>::Size(PlayerAuthID) + VarintSize(Count) + Count;
+			Writer.Append(BINARY_RECORD_MARKER);
+			AppendVarint(Writer, Length);
+			AppendVarint(Writer, RequestID);
+			TValueCodec<EAttributeTypes::STRING>::Encode(Writer, PlayerAuthID);
+			AppendVarint(Writer, Count);
+		}
+
+		/** Set in a binary SET record's attribute mask when a varint request ID follows the mask */
+		static constexpr uint64_t BinaryRequestIDBit = uint64_t(1) << 6;
+		static_assert(TableDataStatics::NumberOfAttributes < 6,
+			"attribute bits must stay below the request ID bit, in the mask's first byte");
+
+		/**
+		 * \brief Builds a binary SET record: a varint of the attributes that are
+		 * present, the request ID if there is one, a varint holding one bit per
+		 * present bool attribute, then the other values in attribute order.
+		 * Every value is typed by @link TableDataStatics::GetAttributeType, a
+		 * value of the wrong type is left out.
+		 */
+		class FBinarySetRecordEncoder
 		{
 		public:
-			FSetRequestBuffer()
-				: FRequestBuffer<FSetRequest, TBufferPlatform>()
+			explicit FBinarySetRecordEncoder(FBatchWriter& InWriter) noexcept
+				: Writer(InWriter)
 			{
 			}
 
 			/**
-			 * \brief Initialize this buffer
+			 * \brief Carry the ID of the request the record is for, a GET response
+			 * carries the ID of its GET.
 			 */
-			virtual FORCEINLINE void Initialize() override
+			FORCEINLINE void SetRequestID(const FRequestID InRequestID) noexcept
 			{
-				FSetRequestBuffer();
+				RequestID = InRequestID;
 			}
-			
+
 			/**
-			 * \brief Write all the current @link FSetRequest in this buffer to a specified file location.
-			 * \param FileLocation The directory to write the file to.
+			 * \brief Add a string attribute. The view is kept, not copied, so it
+			 * has to live until @link Write.
 			 */
-			FORCEINLINE void WriteSetRequestsToFileThroughLock(
-				const std::string& FileLocation)
+			FORCEINLINE void AddString(const EAttributeName Name, const std::string_view Value) noexcept
 			{
-				this->RunLambdaThroughLock([=]()
+				if(Accepts(Name, EAttributeTypes::STRING))
 				{
-					std::string CompleteFileString = "";
-					for(int i = 0; i < this->Size(); ++i)
-					{
-						const FSetRequest Request = this->RequestBuffer[i];
-						const FPlayerAttributeList PlayerAttributes =
-							Request.GetPlayerAttributeList();
-						std::string CurrentLine = "";
-						
-						for(int j = 0; j < PlayerAttributes.Size(); ++j)
-						{
-							// Combine each attribute key and value into a string
-							// then append it to the line.
-							FAttributeStringPair StringPair;
-							for(int k = 0; k < PlayerAttributes.Size(); ++k)
-							{
-								switch(PlayerAttributes[k])
-								{
-									case EAttributeName::NONE:
-										// it should never be this...
-										break;
-									case EAttributeName::PLAYER_AUTH:
-										StringPair.KeyString = TableKey_PlayerAuthID.Key;
-										StringPair.ValueString =
-											PlayerAttributes.GetPlayerAuthID().Value;
-										break;
-									case EAttributeName::PLAYER_NAME:
-										StringPair.KeyString = TableKey_PlayerName.Key;
-										StringPair.ValueString =
-											PlayerAttributes.GetPlayerName().Value;
-										break;
-									case EAttributeName::IS_ONLINE:
-										StringPair.KeyString = TableKey_IsOnline.Key;
-										StringPair.ValueString =
-											(PlayerAttributes.GetIsOnline().Value) ?
-												(TRUE_STRING) : (FALSE_STRING);
-										break;
-									default:
-										// should not be able to get here...
-										break;
-								}
-								const std::string AttributeString = StringPair.KeyString +
-									ATTRIBUTE_DELIM_CHAR + StringPair.ValueString + DELIM_CHAR;
-								CurrentLine.append(AttributeString);
-							}
-						}
-						CurrentLine += NEWLINE_CHAR;
-						CompleteFileString.append(CurrentLine);
-					}
-					CompleteFileString.append(FILE_FOOTER_STRING);
+					Values[static_cast<uint8_t>(Name)].String = Value;
+				}
+			}
 
-					std::string UniqueFileName;
-					GeneratorUniqueFileName(UniqueFileName, ERequestType::SET);
-					if(UniqueFileName == NULL_STRING)
-					{
-						return;
-					}
-					const std::string FullNameAndPath = FileLocation +
-						FILE_DIRECTORY_DELIM + UniqueFileName + FILE_EXTENSION;
-						
-					WriteStringToFile(FullNameAndPath, CompleteFileString);
-				});
+			/** \brief Add an int attribute, written as a zigzag varint. */
+			FORCEINLINE void AddInt(const EAttributeName Name, const int64_t Value) noexcept
+			{
+				if(Accepts(Name, EAttributeTypes::INT))
+				{
+					Values[static_cast<uint8_t>(Name)].Int = Value;
+				}
 			}
-		};
-		
-		/*
-		 * TODO Need to make sure any requests in the buffers are written to file
-		 * TODO upon shutdown of the threads & erasing the buffers...
-		 * TODO ... obivous data loss otherwise
-		 *
-		 * TODO
-		 */
-		template<ERequestBufferType TBufferRequestType>
-		class IPC_ALIGN_TO_CACHE_LINE FBufferThread
-		{
-			static constexpr int TickRate =
-				(TBufferRequestType == ERequestBufferType::UE) ?
-					(UE_BufferTickRateMS) : (AWS_BufferTickRateMS);
-			
-		public:
-			FBufferThread()
-				: IsRunning{false},
-				ShouldStop{false}
+
+			/** \brief Add a float attribute, written as its 4 IEEE bytes. */
+			FORCEINLINE void AddFloat(const EAttributeName Name, const float Value) noexcept
 			{
+				if(Accepts(Name, EAttributeTypes::FLOAT))
+				{
+					Values[static_cast<uint8_t>(Name)].Float = Value;
+				}
 			}
-			
+
+			/** \brief Add a bool attribute, written as one bit of the record's bool varint. */
+			FORCEINLINE void AddBool(const EAttributeName Name, const bool Value) noexcept
+			{
+				if(Accepts(Name, EAttributeTypes::BOOL))
+				{
+					Values[static_cast<uint8_t>(Name)].bBool = Value;
+				}
+			}
+
 			/**
-			 * \brief Start the thread
-			 * \param Functor The functor that represents one tick of this thread.
+			 * \brief Write the marker, length and payload, the caller ends the record.
 			 */
-			virtual FORCEINLINE void StartThread(
-				const std::function<void()>& Functor)
+			FORCEINLINE void Write()
 			{
-				if(IsRunning.load(std::memory_order_acquire))
+				using namespace ValueCodecStatics;
+				constexpr uint64_t BoolMask = GetBoolAttributeMask();
+				uint64_t BoolBits = 0;
+				int NumberOfBools = 0;
+				size_t Length = VarintSize(Mask);
+				for(int Name = 0; Name < MaxNames; ++Name)
 				{
-					return;
+					if((Mask & (uint64_t(1) << Name)) == 0)
+					{
+						continue;
+					}
+					const FValue& Value = Values[Name];
+					switch(TableDataStatics::GetAttributeType(static_cast<EAttributeName>(Name)))
+					{
+						case EAttributeTypes::STRING:
+							Length += TValueCodec<EAttributeTypes::STRING>::Size(Value.String);
+							break;
+						case EAttributeTypes::INT:
+							Length += TValueCodec<EAttributeTypes::INT>::Size(Value.Int);
+							break;
+						case EAttributeTypes::FLOAT:
+							Length += TValueCodec<EAttributeTypes::FLOAT>::Size(Value.Float);
+							break;
+						case EAttributeTypes::BOOL:
+							BoolBits |= static_cast<uint64_t>(Value.bBool) << NumberOfBools++;
+							break;
+						default:
+							break;
+					}
 				}
-				
-				std::thread([=] ()
+				const bool bHasRequestID = RequestID != RequestIDStatics::None;
+				const uint64_t Header = (bHasRequestID) ? (Mask | BinaryRequestIDBit) : (Mask);
+				Length += VarintSize(Header) - VarintSize(Mask);
+				if(bHasRequestID)
 				{
-					IsRunning.store(true, std::memory_order_release);
-					for(;;)
+					Length += VarintSize(RequestID);
+				}
+				if(Mask & BoolMask)
+				{
+					Length += VarintSize(BoolBits);
+				}
+
+				Writer.Append(BINARY_RECORD_MARKER);
+				AppendVarint(Writer, Length);
+				AppendVarint(Writer, Header);
+				if(bHasRequestID)
+				{
+					AppendVarint(Writer, RequestID);
+				}
+				if(Mask & BoolMask)
+				{
+					AppendVarint(Writer, BoolBits);
+				}
+				for(int Name = 0; Name < MaxNames; ++Name)
+				{
+					if((Mask & (uint64_t(1) << Name)) == 0)
 					{
-						if(ShouldStop.load(std::memory_order_acquire))
-						{
+						continue;
+					}
+					const FValue& Value = Values[Name];
+					switch(TableDataStatics::GetAttributeType(static_cast<EAttributeName>(Name)))
+					{
+						case EAttributeTypes::STRING:
+							TValueCodec<EAttributeTypes::STRING>::Encode(Writer, Value.String);
+							break;
+						case EAttributeTypes::INT:
+							TValueCodec<EAttributeTypes::INT>::Encode(Writer, Value.Int);
+							break;
+						case EAttributeTypes::FLOAT:
+							TValueCodec<EAttributeTypes::FLOAT>::Encode(Writer, Value.Float);
+							break;
+						default:
 							break;
-						}
-						
-						Functor();
-						std::this_thread::sleep_for(
-							std::chrono::milliseconds(TickRate));
 					}
-
-					IsRunning.store(false, std::memory_order_release);
-				}).detach();
+				}
 			}
 
-			/**
-			 * \brief Stop the thread from running.
-			 */
-			virtual FORCEINLINE void StopThread()
+		private:
+			static constexpr int MaxNames = TableDataStatics::NumberOfAttributes + 1;
+
+			struct FValue
 			{
-				ShouldStop.store(true, std::memory_order_release);
-			}
+				std::string_view String;
+				int64_t Int = 0;
+				float Float = 0.0f;
+				bool bBool = false;
+			};
 
-			/*
-			 * \brief Check whether or not the thread is currently running.
-			 */
-			virtual FORCEINLINE bool GetIsRunning() const
+			FORCEINLINE bool Accepts(const EAttributeName Name, const EAttributeTypes Type) noexcept
 			{
-				return IsRunning.load(std::memory_order_acquire);
+				const uint8_t Index = static_cast<uint8_t>(Name);
+				if(Index >= MaxNames || TableDataStatics::GetAttributeType(Name) != Type)
+				{
+					return false;
+				}
+				Mask |= uint64_t(1) << Index;
+				return true;
 			}
 
-		private:
-			std::atomic<bool> IsRunning;
-			std::atomic<bool> ShouldStop;
+			FBatchWriter& Writer;
+			FValue Values[MaxNames];
+			uint64_t Mask = 0;
+			FRequestID RequestID = RequestIDStatics::None;
 		};
-		
-	public:
-		template<typename T, EAttributeTypes TAttributeType> using FColumnAttribute	=
-			TableDataStatics::Internal::IColumnAttribute<T, TAttributeType>;
-		
-		inline static const FColumnAttribute<std::string, EAttributeTypes::STRING>
-			TableKey_PlayerAuthID = TableDataStatics::TableKey_PlayerAuthID;
-		inline static const FColumnAttribute<std::string, EAttributeTypes::STRING>
-			TableKey_PlayerName = TableDataStatics::TableKey_PlayerName;
-		inline static const FColumnAttribute<std::string, EAttributeTypes::STRING>
-			TableKey_IsOnline = TableDataStatics::TableKey_IsOnline;
+	}
+
+	/**
+	 * \brief Flat, trivially copyable form of a GET or SET request, with no
+	 * vtable and no heap allocations of its own. String values are slices of
+	 * the @link FRequestArena of the batch the record was added to.
+	 */
+	struct FCompactRequest
+	{
+		FRequestID RequestID;
+		FArenaSlice PlayerAuthID;
+		FArenaSlice PlayerName;
+		/** One bit per @link EAttributeName that is requested (GET) or set (SET) */
+		uint8_t AttributeMask;
+		ERequestType RequestType;
+		bool bIsOnline;
+
+		static FORCEINLINE constexpr uint8_t AttributeBit(
+			const EAttributeName InAttributeName) noexcept
+		{
+			return FAttributeNameSet::Bit(InAttributeName);
+		}
+
+		/** \brief Whether the request holds, or asks for, the attribute. */
+		FORCEINLINE bool HasAttribute(const EAttributeName InAttributeName) const noexcept
+		{
+			return (AttributeMask & AttributeBit(InAttributeName)) != 0;
+		}
+
+		/**
+		 * \brief Flatten a @link FGetRequest, copying its strings into an arena.
+		 */
+		static FORCEINLINE FCompactRequest FromGetRequest(
+			const FGetRequest& InRequest,
+			FRequestArena& Arena)
+		{
+			FCompactRequest Out = {};
+			Out.RequestType = ERequestType::GET;
+			Out.RequestID = InRequest.GetRequestID();
+			Out.PlayerAuthID = Arena.Append(InRequest.GetPlayerAuthIDString());
+			Out.AttributeMask = InRequest.GetAttributeMask();
+			return Out;
+		}
+
+		/**
+		 * \brief Flatten a @link FSetRequest, copying its strings into an arena.
+		 */
+		static FORCEINLINE FCompactRequest FromSetRequest(
+			const FSetRequest& InRequest,
+			FRequestArena& Arena)
+		{
+			const FPlayerAttributeList& Attributes = InRequest.GetPlayerAttributeList();
+			FCompactRequest Out = {};
+			Out.RequestType = ERequestType::SET;
+			Out.RequestID = InRequest.GetRequestID();
+			// The list's own PLAYER_AUTH wins, the request's is only the fallback
+			if(!Attributes.HasAttribute(EAttributeName::PLAYER_AUTH))
+			{
+				Out.PlayerAuthID = Arena.Append(InRequest.GetPlayerAuthIDString());
+			}
+			for(size_t i = 0; i < Attributes.Size(); ++i)
+			{
+				const EAttributeName Name = Attributes[static_cast<int>(i)];
+				Out.AttributeMask |= AttributeBit(Name);
+				switch(Name)
+				{
+					case EAttributeName::PLAYER_AUTH:
+						Out.PlayerAuthID = Arena.Append(
+							Attributes.GetPlayerAuthID().Value);
+						break;
+					case EAttributeName::PLAYER_NAME:
+						Out.PlayerName = Arena.Append(
+							Attributes.GetPlayerName().Value);
+						break;
+					case EAttributeName::IS_ONLINE:
+						Out.bIsOnline = Attributes.GetIsOnline().Value;
+						break;
+					default:
+						break;
+				}
+			}
+			return Out;
+		}
+	};
+
+	static_assert(std::is_trivially_copyable<FCompactRequest>::value,
+		"FCompactRequest must stay trivially copyable");
+
+	/**
+	 * \brief One batch of @link FCompactRequest and the arena their strings live in.
+	 */
+	struct FCompactRequestBatch
+	{
+		std::vector<FCompactRequest> Records;
+		FRequestArena Arena;
+
+		FCompactRequestBatch()
+		{
+			Records.reserve(COMPACT_BATCH_RESERVE_SIZE);
+			Arena.Reserve(COMPACT_ARENA_RESERVE_SIZE);
+		}
+
+		/**
+		 * \brief Empty the batch, keeping its memory for the next use.
+		 */
+		FORCEINLINE void Reset() noexcept
+		{
+			Records.clear();
+			Arena.Reset();
+		}
+	};
+	
+	/**
+	 * \brief A column of strings stored back to back in one byte vector.
+	 */
+	class FStringColumn
+	{
+	public:
+		FStringColumn() = default;
+
+		/**
+		 * \brief Append a value to the end of the column.
+		 */
+		FORCEINLINE void PushBack(const std::string_view InValue)
+		{
+			Slices.push_back(AppendBytes(InValue));
+		}
+
+		/**
+		 * \brief Replace the value of a row. The old bytes are left in place
+		 * until the column is reset.
+		 */
+		FORCEINLINE void Set(const size_t Row, const std::string_view InValue)
+		{
+			Slices[Row] = AppendBytes(InValue);
+		}
+
+		/** \brief The value in a row. */
+		FORCEINLINE std::string_view operator[](const size_t Row) const noexcept
+		{
+			return std::string_view(Bytes.data() + Slices[Row].Offset, Slices[Row].Length);
+		}
+
+		/**
+		 * \brief Empty the column, keeping its memory for the next batch.
+		 */
+		FORCEINLINE void Reset() noexcept
+		{
+			Slices.clear();
+			Bytes.clear();
+		}
+
+	private:
+		FORCEINLINE FArenaSlice AppendBytes(const std::string_view InValue)
+		{
+			FArenaSlice Slice;
+			Slice.Offset = static_cast<uint32_t>(Bytes.size());
+			Slice.Length = static_cast<uint32_t>(InValue.size());
+			Bytes.insert(Bytes.end(), InValue.begin(), InValue.end());
+			return Slice;
+		}
+
+		std::vector<FArenaSlice> Slices;
+		std::vector<char> Bytes;
+	};
+
+	/**
+	 * \brief A tick's worth of SET requests stored column by column: the request
+	 * IDs, the player auth IDs the requests are keyed on, one column per
+	 * attribute and a bitmask per row of which attributes are present. Passes
+	 * over one attribute only touch that attribute's contiguous column.
+	 */
+	class FColumnarSetBatch
+	{
+	public:
+		FColumnarSetBatch() = default;
+
+		/**
+		 * \brief Append one @link FSetRequest as a new row.
+		 */
+		FORCEINLINE void AddRow(const FSetRequest& InRequest)
+		{
+			const FPlayerAttributeList& Attributes = InRequest.GetPlayerAttributeList();
+			const uint8_t Presence = Attributes.GetAttributeMask();
+
+			RequestIDs.push_back(InRequest.GetRequestID());
+			PresenceMasks.push_back(Presence);
+			PlayerAuthIDs.PushBack((Presence & FCompactRequest::AttributeBit(
+				EAttributeName::PLAYER_AUTH)) ?
+					(Attributes.GetPlayerAuthID().Value) :
+					(InRequest.GetPlayerAuthIDString()));
+			PlayerNames.PushBack(Attributes.GetPlayerName().Value);
+			IsOnline.push_back(Attributes.GetIsOnline().Value ? 1 : 0);
+		}
+
+		/**
+		 * \brief Merge every row for the same player into one row, later rows
+		 * overwriting the attributes of earlier ones, and write the result to
+		 * OutBatch. Rows keep the order their player was first seen in.
+		 * \param bMergeRequestIDs Whether rows that carry a request ID are merged,
+		 * a merged row only keeps the last one. Without it those rows are copied
+		 * as they are, so every GET response still answers its own GET.
+		 */
+		FORCEINLINE void CoalesceInto(FColumnarSetBatch& OutBatch, const bool bMergeRequestIDs = true)
+		{
+			OutBatch.Reset();
+			RowByPlayer.clear();
+			for(size_t Row = 0; Row < Size(); ++Row)
+			{
+				const std::string_view PlayerAuthID = PlayerAuthIDs[Row];
+				if(!bMergeRequestIDs && RequestIDs[Row] != RequestIDStatics::None)
+				{
+					CopyRowInto(OutBatch, Row);
+					continue;
+				}
+				const auto Found = RowByPlayer.find(PlayerAuthID);
+				if(Found == RowByPlayer.end())
+				{
+					RowByPlayer.emplace(PlayerAuthID, OutBatch.Size());
+					CopyRowInto(OutBatch, Row);
+					continue;
+				}
+
+				const size_t Target = Found->second;
+				const uint8_t Presence = PresenceMasks[Row];
+				OutBatch.RequestIDs[Target] = RequestIDs[Row];
+				OutBatch.PresenceMasks[Target] |= Presence;
+				if(Presence & FCompactRequest::AttributeBit(EAttributeName::PLAYER_NAME))
+				{
+					OutBatch.PlayerNames.Set(Target, PlayerNames[Row]);
+				}
+				if(Presence & FCompactRequest::AttributeBit(EAttributeName::IS_ONLINE))
+				{
+					OutBatch.IsOnline[Target] = IsOnline[Row];
+				}
+			}
+		}
+
+		/**
+		 * \brief Empty the batch, keeping its memory for the next tick.
+		 */
+		FORCEINLINE void Reset() noexcept
+		{
+			RequestIDs.clear();
+			PresenceMasks.clear();
+			PlayerAuthIDs.Reset();
+			PlayerNames.Reset();
+			IsOnline.clear();
+		}
+
+		/** \brief The number of rows in the batch. */
+		FORCEINLINE size_t Size() const noexcept
+		{
+			return RequestIDs.size();
+		}
+
+		/** \brief Whether the row carries a value for the attribute. */
+		FORCEINLINE bool HasAttribute(
+			const size_t Row,
+			const EAttributeName InAttributeName) const noexcept
+		{
+			return (PresenceMasks[Row] & FCompactRequest::AttributeBit(InAttributeName)) != 0;
+		}
+
+		std::vector<FRequestID> RequestIDs;
+		std::vector<uint8_t> PresenceMasks;
+		FStringColumn PlayerAuthIDs;
+		FStringColumn PlayerNames;
+		std::vector<uint8_t> IsOnline;
+
+	private:
+		FORCEINLINE void CopyRowInto(FColumnarSetBatch& OutBatch, const size_t Row) const
+		{
+			OutBatch.RequestIDs.push_back(RequestIDs[Row]);
+			OutBatch.PresenceMasks.push_back(PresenceMasks[Row]);
+			OutBatch.PlayerAuthIDs.PushBack(PlayerAuthIDs[Row]);
+			OutBatch.PlayerNames.PushBack(PlayerNames[Row]);
+			OutBatch.IsOnline.push_back(IsOnline[Row]);
+		}
+
+		std::unordered_map<std::string_view, size_t> RowByPlayer;
+	};
+	
+	/**
+	 * \brief The outcome of one backend call, per player.
+	 */
+	enum class EBackendResult : uint8_t
+	{
+		OK,
+		/** The player has never been stored, a GET still gets a response */
+		NOT_FOUND,
+		/** The backend is over its request rate, try again later */
+		THROTTLED,
+		FAILED
+	};
+
+	/**
+	 * \brief The store the AWS side reads GETs from and writes SETs to, keyed by
+	 * PlayerAuthID. Implementations must be thread safe.
+	 */
+	class IAWSBackend
+	{
+	public:
+		virtual ~IAWSBackend() = default;
+
+		/**
+		 * \brief Load every stored attribute of a player.
+		 * \param OutAttributes Set to the stored attributes, including the PlayerAuthID.
+		 */
+		virtual EBackendResult GetPlayer(
+			const std::string& PlayerAuthID,
+			FPlayerAttributeList& OutAttributes) = 0;
+
+		/**
+		 * \brief Store the attributes set in InAttributes, leaving the rest of
+		 * the player as it was. InAttributes must contain the PlayerAuthID.
+		 */
+		virtual EBackendResult SetPlayer(const FPlayerAttributeList& InAttributes) = 0;
+
+		/**
+		 * \brief Load many players in one call. Backends with a batch API should
+		 * override this, by default it calls @link GetPlayer for each one.
+		 * \param OutAttributes Resized to match PlayerAuthIDs.
+		 * \param OutResults Resized to match PlayerAuthIDs.
+		 */
+		virtual void GetPlayers(
+			const std::vector<std::string>& PlayerAuthIDs,
+			std::vector<FPlayerAttributeList>& OutAttributes,
+			std::vector<EBackendResult>& OutResults)
+		{
+			OutAttributes.resize(PlayerAuthIDs.size());
+			OutResults.resize(PlayerAuthIDs.size());
+			for(size_t i = 0; i < PlayerAuthIDs.size(); ++i)
+			{
+				OutResults[i] = GetPlayer(PlayerAuthIDs[i], OutAttributes[i]);
+			}
+		}
+
+		/**
+		 * \brief Store many players in one call, see @link GetPlayers.
+		 * \param OutResults Resized to match InAttributes.
+		 */
+		virtual void SetPlayers(
+			const std::vector<FPlayerAttributeList>& InAttributes,
+			std::vector<EBackendResult>& OutResults)
+		{
+			OutResults.resize(InAttributes.size());
+			for(size_t i = 0; i < InAttributes.size(); ++i)
+			{
+				OutResults[i] = SetPlayer(InAttributes[i]);
+			}
+		}
+	};
+
+	/**
+	 * \brief Artificial cost for @link IPCFileManager::FInMemoryBackend, so it
+	 * can stand in for DynamoDB under load.
+	 */
+	struct FInMemoryBackendConfig
+	{
+		/** Added to every call, a batch call pays it once */
+		uint32_t LatencyUs = 0;
+		/** Up to this much more latency is added at random per call */
+		uint32_t LatencyJitterUs = 0;
+		/**
+		 * Players read or written per second before calls are THROTTLED, with a
+		 * burst of up to one second's worth. 0 never throttles.
+		 */
+		uint32_t MaxPlayersPerSecond = 0;
+	};
+
+	/**
+	 * \brief Settings for the pipelined AWS request processor.
+	 */
+	struct FAWSProcessorConfig
+	{
+		/** Where the UE side writes its GET and SET files */
+		std::string InboxDirectory;
+		/** Where GET responses are flushed, empty leaves that to AWS_WriteSetRequestBufferToFile */
+		std::string OutboxDirectory;
+		/** How many backend batch calls can be waiting at once, one thread each */
+		size_t MaxInFlightBatches = AWS_PIPELINE_IN_FLIGHT;
+		/** The most rows in one backend batch call */
+		size_t BatchSize = AWS_PIPELINE_BATCH_SIZE;
+		/** The most items waiting between any two stages */
+		size_t QueueCapacity = AWS_PIPELINE_QUEUE_CAPACITY;
+		/**
+		 * How many times the backoff between retries of throttled rows doubles.
+		 * Throttled rows are retried until they go through or the processor is
+		 * stopped, their file is then left to be ingested again.
+		 */
+		uint32_t MaxThrottleRetries = 3;
+		/**
+		 * How many bytes of files each producer may ingest per round of the fair
+		 * scheduler, before its weight is applied
+		 */
+		uint64_t FairShareQuantumBytes = AWS_PRODUCER_QUANTUM_BYTES;
+		/**
+		 * How many threads verify and parse ingested files, 0 for one per hardware
+		 * thread. With more than one, several files are read at once and large
+		 * files are split into record aligned chunks, the results are still
+		 * handed to the backend in the order the files were ingested.
+		 */
+		size_t NumberOfParseWorkers = AWS_PIPELINE_PARSE_WORKERS;
+	};
+
+	/**
+	 * \brief Throughput of one stage of the AWS request processor. A stage with
+	 * a high BusyNs and a full input queue is the bottleneck, a high StalledNs
+	 * means the stage after it is.
+	 */
+	struct FPipelineStageStats
+	{
+		/** Inbox scans that found files for ingest, files for parse, batches for backend and serialize */
+		uint64_t ItemsProcessed = 0;
+		/** Files for ingest, records for every other stage */
+		uint64_t RowsProcessed = 0;
+		/** Time spent working, summed over the stage's threads */
+		uint64_t BusyNs = 0;
+		/** Time spent waiting for room in the next stage's queue */
+		uint64_t StalledNs = 0;
+		/** Items waiting in the stage's input queue when the snapshot was taken */
+		size_t QueueDepth = 0;
+	};
+
+	/**
+	 * \brief Snapshot of the AWS request processor, see
+	 * @link IPCFileManager::AWS_GetRequestProcessorStats.
+	 */
+	struct FAWSProcessorStats
+	{
+		FPipelineStageStats Ingest;
+		FPipelineStageStats Parse;
+		FPipelineStageStats Backend;
+		FPipelineStageStats Serialize;
+		/** Rows still throttled when the processor was stopped */
+		uint64_t RowsThrottled = 0;
+		/** Rows the backend failed, or whose GET response couldn't be buffered */
+		uint64_t RowsFailed = 0;
+	};
+
+	/**
+	 * \brief Backlog of one UE process writing into the AWS inbox, see
+	 * @link IPCFileManager::AWS_RegisterProducer.
+	 */
+	struct FProducerStats
+	{
+		/** The producer's subdirectory of the inbox, empty for the inbox itself */
+		std::string Name;
+		uint32_t Weight = 1;
+		/** Files waiting in the producer's directory when it was last scanned */
+		size_t PendingFiles = 0;
+		uint64_t PendingBytes = 0;
+		/** How long the oldest of those files had been waiting */
+		uint64_t LagMS = 0;
+		uint64_t FilesIngested = 0;
+	};
+
+	/**
+	 * \brief Settings for the Unix domain socket transport, which carries the
+	 * same batches the buffers would otherwise write to files.
+	 */
+	struct FSocketTransportConfig
+	{
+		/** The path of the socket, it has to be on a volume both processes can see */
+		std::string SocketPath;
+		/**
+		 * How many batches the other end may send before it has to wait for
+		 * this end to finish handling one
+		 */
+		uint32_t Credits = SOCKET_DEFAULT_CREDITS;
+		/** Frames larger than this close the connection */
+		uint32_t MaxFrameBytes = SOCKET_MAX_FRAME_BYTES;
+		/**
+		 * How long a connecting end waits between attempts to reconnect once
+		 * the other end has gone, its batches are written to files meanwhile
+		 */
+		uint32_t ReconnectIntervalMS = SOCKET_RECONNECT_INTERVAL_MS;
+	};
+
+	/**
+	 * \brief Counters for one end of the socket transport.
+	 */
+	struct FSocketTransportStats
+	{
+		uint64_t BatchesSent = 0;
+		uint64_t BatchesReceived = 0;
+		uint64_t BytesSent = 0;
+		uint64_t BytesReceived = 0;
+		/** Sends that failed because the other end had not returned any credits */
+		uint64_t SendsWithoutCredit = 0;
+		/** Times a connecting end got its connection back after losing it */
+		uint64_t Reconnects = 0;
+		size_t NumberOfPeers = 0;
+	};
+
+	/**
+	 * \brief Settings for a pool of preallocated segment files, which take the
+	 * place of a new file per batch in one directory.
+	 */
+	struct FSegmentPoolConfig
+	{
+		/** The directory the buffers flush to, the segments are created in it */
+		std::string Directory;
+		/** Unique to the writing process, defaults to its instance ID */
+		std::string PoolName;
+		uint32_t NumberOfSegments = SEGMENT_DEFAULT_COUNT;
+		/** The largest batch a segment holds, bigger ones are written as files */
+		uint64_t SegmentBytes = SEGMENT_DEFAULT_BYTES;
+		/**
+		 * Append NORMAL batches to a long lived segment per request type,
+		 * which the reader tails as records are committed
+		 */
+		bool bStreamRecords = false;
+		/** A stream is handed over for recycling once it is this old */
+		uint32_t RotateAfterMS = SEGMENT_ROTATE_AFTER_MS;
+	};
+
+	/**
+	 * \brief Bytes taken by each buffered request, see
+	 * @link IPCFileManager::GetRequestFootprint. Only the objects themselves
+	 * are counted, a string too long for its small string buffer adds a heap
+	 * allocation of its own on top.
+	 */
+	struct FRequestFootprint
+	{
+		size_t BytesPerGetRequest = 0;
+		size_t BytesPerSetRequest = 0;
+		size_t BytesPerPendingGetRequest = 0;
+		size_t BytesPerCompactRequest = 0;
+		size_t BytesPerAttributeList = 0;
+		/** What a GET or SET buffer grows by, nothing is reserved until a request is added */
+		size_t BytesPerGetBufferChunk = 0;
+		size_t BytesPerSetBufferChunk = 0;
+	};
+
+	/**
+	 * \brief Counters for the writing end of a segment pool.
+	 */
+	struct FSegmentPoolStats
+	{
+		uint64_t BatchesWritten = 0;
+		uint64_t BytesWritten = 0;
+		/** Batches written as files because they didn't fit or no segment was free */
+		uint64_t BatchesSpilled = 0;
+		size_t NumberOfSegments = 0;
+		size_t SegmentsFree = 0;
+		/** Streams sealed because they filled up or got old */
+		uint64_t StreamsRotated = 0;
+	};
+
+	/**
+	 * \brief How an asynchronous GET finished.
+	 */
+	enum class EAsyncGetStatus : uint8_t
+	{
+		PENDING,
+		/** The response was consumed, the attributes are in the result */
+		READY,
+		/** No response was consumed before the timeout */
+		TIMED_OUT,
+		/** The request never made it into a buffer, was dropped from one, or the system shut down */
+		FAILED
+	};
+
+	/**
+	 * \brief What an asynchronous GET resolved with.
+	 */
+	struct FAsyncGetResult
+	{
+		EAsyncGetStatus Status = EAsyncGetStatus::PENDING;
+		FPlayerAttributeList Attributes;
+	};
+
+	/**
+	 * \brief Where the completion of an asynchronous GET is delivered.
+	 */
+	enum class ECompletionDelivery : uint8_t
+	{
+		/** On whichever IPC thread consumes the response or times it out */
+		INLINE,
+		/** Through the completion queue, on the thread that calls UE_DispatchCompletions */
+		QUEUED
+	};
+
+	/** \brief Whether an @link FIPCCompletion is a GET response or a SET acknowledgement. */
+	enum class ECompletionType : uint8_t
+	{
+		GET,
+		SET
+	};
+
+	/**
+	 * \brief One GET response or SET acknowledgement, handed out by
+	 * @link IPCFileManager::UE_DispatchCompletions.
+	 */
+	struct FIPCCompletion
+	{
+		ECompletionType Type = ECompletionType::GET;
+		FRequestID RequestID = 0;
+		/**
+		 * How a GET finished. A SET is READY once it has been written to a
+		 * file, or FAILED if the write failed.
+		 */
+		EAsyncGetStatus Status = EAsyncGetStatus::PENDING;
+		/** The response, for GETs that are READY */
+		FPlayerAttributeList Attributes;
+	};
+
+	/**
+	 * \brief State shared between an @link FGetFuture and the manager. It
+	 * completes exactly once, and runs at most one continuation on the
+	 * thread that completes it, or on the thread that adds the continuation
+	 * if it has already completed.
+	 */
+	class FAsyncGetState
+	{
+		static constexpr uint8_t HasContinuationFlag = 1;
+		static constexpr uint8_t CompletedFlag = 2;
+		
+	public:
+		FAsyncGetState(
+			const FRequestID InRequestID,
+			std::string InPlayerAuthID,
+			const std::chrono::steady_clock::time_point InDeadline,
+			const ECompletionDelivery InDelivery = ECompletionDelivery::INLINE)
+			: RequestID(InRequestID),
+			PlayerAuthID(std::move(InPlayerAuthID)),
+			Deadline(InDeadline),
+			Delivery(InDelivery),
+			bClaimed{false},
+			Flags{0}
+		{
+		}
+
+		/**
+		 * \brief Resolve the GET, only the first call does anything.
+		 * \param InAttributes The response, ignored unless InStatus is READY.
+		 * \return Whether this call was the one that completed the GET.
+		 */
+		FORCEINLINE bool Complete(
+			const EAsyncGetStatus InStatus,
+			const FPlayerAttributeList* InAttributes = nullptr)
+		{
+			if(bClaimed.exchange(true, std::memory_order_acq_rel))
+			{
+				return false;
+			}
+			Result.Status = InStatus;
+			if(InAttributes)
+			{
+				Result.Attributes = *InAttributes;
+			}
+			if(Flags.fetch_or(CompletedFlag, std::memory_order_acq_rel) & HasContinuationFlag)
+			{
+				Continuation();
+				Continuation = nullptr;
+			}
+			return true;
+		}
+
+		/**
+		 * \brief Store the function to run on completion.
+		 * \return Fails if the GET has already completed, the function is not
+		 * stored and the caller should run it.
+		 */
+		FORCEINLINE bool SetContinuation(std::function<void()> InContinuation)
+		{
+			Continuation = std::move(InContinuation);
+			if(Flags.fetch_or(HasContinuationFlag, std::memory_order_acq_rel) & CompletedFlag)
+			{
+				Continuation = nullptr;
+				return false;
+			}
+			return true;
+		}
+
+		/** \brief Whether the GET has had its response, timed out or failed. */
+		FORCEINLINE bool IsComplete() const noexcept
+		{
+			return (Flags.load(std::memory_order_acquire) & CompletedFlag) != 0;
+		}
+
+		/**
+		 * \brief Only valid once @link IsComplete is true.
+		 */
+		FORCEINLINE const FAsyncGetResult& GetResult() const noexcept
+		{
+			return Result;
+		}
+
+		/** \brief The ID the GET was sent with, and its response comes back with. */
+		FORCEINLINE FRequestID GetRequestID() const noexcept
+		{
+			return RequestID;
+		}
+
+		/** \brief The player the GET is for. */
+		FORCEINLINE const std::string& GetPlayerAuthID() const noexcept
+		{
+			return PlayerAuthID;
+		}
+
+		/** \brief When the GET times out if it has no response. */
+		FORCEINLINE std::chrono::steady_clock::time_point GetDeadline() const noexcept
+		{
+			return Deadline;
+		}
+
+		/** \brief How the result is handed to gameplay code. */
+		FORCEINLINE ECompletionDelivery GetDelivery() const noexcept
+		{
+			return Delivery;
+		}
+		
+	private:
+		const FRequestID RequestID;
+		const std::string PlayerAuthID;
+		const std::chrono::steady_clock::time_point Deadline;
+		const ECompletionDelivery Delivery;
+		std::atomic<bool> bClaimed;
+		std::atomic<uint8_t> Flags;
+		FAsyncGetResult Result;
+		std::function<void()> Continuation;
+	};
+
+	/**
+	 * \brief Handle to the result of @link IPCFileManager::UE_GetAsync. Nothing
+	 * about it blocks, poll @link IsReady, attach a callback with @link Then,
+	 * or co_await it from a C++20 coroutine.
+	 */
+	class FGetFuture
+	{
+	public:
+		FGetFuture() = default;
+		explicit FGetFuture(std::shared_ptr<FAsyncGetState> InState)
+			: State(std::move(InState))
+		{
+		}
+
+		/** \brief Whether this handle refers to a GET, a default constructed one does not. */
+		FORCEINLINE bool IsValid() const noexcept
+		{
+			return State != nullptr;
+		}
+
+		/** \brief Whether the GET has completed, so @link GetResult will not wait. */
+		FORCEINLINE bool IsReady() const noexcept
+		{
+			return State && State->IsComplete();
+		}
+
+		/**
+		 * \brief @link EAsyncGetStatus::PENDING until the GET completes.
+		 */
+		FORCEINLINE EAsyncGetStatus GetStatus() const noexcept
+		{
+			return IsReady() ? State->GetResult().Status : EAsyncGetStatus::PENDING;
+		}
+
+		/**
+		 * \brief Only valid once @link IsReady is true.
+		 */
+		FORCEINLINE const FAsyncGetResult& GetResult() const noexcept
+		{
+			return State->GetResult();
+		}
+
+		/** \brief The ID of the GET, 0 for an invalid handle. */
+		FORCEINLINE FRequestID GetRequestID() const noexcept
+		{
+			return State ? State->GetRequestID() : 0;
+		}
+
+		/**
+		 * \brief Call Callback(const FAsyncGetResult&) once the GET completes. It
+		 * runs on the thread that consumes the response, or straight away if the
+		 * GET has already completed. Only one callback can be attached.
+		 */
+		template<typename TCallback>
+		FORCEINLINE void Then(TCallback&& Callback) const
+		{
+			if(!State)
+			{
+				return;
+			}
+			std::shared_ptr<FAsyncGetState> Captured = State;
+			std::function<void()> Continuation =
+				[Captured, Callback = std::forward<TCallback>(Callback)]() mutable
+				{
+					Callback(Captured->GetResult());
+				};
+			if(!State->SetContinuation(Continuation))
+			{
+				Continuation();
+			}
+		}
+
+#if IPC_HAS_COROUTINES
+		/**
+		 * \brief Awaiter so a coroutine can co_await the future, the coroutine
+		 * is resumed on the thread that completes the GET.
+		 */
+		struct FAwaiter
+		{
+			std::shared_ptr<FAsyncGetState> State;
+
+			bool await_ready() const noexcept
+			{
+				return State->IsComplete();
+			}
+
+			bool await_suspend(const std::coroutine_handle<> Handle)
+			{
+				return State->SetContinuation([Handle]() { Handle.resume(); });
+			}
+
+			FAsyncGetResult await_resume() const
+			{
+				return State->GetResult();
+			}
+		};
+
+		FAwaiter operator co_await() const noexcept
+		{
+			return FAwaiter{State};
+		}
+#endif
+		
+	private:
+		std::shared_ptr<FAsyncGetState> State;
+	};
+	
+	/*
+	 * IPCFileManager main static class
+	 */
+	class IPC_ALIGN_TO_CACHE_LINE IPCFileManager final
+	{
+		/** The tick rate for threads on the UE side to use */
+		static constexpr int UE_BufferTickRateMS = 1000 / UE_BUFFER_TICK_RATE;
+		/** The tick rate for threads on the AWS side to use */
+		static constexpr int AWS_BufferTickRateMS = 1000 / AWS_BUFFER_TICK_RATE;
+		
+		/**
+		 * \brief Used to identify which platform a @link FRequestBuffer will be used on.
+		 */
+		enum class ERequestBufferType : uint8_t
+		{
+			UE,
+			AWS,
+			BOTH
+		};
+
+		/**
+ * \brief A basic Spin-lock implementation
+ * \tparam bShouldUseSleep Should this SpinLoop use a sleep or not?
+ */
+		template<bool bShouldUseSleep = true>
+		struct FSpinLoop
+		{
+			FSpinLoop()
+				: Flag{false}
+			{
+			}
+			
+			/**
+			 * \brief Run a Lambda functor through the lock
+			 * \param LambdaFunctor The functor to run
+			 */
+			template<typename TFunctor>
+			FORCEINLINE void RunLambdaThroughLock(const TFunctor& LambdaFunctor)
+			{
+				Lock();
+				LambdaFunctor();
+				Unlock();
+			}
+			
+			/*
+			 * TODO
+			 */
+			FORCEINLINE void Lock() noexcept
+			{
+				for(;;)
+				{
+					if(!Flag.exchange(true, std::memory_order_acquire))
+					{
+						return;
+					}
+
+					while(Flag.load(std::memory_order_relaxed))
+					{
+						if(bShouldUseSleep)
+						{
+							std::this_thread::sleep_for(
+								std::chrono::milliseconds(
+									SPIN_LOOP_SLEEP_TIME_MS));
+						}
+						else
+						{
+							SPIN_LOOP_PAUSE();
+						}
+					}
+				}
+			}
+
+			/*
+			 * TODO
+			 */
+			FORCEINLINE bool TryLock() noexcept
+			{
+				return !Flag.load(std::memory_order_relaxed) &&
+					!Flag.exchange(true, std::memory_order_acquire);
+			}
+
+			/*
+			 * TODO
+			 */
+			FORCEINLINE void Unlock()
+			{
+				Flag.store(false, std::memory_order_release);
+			}
+
+		private:
+			std::atomic<bool> Flag;
+		};
+
+		/**
+		 * \brief Lets a producer wake a sleeping buffer thread straight away,
+		 * using a futex on Linux and WaitOnAddress on Windows.
+		 */
+		class FWakeEvent
+		{
+			static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+				std::atomic<uint32_t>::is_always_lock_free,
+				"The sequence must be a plain 32 bit word to wait on it");
+			
+		public:
+			FWakeEvent()
+				: Sequence{0},
+				NumberOfWaiters{0}
+			{
+			}
+
+			/**
+			 * \brief Read before checking for work, then pass to @link WaitFor so a
+			 * notify that lands in between is never missed.
+			 */
+			FORCEINLINE uint32_t Snapshot() const noexcept
+			{
+				return Sequence.load(std::memory_order_acquire);
+			}
+
+			/**
+			 * \brief Wake the waiting thread, cheap when no one is waiting.
+			 */
+			FORCEINLINE void Notify() noexcept
+			{
+				Sequence.fetch_add(1, std::memory_order_acq_rel);
+				if(NumberOfWaiters.load(std::memory_order_acquire) == 0)
+				{
+					return;
+				}
+#if defined(_WIN64) || defined(_WIN32)
+				WakeByAddressAll(GetAddress());
+#else
+				syscall(SYS_futex, GetAddress(), FUTEX_WAKE_PRIVATE, INT32_MAX,
+					nullptr, nullptr, 0);
+#endif
+			}
+
+			/** \brief Pass to @link WaitFor to wait for a notify however long it takes. */
+			static constexpr uint32_t NoTimeout = UINT32_MAX;
+
+			/**
+			 * \brief Sleep until notified after SeenSequence was read, or the timeout passes.
+			 */
+			FORCEINLINE void WaitFor(const uint32_t SeenSequence, const uint32_t TimeoutMS) noexcept
+			{
+				NumberOfWaiters.fetch_add(1, std::memory_order_acq_rel);
+				if(Sequence.load(std::memory_order_acquire) == SeenSequence)
+				{
+#if defined(_WIN64) || defined(_WIN32)
+					uint32_t Expected = SeenSequence;
+					WaitOnAddress(GetAddress(), &Expected, sizeof(Expected), TimeoutMS);
+#else
+					timespec Timeout;
+					Timeout.tv_sec = TimeoutMS / 1000;
+					Timeout.tv_nsec = static_cast<long>(TimeoutMS % 1000) * 1000000;
+					syscall(SYS_futex, GetAddress(), FUTEX_WAIT_PRIVATE, SeenSequence,
+						TimeoutMS == NoTimeout ? nullptr : &Timeout, nullptr, 0);
+#endif
+				}
+				NumberOfWaiters.fetch_sub(1, std::memory_order_acq_rel);
+			}
+
+		private:
+			FORCEINLINE uint32_t* GetAddress() noexcept
+			{
+				return reinterpret_cast<uint32_t*>(&Sequence);
+			}
+			
+			std::atomic<uint32_t> Sequence;
+			std::atomic<uint32_t> NumberOfWaiters;
+		};
+
+		/**
+		 * \brief Tracks what is in a buffer against its @link FFlushTriggerConfig,
+		 * and wakes the buffer's write thread when a producer crosses a threshold.
+		 */
+		class FFlushTriggerState
+		{
+		public:
+			FFlushTriggerState()
+				: NumberOfBytes{0},
+				OldestPushNs{0},
+				EarliestDeadlineNs{INT64_MAX},
+				bWakeSent{false},
+				bWakePending{false},
+				WakeEvent{nullptr}
+			{
+			}
+
+			/** \brief Set the count, size and age limits that make the buffer due for a flush. */
+			FORCEINLINE void Configure(const FFlushTriggerConfig& InConfig)
+			{
+				MaxCount.store(InConfig.MaxCount, std::memory_order_relaxed);
+				MaxBytes.store(InConfig.MaxBytes, std::memory_order_relaxed);
+				MaxAgeNs.store(static_cast<int64_t>(InConfig.MaxAgeMS) * 1000000,
+					std::memory_order_relaxed);
+			}
+
+			/**
+			 * \brief Set the event of the thread that flushes this buffer.
+			 */
+			FORCEINLINE void SetWakeEvent(FWakeEvent* InWakeEvent) noexcept
+			{
+				WakeEvent.store(InWakeEvent, std::memory_order_release);
+			}
+
+			/**
+			 * \brief Account for a record that was just added, must be called with the buffer lock held.
+			 * \param NewCount The number of records in the buffer, including this one.
+			 * \param RecordBytes Roughly how many bytes the record adds to the file.
+			 * \param DeadlineNs The record's flush deadline, 0 for none.
+			 */
+			FORCEINLINE void OnPushUnlocked(
+				const size_t NewCount,
+				const size_t RecordBytes,
+				const int64_t DeadlineNs) noexcept
+			{
+				if(OldestPushNs.load(std::memory_order_relaxed) == 0)
+				{
+					OldestPushNs.store(GetNowNs(), std::memory_order_release);
+					// The thread went to sleep on an empty buffer, so it needs to
+					// start counting down the age limit
+					if(MaxAgeNs.load(std::memory_order_relaxed) != 0)
+					{
+						bWakePending.store(true, std::memory_order_relaxed);
+					}
+				}
+				const size_t Bytes = NumberOfBytes.load(std::memory_order_relaxed) + RecordBytes;
+				NumberOfBytes.store(Bytes, std::memory_order_release);
+
+				if(DeadlineNs != 0 && DeadlineNs < EarliestDeadlineNs.load(std::memory_order_relaxed))
+				{
+					// The thread has to work out again how long it sleeps for
+					EarliestDeadlineNs.store(DeadlineNs, std::memory_order_release);
+					bWakePending.store(true, std::memory_order_relaxed);
+				}
+				const size_t CountLimit = MaxCount.load(std::memory_order_relaxed);
+				const size_t BytesLimit = MaxBytes.load(std::memory_order_relaxed);
+				if(!bWakeSent && ((CountLimit != 0 && NewCount >= CountLimit) ||
+					(BytesLimit != 0 && Bytes >= BytesLimit)))
+				{
+					// Only once per fill, the thread is already on its way after that
+					bWakeSent = true;
+					bWakePending.store(true, std::memory_order_relaxed);
+				}
+			}
+
+			/**
+			 * \brief Wake the write thread if the last push asked for it, call after
+			 * the buffer lock is released so the thread doesn't wake into a held lock.
+			 */
+			FORCEINLINE void WakeIfPending() noexcept
+			{
+				if(!bWakePending.load(std::memory_order_relaxed) ||
+					!bWakePending.exchange(false, std::memory_order_acq_rel))
+				{
+					return;
+				}
+				FWakeEvent* Event = WakeEvent.load(std::memory_order_acquire);
+				if(Event)
+				{
+					Event->Notify();
+				}
+			}
+
+			/**
+			 * \brief Forget everything tracked, must be called with the buffer lock held.
+			 */
+			FORCEINLINE void OnClearUnlocked() noexcept
+			{
+				NumberOfBytes.store(0, std::memory_order_release);
+				OldestPushNs.store(0, std::memory_order_release);
+				EarliestDeadlineNs.store(INT64_MAX, std::memory_order_release);
+				bWakeSent = false;
+			}
+
+			/**
+			 * \brief How long the write thread can sleep before this buffer is due.
+			 * \param Count The number of records in the buffer.
+			 * \param MaxWaitMS The longest the thread sleeps for regardless.
+			 * \return 0 if the buffer should be flushed now.
+			 */
+			FORCEINLINE uint32_t GetWaitMS(const size_t Count, const uint32_t MaxWaitMS) const noexcept
+			{
+				if(Count == 0)
+				{
+					return MaxWaitMS;
+				}
+				const size_t CountLimit = MaxCount.load(std::memory_order_relaxed);
+				const size_t BytesLimit = MaxBytes.load(std::memory_order_relaxed);
+				if((CountLimit != 0 && Count >= CountLimit) ||
+					(BytesLimit != 0 && NumberOfBytes.load(std::memory_order_acquire) >= BytesLimit))
+				{
+					return 0;
+				}
+				
+				const int64_t Now = GetNowNs();
+				int64_t DueNs = EarliestDeadlineNs.load(std::memory_order_acquire);
+				const int64_t AgeLimit = MaxAgeNs.load(std::memory_order_relaxed);
+				const int64_t Oldest = OldestPushNs.load(std::memory_order_acquire);
+				if(AgeLimit != 0 && Oldest != 0)
+				{
+					DueNs = (std::min)(DueNs, Oldest + AgeLimit);
+				}
+				if(DueNs <= Now)
+				{
+					return 0;
+				}
+				const int64_t WaitMS = (DueNs - Now + 999999) / 1000000;
+				return static_cast<uint32_t>((std::min)(WaitMS, static_cast<int64_t>(MaxWaitMS)));
+			}
+
+			/**
+			 * \brief Roughly how many bytes a request adds to the file it is written to.
+			 */
+			static FORCEINLINE size_t ApproximateRecordSize(const FGetRequest& InRequest) noexcept
+			{
+				return InRequest.GetPlayerAuthIDString().size() + InRequest.Size() * 2 + 24;
+			}
+
+			/** \brief A rough record size for the byte trigger, without serializing the request. */
+			static FORCEINLINE size_t ApproximateRecordSize(const FSetRequest& InRequest) noexcept
+			{
+				return InRequest.GetPlayerAuthIDString().size() +
+					InRequest.GetPlayerAttributeList().GetPlayerName().Value.size() + 32;
+			}
+
+			/** \brief Monotonic time in nanoseconds, the clock every trigger age uses. */
+			static FORCEINLINE int64_t GetNowNs() noexcept
+			{
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+
+		private:
+			std::atomic<size_t> MaxCount{0};
+			std::atomic<size_t> MaxBytes{0};
+			std::atomic<int64_t> MaxAgeNs{0};
+			std::atomic<size_t> NumberOfBytes;
+			std::atomic<int64_t> OldestPushNs;
+			std::atomic<int64_t> EarliestDeadlineNs;
+			bool bWakeSent;
+			std::atomic<bool> bWakePending;
+			std::atomic<FWakeEvent*> WakeEvent;
+		};
+		
+		/**
+		 * \brief Pool of recycled objects, used so that steady state batching
+		 * never goes back to the allocator. T must have a Reset function.
+		 * \tparam T The type of object being pooled.
+		 */
+		template<typename T>
+		class TSlabPool
+		{
+		public:
+			TSlabPool() = default;
+
+			/**
+			 * \param InMaxFreeObjects Objects released while the pool already
+			 * holds this many are freed, so a burst does not stay allocated.
+			 */
+			explicit TSlabPool(const size_t InMaxFreeObjects)
+				: MaxFreeObjects(InMaxFreeObjects)
+			{
+			}
+
+			/**
+			 * \brief Take an object out of the pool, only allocating if it is empty.
+			 */
+			FORCEINLINE std::unique_ptr<T> Acquire()
+			{
+				PoolLock.Lock();
+				if(FreeList.empty())
+				{
+					PoolLock.Unlock();
+					return std::make_unique<T>();
+				}
+				std::unique_ptr<T> Object = std::move(FreeList.back());
+				FreeList.pop_back();
+				PoolLock.Unlock();
+				return Object;
+			}
+
+			/**
+			 * \brief Reset an object and put it back in the pool, or free it if
+			 * the pool is full.
+			 */
+			FORCEINLINE void Release(std::unique_ptr<T>&& Object)
+			{
+				if(!Object)
+				{
+					return;
+				}
+				Object->Reset();
+				PoolLock.Lock();
+				if(FreeList.size() < MaxFreeObjects)
+				{
+					FreeList.push_back(std::move(Object));
+				}
+				PoolLock.Unlock();
+				// A full pool leaves Object to be freed here, outside the lock
+				Object.reset();
+			}
+
+		private:
+			FSpinLoop<false> PoolLock;
+			std::vector<std::unique_ptr<T>> FreeList;
+			size_t MaxFreeObjects = (std::numeric_limits<size_t>::max)();
+		};
+
+		/**
+		 * \brief Sequence of elements stored in fixed size chunks, which are
+		 * taken from and given back to a free list shared by every buffer of the
+		 * same element type. Growing never moves the elements already stored,
+		 * and nothing is allocated until the first element is added. The first
+		 * element sits at a head offset into the first chunk, so removing from
+		 * the front moves nothing, and chunks emptied that way are recycled to
+		 * the back.
+		 * \tparam T The element type.
+		 */
+		template<typename T>
+		class TChunkedBuffer
+		{
+		public:
+			/** A power of two, so an index splits into chunk and slot with a shift */
+			static constexpr size_t ElementsPerChunk = []()
+			{
+				size_t Elements = 1;
+				while(Elements * 2 * sizeof(T) <= REQUEST_BUFFER_CHUNK_BYTES)
+				{
+					Elements *= 2;
+				}
+				return Elements;
+			}();
+
+		private:
+			struct FChunk
+			{
+				// Left uninitialized, elements are constructed in place as they are added
+				FChunk() {}
+				FORCEINLINE void Reset() noexcept {}
+				alignas(T) unsigned char Storage[sizeof(T) * ElementsPerChunk];
+			};
+
+			template<typename TElement, typename TOwner>
+			class TIterator
+			{
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = T;
+				using difference_type = std::ptrdiff_t;
+				using pointer = TElement*;
+				using reference = TElement&;
+
+				TIterator(TOwner* InOwner, const size_t InIndex) noexcept
+					: Owner(InOwner),
+					Index(InIndex)
+				{
+				}
+
+				FORCEINLINE reference operator*() const noexcept { return (*Owner)[Index]; }
+				FORCEINLINE pointer operator->() const noexcept { return &(*Owner)[Index]; }
+				FORCEINLINE TIterator& operator++() noexcept { ++Index; return *this; }
+				FORCEINLINE bool operator==(const TIterator& Other) const noexcept { return Index == Other.Index; }
+				FORCEINLINE bool operator!=(const TIterator& Other) const noexcept { return Index != Other.Index; }
+
+			private:
+				TOwner* Owner;
+				size_t Index;
+			};
+
+		public:
+			using FIterator = TIterator<T, TChunkedBuffer>;
+			using FConstIterator = TIterator<const T, const TChunkedBuffer>;
+
+			TChunkedBuffer() = default;
+			TChunkedBuffer(const TChunkedBuffer&) = delete;
+			TChunkedBuffer& operator=(const TChunkedBuffer&) = delete;
+
+			~TChunkedBuffer()
+			{
+				Clear();
+			}
+
+			FORCEINLINE T& operator[](const size_t Index) noexcept
+			{
+				return *Slot(Index);
+			}
+
+			FORCEINLINE const T& operator[](const size_t Index) const noexcept
+			{
+				return *const_cast<TChunkedBuffer*>(this)->Slot(Index);
+			}
+
+			/** \brief The last element, the buffer must not be empty. */
+			FORCEINLINE T& Back() noexcept
+			{
+				return (*this)[NumberOfElements - 1];
+			}
+
+			/** \brief Copy an element in after the last one. */
+			FORCEINLINE void PushBack(const T& InElement)
+			{
+				EmplaceBack(InElement);
+			}
+
+			/** \brief Move an element in after the last one. */
+			FORCEINLINE void PushBack(T&& InElement)
+			{
+				EmplaceBack(std::move(InElement));
+			}
+
+			/**
+			 * \brief Construct an element after the last one, taking a chunk
+			 * from the free list if the last chunk is full.
+			 */
+			template<typename... TArgs>
+			FORCEINLINE void EmplaceBack(TArgs&&... Args)
+			{
+				if(Head + NumberOfElements == Chunks.size() * ElementsPerChunk)
+				{
+					Chunks.push_back(GetChunkPool().Acquire());
+				}
+				new(Slot(NumberOfElements)) T(std::forward<TArgs>(Args)...);
+				++NumberOfElements;
+			}
+
+			/**
+			 * \brief Destroy the last element. One empty chunk is kept, so a
+			 * buffer going back and forth over a chunk boundary does not take
+			 * from and give back to the free list every time.
+			 */
+			FORCEINLINE void PopBack() noexcept
+			{
+				--NumberOfElements;
+				Slot(NumberOfElements)->~T();
+				if(NumberOfElements == 0)
+				{
+					Head = 0;
+				}
+				ReleaseUnusedChunks(1);
+			}
+
+			/**
+			 * \brief Remove the element at Index, moving whichever side of it is
+			 * shorter into the gap.
+			 */
+			FORCEINLINE void RemoveAt(const size_t Index)
+			{
+				if(Index < NumberOfElements / 2)
+				{
+					for(size_t i = Index; i > 0; --i)
+					{
+						(*this)[i] = std::move((*this)[i - 1]);
+					}
+					RemoveFront(1);
+					return;
+				}
+				for(size_t i = Index + 1; i < NumberOfElements; ++i)
+				{
+					(*this)[i - 1] = std::move((*this)[i]);
+				}
+				PopBack();
+			}
+
+			/**
+			 * \brief Remove the first Count elements by advancing the head, the
+			 * rest stay where they are. Chunks the head leaves behind go round
+			 * to the back to be filled again.
+			 */
+			FORCEINLINE void RemoveFront(const size_t Count)
+			{
+				if constexpr(!std::is_trivially_destructible_v<T>)
+				{
+					for(size_t i = 0; i < Count; ++i)
+					{
+						Slot(i)->~T();
+					}
+				}
+				NumberOfElements -= Count;
+				Head = (NumberOfElements == 0) ? (0) : (Head + Count);
+				if(Head >= ElementsPerChunk)
+				{
+					const size_t EmptiedChunks = Head / ElementsPerChunk;
+					std::rotate(Chunks.begin(), Chunks.begin() + EmptiedChunks, Chunks.end());
+					Head %= ElementsPerChunk;
+				}
+				ReleaseUnusedChunks(1);
+			}
+
+			/**
+			 * \brief Destroy every element and give every chunk back to the free list.
+			 */
+			FORCEINLINE void Clear() noexcept
+			{
+				if constexpr(!std::is_trivially_destructible_v<T>)
+				{
+					for(size_t i = 0; i < NumberOfElements; ++i)
+					{
+						Slot(i)->~T();
+					}
+				}
+				NumberOfElements = 0;
+				Head = 0;
+				ReleaseUnusedChunks(0);
+			}
+
+			/** \brief The number of elements in the buffer. */
+			FORCEINLINE size_t Size() const noexcept
+			{
+				return NumberOfElements;
+			}
+
+			/** \brief Whether the buffer holds no elements. */
+			FORCEINLINE bool IsEmpty() const noexcept
+			{
+				return NumberOfElements == 0;
+			}
+
+			FORCEINLINE FIterator begin() noexcept { return FIterator(this, 0); }
+			FORCEINLINE FIterator end() noexcept { return FIterator(this, NumberOfElements); }
+			FORCEINLINE FConstIterator begin() const noexcept { return FConstIterator(this, 0); }
+			FORCEINLINE FConstIterator end() const noexcept { return FConstIterator(this, NumberOfElements); }
+
+		private:
+			FORCEINLINE T* Slot(const size_t Index) noexcept
+			{
+				const size_t Position = Head + Index;
+				return reinterpret_cast<T*>(Chunks[Position / ElementsPerChunk]->Storage) +
+					(Position % ElementsPerChunk);
+			}
+
+			/**
+			 * \brief Give back the chunks past the last element.
+			 * \param SpareChunks How many empty chunks to keep.
+			 */
+			FORCEINLINE void ReleaseUnusedChunks(const size_t SpareChunks) noexcept
+			{
+				const size_t ChunksInUse = (Head + NumberOfElements + ElementsPerChunk - 1) / ElementsPerChunk;
+				while(Chunks.size() > ChunksInUse + SpareChunks)
+				{
+					GetChunkPool().Release(std::move(Chunks.back()));
+					Chunks.pop_back();
+				}
+			}
+
+			/**
+			 * \brief The free list, never destroyed, so buffers that are torn
+			 * down at exit after it would have been can still give chunks back.
+			 * It holds at most @link REQUEST_BUFFER_MAX_FREE_CHUNKS, the chunks
+			 * a drained burst gives back past that are freed.
+			 */
+			static FORCEINLINE TSlabPool<FChunk>& GetChunkPool()
+			{
+				static TSlabPool<FChunk>* Pool = new TSlabPool<FChunk>(REQUEST_BUFFER_MAX_FREE_CHUNKS);
+				return *Pool;
+			}
+			
+			std::vector<std::unique_ptr<FChunk>> Chunks;
+			/** Where the first element sits in the first chunk */
+			size_t Head = 0;
+			size_t NumberOfElements = 0;
+		};
+		
+		/**
+		 * \brief Sleep briefly while a push blocked by @link EBackpressurePolicy::BLOCK
+		 * waits for room, shared by every buffer type.
+		 * \return Fails once the block timeout has passed.
+		 */
+		static FORCEINLINE bool WaitForBufferRoom(
+			std::chrono::steady_clock::time_point& Deadline,
+			bool& bHasDeadline,
+			const uint32_t BlockTimeoutMS)
+		{
+			if(!bHasDeadline)
+			{
+				Deadline = std::chrono::steady_clock::now() +
+					std::chrono::milliseconds(BlockTimeoutMS);
+				bHasDeadline = true;
+			}
+			if(std::chrono::steady_clock::now() >= Deadline)
+			{
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			return true;
+		}
+		
+		/**
+		 * \brief Base type used for the @link FGetRequest and @link FSetRequest buffer types.
+		 * The buffer never holds more than its configured capacity, see
+		 * @link FBufferCapacityConfig for what happens to a push once it is full.
+		 * \tparam T The type of data that will be stored in the buffer.
+		 * \tparam TBufferPlatform The platform (UE/AWS) that this buffer is being used for.
+		 */
+		template<typename T, ERequestBufferType TBufferPlatform>
+		class IPC_ALIGN_TO_CACHE_LINE FRequestBuffer
+		{
+		public:
+			static constexpr ERequestBufferType Platform = TBufferPlatform;
+
+		private:
+			/**
+			 * \brief The outcome of one attempt to push while holding the lock.
+			 */
+			enum class EPushAttempt : uint8_t
+			{
+				PUSHED,
+				REJECTED,
+				WAIT,
+				SPILL
+			};
+			
+		public:
+			FRequestBuffer()
+				: BufferSize{0},
+				bAboveHighWatermark{false},
+				HighWatermark{0},
+				LowWatermark{0},
+				NumberRejected{0},
+				NumberDropped{0},
+				NumberSpilled{0}
+			{
+				CapacityConfig.Capacity = (TBufferPlatform == ERequestBufferType::UE) ?
+					(UE_BUFFER_CAPACITY) : (AWS_BUFFER_CAPACITY);
+			}
+			
+			/**
+			 * \brief Initialize this buffer
+			 */
+			virtual FORCEINLINE void Initialize()
+			{
+				FRequestBuffer();
+			}
+
+			/**
+			 * \brief Set the capacity, backpressure policy and watermarks of this buffer.
+			 * Elements already in the buffer are kept even if they are over the new capacity.
+			 */
+			virtual FORCEINLINE void Configure(const FBufferCapacityConfig& InConfig)
+			{
+				BufferLock.Lock();
+				CapacityConfig = InConfig;
+				if(CapacityConfig.Capacity == 0)
+				{
+					CapacityConfig.Capacity = 1;
+				}
+				HighWatermark.store((CapacityConfig.WatermarkCallback) ?
+					(CapacityConfig.HighWatermark) : (0), std::memory_order_relaxed);
+				LowWatermark.store(CapacityConfig.LowWatermark, std::memory_order_relaxed);
+				BufferLock.Unlock();
+			}
+
+			/**
+			 * \brief Set the priority written into the names of the files this buffer writes.
+			 */
+			FORCEINLINE void SetLanePriority(const ERequestPriority InPriority) noexcept
+			{
+				LanePriority = InPriority;
+			}
+
+			/** \brief The priority of the files this buffer is flushed to. */
+			FORCEINLINE ERequestPriority GetLanePriority() const noexcept
+			{
+				return LanePriority;
+			}
+
+			/**
+			 * \brief Set the count, size and age limits that make this buffer due for a flush.
+			 */
+			FORCEINLINE void ConfigureFlushTrigger(const FFlushTriggerConfig& InConfig)
+			{
+				FlushTrigger.Configure(InConfig);
+			}
+
+			/**
+			 * \brief Set the event of the thread that flushes this buffer, pushes
+			 * that make the buffer due wake it through this.
+			 */
+			FORCEINLINE void SetWakeEvent(FWakeEvent* InWakeEvent) noexcept
+			{
+				FlushTrigger.SetWakeEvent(InWakeEvent);
+			}
+
+			/**
+			 * \brief How long the write thread can sleep before this buffer is due.
+			 * \return 0 if the buffer should be flushed now.
+			 */
+			FORCEINLINE uint32_t GetFlushWaitMS(const uint32_t MaxWaitMS) const noexcept
+			{
+				return FlushTrigger.GetWaitMS(Size(), MaxWaitMS);
+			}
+
+			/**
+			 * \brief Write every element to a file in FileLocation and empty the buffer.
+			 * \return Fails if the buffer was empty, or has no file format, or the write failed.
+			 */
+			FORCEINLINE bool FlushToFileThroughLock(const std::string& FileLocation)
+			{
+				bool bFlushed = false;
+				BufferLock.RunLambdaThroughLock([&]()
+				{
+					bFlushed = !RequestBuffer.IsEmpty() && SpillUnlocked(FileLocation);
+				});
+				if(bFlushed)
+				{
+					UpdateWatermark(0);
+				}
+				return bFlushed;
+			}
+
+			/**
+			 * \brief Lock the buffer
+			 */
+			virtual FORCEINLINE void LockBuffer() noexcept
+			{
+				BufferLock.Lock();
+			}
+
+			/**
+			 * \brief Unlock the buffer
+			 */
+			virtual FORCEINLINE void UnlockBuffer() noexcept
+			{
+				BufferLock.Unlock();
+			}
+
+			/**
+			 * \brief Get a reference to the buffer
+			 */
+			virtual FORCEINLINE TChunkedBuffer<T>& GetBuffer()
+			{
+				return RequestBuffer;
+			}
+			
+			/**
+			 * \brief Pushes an element into the buffer, in a thread safe manner.
+			 * When the buffer is full the configured @link EBackpressurePolicy decides
+			 * whether this waits, fails, drops the oldest elements or spills the buffer to disk.
+			 * \param InRequest Element to push into the buffer.
+			 * \return Whether or not the element is now in the buffer.
+			 */
+			FORCEINLINE bool PushBack(const T& InRequest)
+			{
+				return PushBackInternal([&](TChunkedBuffer<T>& Buffer)
+				{
+					Buffer.PushBack(InRequest);
+				});
+			}
+
+			/**
+			 * \brief Moves an element into the buffer, see @link PushBack.
+			 * InRequest is only moved from if this returns true.
+			 */
+			FORCEINLINE bool PushBack(T&& InRequest)
+			{
+				return PushBackInternal([&](TChunkedBuffer<T>& Buffer)
+				{
+					Buffer.PushBack(std::move(InRequest));
+				});
+			}
+
+			/**
+			 * \brief Constructs an element directly in the buffer, see @link PushBack.
+			 * \param Args The arguments to construct the element with.
+			 */
+			template<typename... TArgs>
+			FORCEINLINE bool EmplaceBack(TArgs&&... Args)
+			{
+				return PushBackInternal([&](TChunkedBuffer<T>& Buffer)
+				{
+					Buffer.EmplaceBack(std::forward<TArgs>(Args)...);
+				});
+			}
+
+			/**
+			 * \brief Pushes a range of elements while taking the lock as few times as
+			 * possible. Each element is constructed from *First, so pass move
+			 * iterators to move them in. The backpressure policy is applied per element.
+			 * \return The number of elements from the front of the range that are now
+			 * in the buffer, the rest were rejected.
+			 */
+			template<typename TIterator>
+			FORCEINLINE size_t PushBackRange(TIterator First, const TIterator Last)
+			{
+				std::chrono::steady_clock::time_point Deadline;
+				bool bHasDeadline = false;
+				size_t NumberPushed = 0;
+				while(First != Last)
+				{
+					EPushAttempt Attempt = EPushAttempt::PUSHED;
+					BufferLock.Lock();
+					while(First != Last)
+					{
+						Attempt = TryPushBackUnlocked([&](TChunkedBuffer<T>& Buffer)
+						{
+							Buffer.EmplaceBack(*First);
+						});
+						if(Attempt == EPushAttempt::PUSHED)
+						{
+							++First;
+							++NumberPushed;
+						}
+						else if(Attempt != EPushAttempt::SPILL)
+						{
+							break;
+						}
+					}
+					const size_t NewSize = LiveSizeUnlocked();
+					const uint32_t BlockTimeoutMS = CapacityConfig.BlockTimeoutMS;
+					BufferSize.store(NewSize, std::memory_order_release);
+					BufferLock.Unlock();
+					FlushTrigger.WakeIfPending();
+					UpdateWatermark(NewSize);
+
+					if(First == Last)
+					{
+						break;
+					}
+					if(Attempt == EPushAttempt::WAIT && WaitForBufferRoom(
+						Deadline, bHasDeadline, BlockTimeoutMS))
+					{
+						continue;
+					}
+					for(; First != Last; ++First)
+					{
+						NumberRejected.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+				return NumberPushed;
+			}
+
+			virtual FORCEINLINE bool RemoveIndex(const uint32_t Index)
+			{
+				bool bRemoved = false;
+				BufferLock.RunLambdaThroughLock([&]()
+				{
+					if(Index < RequestBuffer.Size())
+					{
+						RequestBuffer.RemoveAt(Index);
+						++LayoutVersion;
+						BufferSize.store(LiveSizeUnlocked(), std::memory_order_release);
+						if(RequestBuffer.IsEmpty())
+						{
+							FlushTrigger.OnClearUnlocked();
+						}
+						bRemoved = true;
+					}
+				});
+				return bRemoved;
+			}
+			
+			/**
+			 * \brief Completely erase all elements from the buffer in a thread safe manner.
+			 */
+			virtual FORCEINLINE void Clear()
+			{
+				BufferLock.RunLambdaThroughLock([this]() -> void
+				{
+					ClearUnlocked();
+				});
+				UpdateWatermark(0);
+			}
+			
+			/**
+			 * \brief Checks if there are no elements in the buffer in a thread safe manner.
+			 * \return Whether or not the buffer is currently empty.
+			 */
+			virtual FORCEINLINE bool IsEmpty() const noexcept
+			{
+				return Size() == 0;
+			}
+			
+			/**
+			 * \brief Check how many elements are in the buffer in a thread safe manner. 
+			 * \return The amount of elements currently in the buffer.
+			 */
+			virtual FORCEINLINE size_t Size() const noexcept
+			{
+				return BufferSize.load(std::memory_order_acquire);
+			}
+
+			/**
+			 * \return How many pushes failed because the buffer was full.
+			 */
+			FORCEINLINE uint64_t GetNumberRejected() const noexcept
+			{
+				return NumberRejected.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * \return How many elements were dropped by @link EBackpressurePolicy::DROP_OLDEST.
+			 */
+			FORCEINLINE uint64_t GetNumberDropped() const noexcept
+			{
+				return NumberDropped.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * \return How many elements were written out by @link EBackpressurePolicy::SPILL_TO_DISK.
+			 */
+			FORCEINLINE uint64_t GetNumberSpilled() const noexcept
+			{
+				return NumberSpilled.load(std::memory_order_relaxed);
+			}
+			
+			/**
+			 * \brief Runs a given functor that will be protected by the @link FSpinLoop lock.
+			 * \param Lambda Lambda functor to be run through the lock.
+			 */
+			template<typename TFunctor>
+			FORCEINLINE void RunLambdaThroughLock(const TFunctor& Lambda)
+			{
+				BufferLock.RunLambdaThroughLock(Lambda);
+			}
+			
+		protected:
+			/**
+			 * \brief Write every element to a file in SpillDirectory and empty the
+			 * buffer. Called with the lock held. Buffers that have no file format
+			 * can't spill, so by default this fails and the push is rejected.
+			 */
+			virtual FORCEINLINE bool SpillUnlocked(const std::string& /*SpillDirectory*/)
+			{
+				return false;
+			}
+
+			/**
+			 * \brief Called with the lock held just before the oldest NumberToDrop
+			 * elements are dropped by @link EBackpressurePolicy::DROP_OLDEST.
+			 */
+			virtual FORCEINLINE void OnDropOldestUnlocked(const size_t /*NumberToDrop*/)
+			{
+			}
+
+			/**
+			 * \brief Squeeze out the tombstones, keeping the order of what is left.
+			 * Called with the lock held when the buffer is full and has any, only
+			 * buffers that leave tombstones need to do anything.
+			 */
+			virtual FORCEINLINE void CompactUnlocked()
+			{
+			}
+
+			/**
+			 * \brief The number of elements that count towards the size and
+			 * capacity, must be called with the lock held.
+			 */
+			FORCEINLINE size_t LiveSizeUnlocked() const noexcept
+			{
+				return RequestBuffer.Size() - NumberOfTombstones;
+			}
+
+			/**
+			 * \brief Empty the buffer, must be called with the lock held.
+			 */
+			FORCEINLINE void ClearUnlocked()
+			{
+				RequestBuffer.Clear();
+				NumberOfTombstones = 0;
+				++LayoutVersion;
+				BufferSize.store(0, std::memory_order_release);
+				FlushTrigger.OnClearUnlocked();
+			}
+
+		private:
+			/**
+			 * \brief Shared implementation of the single element pushes.
+			 * \param Emplace Appends the element to the vector it is given, it is
+			 * only called once there is room.
+			 */
+			template<typename TEmplace>
+			FORCEINLINE bool PushBackInternal(const TEmplace& Emplace)
+			{
+				std::chrono::steady_clock::time_point Deadline;
+				bool bHasDeadline = false;
+				for(;;)
+				{
+					BufferLock.Lock();
+					const EPushAttempt Attempt = TryPushBackUnlocked(Emplace);
+					const size_t NewSize = LiveSizeUnlocked();
+					const uint32_t BlockTimeoutMS = CapacityConfig.BlockTimeoutMS;
+					BufferSize.store(NewSize, std::memory_order_release);
+					BufferLock.Unlock();
+					FlushTrigger.WakeIfPending();
+
+					switch(Attempt)
+					{
+						case EPushAttempt::PUSHED:
+							UpdateWatermark(NewSize);
+							return true;
+						case EPushAttempt::SPILL:
+							UpdateWatermark(NewSize);
+							continue;
+						case EPushAttempt::WAIT:
+							if(WaitForBufferRoom(Deadline, bHasDeadline, BlockTimeoutMS))
+							{
+								continue;
+							}
+							break;
+						default:
+							break;
+					}
+					NumberRejected.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+			}
+
+			/**
+			 * \brief Try once to push an element, must be called with the lock held.
+			 */
+			template<typename TEmplace>
+			FORCEINLINE EPushAttempt TryPushBackUnlocked(const TEmplace& Emplace)
+			{
+				if(LiveSizeUnlocked() >= CapacityConfig.Capacity)
+				{
+					if(NumberOfTombstones != 0)
+					{
+						CompactUnlocked();
+					}
+					switch(CapacityConfig.Policy)
+					{
+						case EBackpressurePolicy::BLOCK:
+							return EPushAttempt::WAIT;
+						case EBackpressurePolicy::DROP_OLDEST:
+							DropOldestUnlocked();
+							break;
+						case EBackpressurePolicy::SPILL_TO_DISK:
+						{
+							const size_t NumberToSpill = RequestBuffer.Size();
+							if(CapacityConfig.SpillDirectory.empty() ||
+								!SpillUnlocked(CapacityConfig.SpillDirectory))
+							{
+								return EPushAttempt::REJECTED;
+							}
+							NumberSpilled.fetch_add(NumberToSpill, std::memory_order_relaxed);
+							return EPushAttempt::SPILL;
+						}
+						case EBackpressurePolicy::REJECT:
+						default:
+							return EPushAttempt::REJECTED;
+					}
+				}
+				
+				Emplace(RequestBuffer);
+				FlushTrigger.OnPushUnlocked(RequestBuffer.Size(),
+					FFlushTriggerState::ApproximateRecordSize(RequestBuffer.Back()),
+					RequestBuffer.Back().GetFlushDeadlineNs());
+				return EPushAttempt::PUSHED;
+			}
+
+			/**
+			 * \brief Drop the oldest sixteenth of the buffer, so a full buffer
+			 * makes room for many pushes at once.
+			 */
+			FORCEINLINE void DropOldestUnlocked()
+			{
+				const size_t NumberToDrop = (std::max)(
+					RequestBuffer.Size() / 16, static_cast<size_t>(1));
+				OnDropOldestUnlocked(NumberToDrop);
+				RequestBuffer.RemoveFront(NumberToDrop);
+				++LayoutVersion;
+				NumberDropped.fetch_add(NumberToDrop, std::memory_order_relaxed);
+			}
+
+		protected:
+			/**
+			 * \brief Fire the watermark callback if the size has crossed the high
+			 * watermark on the way up or the low watermark on the way down.
+			 */
+			FORCEINLINE void UpdateWatermark(const size_t NewSize)
+			{
+				const size_t High = HighWatermark.load(std::memory_order_relaxed);
+				if(High == 0)
+				{
+					return;
+				}
+				
+				bool bWasAbove = bAboveHighWatermark.load(std::memory_order_relaxed);
+				if(!bWasAbove && NewSize >= High)
+				{
+					if(bAboveHighWatermark.compare_exchange_strong(
+						bWasAbove, true, std::memory_order_acq_rel))
+					{
+						FireWatermark(EWatermarkEvent::HIGH, NewSize);
+					}
+				}
+				else if(bWasAbove && NewSize <= LowWatermark.load(std::memory_order_relaxed))
+				{
+					if(bAboveHighWatermark.compare_exchange_strong(
+						bWasAbove, false, std::memory_order_acq_rel))
+					{
+						FireWatermark(EWatermarkEvent::LOW, NewSize);
+					}
+				}
+			}
+
+			/**
+			 * \brief Call the watermark callback with a copy taken under the lock,
+			 * so a concurrent @link Configure can't replace it mid call.
+			 */
+			FORCEINLINE void FireWatermark(const EWatermarkEvent Event, const size_t NewSize)
+			{
+				std::function<void(EWatermarkEvent, size_t)> Callback;
+				BufferLock.Lock();
+				Callback = CapacityConfig.WatermarkCallback;
+				BufferLock.Unlock();
+				if(Callback)
+				{
+					Callback(Event, NewSize);
+				}
+			}
+			
+			std::atomic<uint64_t> BufferSize;
+			std::atomic<bool> bAboveHighWatermark;
+			/** Copies of the configured watermarks, 0 when there is no callback */
+			std::atomic<size_t> HighWatermark;
+			std::atomic<size_t> LowWatermark;
+			std::atomic<uint64_t> NumberRejected;
+			std::atomic<uint64_t> NumberDropped;
+			std::atomic<uint64_t> NumberSpilled;
+			ERequestPriority LanePriority = ERequestPriority::NORMAL;
+
+			FBufferCapacityConfig CapacityConfig;
+			FFlushTriggerState FlushTrigger;
+			FSpinLoop<true> BufferLock;
+			mutable TChunkedBuffer<T> RequestBuffer;
+			/** Bumped, under the lock, whenever elements are removed other than from the back */
+			uint64_t LayoutVersion = 0;
+			/** Elements emptied in place by a subclass, still stored but not counted */
+			size_t NumberOfTombstones = 0;
+		};
+		
+		/**
+		 * \brief A buffer used to store all pending @link FGetRequest while they wait to be written to a file.
+		 * \tparam TBufferPlatform The platform (UE/AWS) that this buffer is being used for.
+		 */
+		template<ERequestBufferType TBufferPlatform>
+		class IPC_ALIGN_TO_CACHE_LINE FGetRequestBuffer final
+			: public FRequestBuffer<FGetRequest, TBufferPlatform>
+		{
+		public:
+			FGetRequestBuffer()
+				: FRequestBuffer<FGetRequest, TBufferPlatform>(),
+				bHasDroppedRequestIDs{false}
+			{
+			}
+
+			/**
+			 * \brief Initialize this buffer
+			 */
+			virtual FORCEINLINE void Initialize() override
+			{
+				FGetRequestBuffer();
+			}
+
+			/**
+			 * \brief Move out the request IDs of the GETs dropped by
+			 * @link EBackpressurePolicy::DROP_OLDEST since the last call, so the
+			 * caller can stop waiting for their responses.
+			 * \return Fails without taking the lock if nothing was dropped.
+			 */
+			FORCEINLINE bool TakeDroppedRequestIDs(std::vector<FRequestID>& OutRequestIDs)
+			{
+				if(!bHasDroppedRequestIDs.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+				this->RunLambdaThroughLock([&]()
+				{
+					OutRequestIDs.swap(DroppedRequestIDs);
+					DroppedRequestIDs.clear();
+					bHasDroppedRequestIDs.store(false, std::memory_order_release);
+				});
+				return !OutRequestIDs.empty();
+			}
+			
+			/**
+			 * \brief Write all the current @link FGetRequest in this buffer to a specified file location.
+			 * \param FileLocation The directory to write the file to.
+			 */
+			FORCEINLINE void WriteGetRequestsToFileThroughLock(
+				const std::string& FileLocation)
+			{
+				this->RunLambdaThroughLock([&]()
+				{
+					WriteGetRequestsToFile(FileLocation);
+				});
+			}
+
+		protected:
+			/**
+			 * \brief Remember the request IDs of the GETs about to be dropped. Only
+			 * UE GETs are waited on, so the AWS side keeps nothing.
+			 */
+			virtual FORCEINLINE void OnDropOldestUnlocked(const size_t NumberToDrop) override
+			{
+				if constexpr(TBufferPlatform == ERequestBufferType::UE)
+				{
+					for(size_t i = 0; i < NumberToDrop; ++i)
+					{
+						const FRequestID RequestID = this->RequestBuffer[i].GetRequestID();
+						if(RequestID != RequestIDStatics::None)
+						{
+							DroppedRequestIDs.push_back(RequestID);
+						}
+					}
+					bHasDroppedRequestIDs.store(!DroppedRequestIDs.empty(), std::memory_order_release);
+				}
+			}
+
+			/**
+			 * \brief Write every @link FGetRequest to SpillDirectory and empty the buffer.
+			 */
+			virtual FORCEINLINE bool SpillUnlocked(
+				const std::string& SpillDirectory) override
+			{
+				if(!WriteGetRequestsToFile(SpillDirectory))
+				{
+					return false;
+				}
+				this->ClearUnlocked();
+				return true;
+			}
+
+		private:
+			/**
+			 * \brief Serialize the buffer into a file, must be called with the lock held.
+			 * \param FileLocation The directory to write the file to.
+			 * \return Whether or not the file was written.
+			 */
+			FORCEINLINE bool WriteGetRequestsToFile(const std::string& FileLocation)
+			{
+				FBatchWriter& Writer = GetBatchWriter();
+				const bool bBinary = IsWritingBinaryRecords();
+				for(size_t i = 0; i < this->Size(); ++i)
+				{
+					const FGetRequest& Request = this->RequestBuffer[i];
+					if(bBinary)
+					{
+						RecordStatics::BeginBinaryGetRecord(Writer, Request.GetRequestID(),
+							Request.GetPlayerAuthIDString(), Request.Size());
+						for(size_t j = 0; j < Request.Size(); ++j)
+						{
+							Writer.Append(static_cast<char>(Request[j]));
+						}
+						Writer.EndRecord();
+						continue;
+					}
+					Writer.AppendNumber(Request.GetRequestID());
+					Writer.Append(REQUEST_ID_DELIM_CHAR);
+					// add the player auth to the beginning so we know who it's for
+					Writer.Append(Request.GetPlayerAuthIDString());
+					Writer.Append(DELIM_CHAR);
+					for(size_t j = 0; j < Request.Size(); ++j)
+					{
+						switch(Request[j])
+						{
+							case EAttributeName::NONE:
+								break;
+							case EAttributeName::PLAYER_AUTH:
+								Writer.Append(TableKey_PlayerAuthID.Key);
+								break;
+							case EAttributeName::PLAYER_NAME:
+								Writer.Append(TableKey_PlayerName.Key);
+								break;
+							case EAttributeName::IS_ONLINE:
+								Writer.Append(TableKey_IsOnline.Key);
+								break;
+							default:
+								break;
+						}
+						Writer.Append(DELIM_CHAR);
+					}
+					Writer.EndRecord();
+				}
+				Writer.EndFile();
+				return WriteBatch<TBufferPlatform>(FileLocation, ERequestType::GET,
+					this->GetLanePriority(), Writer);
+			}
+
+			/** Request IDs of dropped GETs, guarded by the buffer lock */
+			std::vector<FRequestID> DroppedRequestIDs;
+			std::atomic<bool> bHasDroppedRequestIDs;
+		};
+
+		/**
+		 * TODO
+		 */
+		template<ERequestBufferType TBufferPlatform>
+		class IPC_ALIGN_TO_CACHE_LINE FPendingGetRequestBuffer final
+			: public FRequestBuffer<FPendingGetRequest, TBufferPlatform>
+		{
+		public:
+			FPendingGetRequestBuffer()
+				: FRequestBuffer<FPendingGetRequest, TBufferPlatform>()
+			{
+			}
+
+			/**
+			 * \brief Initialize this buffer
+			 */
+			virtual FORCEINLINE void Initialize() override
+			{
+				FPendingGetRequestBuffer();
+			}
+			
+			/**
+			 * \brief Copy out the pending request at Index, counting only the
+			 * requests still waiting.
+			 */
+			FPendingGetRequest operator[](const int Index)
+			{
+				FPendingGetRequest Out;
+				this->RunLambdaThroughLock([&]()
+				{
+					CompactIfHoledUnlocked();
+					Out = this->RequestBuffer[Index];
+				});
+				return Out;
+			}
+			
+			/**
+			 * \brief Remove the pending request at Index, counting only the
+			 * requests still waiting.
+			 */
+			FORCEINLINE bool RemoveElement(const uint32_t Index)
+			{
+				this->RunLambdaThroughLock([this]()
+				{
+					CompactIfHoledUnlocked();
+				});
+				return this->RemoveIndex(Index);
+			}
+
+			/**
+			 * \brief Find the pending request a response is for and take it out of
+			 * the buffer, through a hash index of the request IDs. The rest keep
+			 * their order, so @link EBackpressurePolicy::DROP_OLDEST still drops the
+			 * oldest: a take from the middle leaves a tombstone behind, and the
+			 * tombstones are squeezed out once they are half the buffer.
+			 * \param RequestID The request ID the response carried.
+			 * \param OutRequest Receives the pending request if it was found.
+			 * \return Whether or not a pending request had that ID.
+			 */
+			FORCEINLINE bool TakeByRequestID(
+				const FRequestID RequestID,
+				FPendingGetRequest& OutRequest)
+			{
+				bool bFound = false;
+				size_t NewSize = 0;
+				this->RunLambdaThroughLock([&]()
+				{
+					UpdateIndexUnlocked();
+					const auto Found = IndexByRequestID.find(RequestID);
+					if(Found == IndexByRequestID.end())
+					{
+						return;
+					}
+					TChunkedBuffer<FPendingGetRequest>& Buffer = this->RequestBuffer;
+					const size_t Index = Found->second - IndexedFront;
+					IndexByRequestID.erase(Found);
+					OutRequest = std::move(Buffer[Index]);
+					// A default request has no request ID, that marks the tombstone
+					Buffer[Index] = FPendingGetRequest();
+					++this->NumberOfTombstones;
+					RemoveTombstonesAtEndsUnlocked();
+					if(this->NumberOfTombstones * 2 > Buffer.Size())
+					{
+						CompactUnlocked();
+					}
+					NewSize = this->LiveSizeUnlocked();
+					this->BufferSize.store(NewSize, std::memory_order_release);
+					bFound = true;
+				});
+				if(bFound)
+				{
+					this->UpdateWatermark(NewSize);
+				}
+				return bFound;
+			}
+
+		protected:
+			/**
+			 * \brief Move the waiting requests down over the tombstones, in order.
+			 */
+			virtual FORCEINLINE void CompactUnlocked() override
+			{
+				TChunkedBuffer<FPendingGetRequest>& Buffer = this->RequestBuffer;
+				size_t Kept = 0;
+				for(size_t i = 0; i < Buffer.Size(); ++i)
+				{
+					if(IsTombstone(Buffer[i]))
+					{
+						continue;
+					}
+					if(i != Kept)
+					{
+						Buffer[Kept] = std::move(Buffer[i]);
+					}
+					++Kept;
+				}
+				while(Buffer.Size() > Kept)
+				{
+					Buffer.PopBack();
+				}
+				this->NumberOfTombstones = 0;
+				++this->LayoutVersion;
+			}
+
+		private:
+			static FORCEINLINE bool IsTombstone(const FPendingGetRequest& Request) noexcept
+			{
+				return Request.GetRequestID() == RequestIDStatics::None;
+			}
+
+			FORCEINLINE void CompactIfHoledUnlocked()
+			{
+				if(this->NumberOfTombstones != 0)
+				{
+					CompactUnlocked();
+				}
+			}
+
+			/**
+			 * \brief Drop the tombstones at either end of the buffer, which costs
+			 * nothing and moves no other request.
+			 */
+			FORCEINLINE void RemoveTombstonesAtEndsUnlocked()
+			{
+				TChunkedBuffer<FPendingGetRequest>& Buffer = this->RequestBuffer;
+				while(!Buffer.IsEmpty() && IsTombstone(Buffer.Back()))
+				{
+					Buffer.PopBack();
+					--this->NumberOfTombstones;
+				}
+				size_t Leading = 0;
+				while(Leading < Buffer.Size() && IsTombstone(Buffer[Leading]))
+				{
+					++Leading;
+				}
+				if(Leading != 0)
+				{
+					Buffer.RemoveFront(Leading);
+					this->NumberOfTombstones -= Leading;
+					// Indexed positions count from the front, so they stay valid
+					IndexedFront += Leading;
+				}
+				IndexedSize = Buffer.Size();
+			}
+
+			/**
+			 * \brief Index the requests pushed since the last take, or everything
+			 * again if requests were removed other than by a take since.
+			 */
+			FORCEINLINE void UpdateIndexUnlocked()
+			{
+				const TChunkedBuffer<FPendingGetRequest>& Buffer = this->RequestBuffer;
+				if(IndexedLayoutVersion != this->LayoutVersion || IndexedSize > Buffer.Size())
+				{
+					IndexByRequestID.clear();
+					IndexedSize = 0;
+					IndexedFront = 0;
+					IndexedLayoutVersion = this->LayoutVersion;
+				}
+				for(; IndexedSize < Buffer.Size(); ++IndexedSize)
+				{
+					if(!IsTombstone(Buffer[IndexedSize]))
+					{
+						IndexByRequestID[Buffer[IndexedSize].GetRequestID()] = IndexedFront + IndexedSize;
+					}
+				}
+			}
+
+			/** Positions since the index was built, the buffer index plus IndexedFront */
+			std::unordered_map<FRequestID, size_t> IndexByRequestID;
+			size_t IndexedSize = 0;
+			/** How many requests left the front through takes since the index was built */
+			size_t IndexedFront = 0;
+			uint64_t IndexedLayoutVersion = 0;
+		};
+		
+		/**
+		 * \brief A buffer used to store all pending @link FSetRequest while they wait to be written to a file.
+		 * \tparam TBufferPlatform The platform (UE/AWS) that this buffer is being used for.
+		 */
+		template<ERequestBufferType TBufferPlatform>
+		class IPC_ALIGN_TO_CACHE_LINE FSetRequestBuffer final
+			: public FRequestBuffer<FSetRequest, TBufferPlatform>
+		{
+		public:
+			FSetRequestBuffer()
+				: FRequestBuffer<FSetRequest, TBufferPlatform>()
+			{
+			}
+
+			/**
+			 * \brief Initialize this buffer
+			 */
+			virtual FORCEINLINE void Initialize() override
+			{
+				FSetRequestBuffer();
+			}
+			
+			/**
+			 * \brief Write all the current @link FSetRequest in this buffer to a specified file location.
+			 * \param FileLocation The directory to write the file to.
+			 */
+			FORCEINLINE void WriteSetRequestsToFileThroughLock(
+				const std::string& FileLocation)
+			{
+				this->RunLambdaThroughLock([&]()
+				{
+					WriteSetRequestsToFile(FileLocation);
+				});
+			}
+
+			/**
+			 * \brief Merge all of the SETs for the same player into one record when
+			 * the buffer is written to file.
+			 */
+			FORCEINLINE void SetCoalesce(const bool bShouldCoalesce) noexcept
+			{
+				bCoalesce.store(bShouldCoalesce, std::memory_order_relaxed);
+			}
+
+		protected:
+			/**
+			 * \brief Write every @link FSetRequest to SpillDirectory and empty the buffer.
+			 */
+			virtual FORCEINLINE bool SpillUnlocked(
+				const std::string& SpillDirectory) override
+			{
+				if(!WriteSetRequestsToFile(SpillDirectory))
+				{
+					return false;
+				}
+				this->ClearUnlocked();
+				return true;
+			}
+
+		private:
+			/**
+			 * \brief Serialize the buffer into a file, must be called with the lock held.
+			 * \param FileLocation The directory to write the file to.
+			 * \return Whether or not the file was written.
+			 */
+			FORCEINLINE bool WriteSetRequestsToFile(const std::string& FileLocation)
+			{
+				// Transpose into columns, then every later pass streams through
+				// contiguous memory instead of hopping between request objects
+				ColumnarBatch.Reset();
+				for(const FSetRequest& Request : this->RequestBuffer)
+				{
+					ColumnarBatch.AddRow(Request);
+				}
+				bool bWritten;
+				if(bCoalesce.load(std::memory_order_relaxed))
+				{
+					// AWS rows are GET responses, each one has to carry its own request ID
+					ColumnarBatch.CoalesceInto(CoalescedBatch,
+						TBufferPlatform == ERequestBufferType::UE);
+					bWritten = WriteColumnarSetBatchToFile<TBufferPlatform>(FileLocation, CoalescedBatch,
+						this->GetLanePriority());
+				}
+				else
+				{
+					bWritten = WriteColumnarSetBatchToFile<TBufferPlatform>(FileLocation, ColumnarBatch,
+						this->GetLanePriority());
+				}
+				
+				// Acknowledge by the original IDs, coalesced rows only keep the last one
+				if(TBufferPlatform == ERequestBufferType::UE && UE_WantsSetWriteResults())
+				{
+					for(const FRequestID RequestID : ColumnarBatch.RequestIDs)
+					{
+						UE_OnSetRequestWritten(RequestID, bWritten);
+					}
+				}
+				return bWritten;
+			}
+
+			std::atomic<bool> bCoalesce{false};
+			FColumnarSetBatch ColumnarBatch;
+			FColumnarSetBatch CoalescedBatch;
+		};
+		
+		/**
+		 * \brief A buffer of @link FCompactRequest. Requests are flattened straight
+		 * into the current pooled @link FCompactRequestBatch, and writing swaps
+		 * in a recycled batch so the lock is only held for the swap.
+		 * \tparam TRequestType Whether this buffer holds GET or SET requests.
+		 * \tparam TBufferPlatform The platform (UE/AWS) that this buffer is being used for.
+		 */
+		template<ERequestType TRequestType, ERequestBufferType TBufferPlatform>
+		class IPC_ALIGN_TO_CACHE_LINE FCompactRequestBuffer final
+		{
+		public:
+			static constexpr ERequestBufferType Platform = TBufferPlatform;
+			
+
+			FCompactRequestBuffer()
+				: FCompactRequestBuffer(false)
+			{
+			}
+
+			/**
+			 * \param bInTrackDroppedRequestIDs Keep the request IDs dropped by
+			 * @link EBackpressurePolicy::DROP_OLDEST for @link TakeDroppedRequestIDs.
+			 */
+			explicit FCompactRequestBuffer(const bool bInTrackDroppedRequestIDs)
+				: BufferSize{0},
+				NumberRejected{0},
+				NumberDropped{0},
+				NumberSpilled{0},
+				bHasDroppedRequestIDs{false},
+				bTrackDroppedRequestIDs{bInTrackDroppedRequestIDs}
+			{
+				CapacityConfig.Capacity = (TBufferPlatform == ERequestBufferType::UE) ?
+					(UE_BUFFER_CAPACITY) : (AWS_BUFFER_CAPACITY);
+			}
+
+			/**
+			 * \brief Initialize this buffer
+			 */
+			FORCEINLINE void Initialize()
+			{
+				BufferLock.Lock();
+				if(!CurrentBatch)
+				{
+					CurrentBatch = BatchPool.Acquire();
+				}
+				BufferLock.Unlock();
+			}
+
+			/**
+			 * \brief Set the capacity and backpressure policy of this buffer, the
+			 * same way as @link FRequestBuffer::Configure. Watermark callbacks are
+			 * left to the regular buffers.
+			 */
+			FORCEINLINE void Configure(const FBufferCapacityConfig& InConfig)
+			{
+				BufferLock.Lock();
+				CapacityConfig = InConfig;
+				CapacityConfig.WatermarkCallback = nullptr;
+				if(CapacityConfig.Capacity == 0)
+				{
+					CapacityConfig.Capacity = 1;
+				}
+				BufferLock.Unlock();
+			}
+
+			/**
+			 * \brief See @link FRequestBuffer::ConfigureFlushTrigger.
+			 */
+			FORCEINLINE void ConfigureFlushTrigger(const FFlushTriggerConfig& InConfig)
+			{
+				FlushTrigger.Configure(InConfig);
+			}
+
+			/**
+			 * \brief See @link FRequestBuffer::SetWakeEvent.
+			 */
+			FORCEINLINE void SetWakeEvent(FWakeEvent* InWakeEvent) noexcept
+			{
+				FlushTrigger.SetWakeEvent(InWakeEvent);
+			}
+
+			/**
+			 * \brief See @link FRequestBuffer::GetFlushWaitMS.
+			 */
+			FORCEINLINE uint32_t GetFlushWaitMS(const uint32_t MaxWaitMS) const noexcept
+			{
+				return FlushTrigger.GetWaitMS(Size(), MaxWaitMS);
+			}
+
+			/**
+			 * \brief Flatten a @link FGetRequest into the buffer.
+			 * \return Fails if the buffer is full and its policy found no room.
+			 */
+			FORCEINLINE bool PushBack(const FGetRequest& InRequest)
+			{
+				return PushBackInternal(InRequest, [&](FRequestArena& Arena)
+				{
+					return FCompactRequest::FromGetRequest(InRequest, Arena);
+				});
+			}
+
+			/**
+			 * \brief Flatten a @link FSetRequest into the buffer.
+			 * \return Fails if the buffer is full and its policy found no room.
+			 */
+			FORCEINLINE bool PushBack(const FSetRequest& InRequest)
+			{
+				return PushBackInternal(InRequest, [&](FRequestArena& Arena)
+				{
+					return FCompactRequest::FromSetRequest(InRequest, Arena);
+				});
+			}
+
+			/**
+			 * \brief Write every request in the buffer to a file, then recycle the batch.
+			 * \param FileLocation The directory to write the file to.
+			 * \return Whether or not a file was written.
+			 */
+			FORCEINLINE bool WriteRequestsToFileThroughLock(const std::string& FileLocation)
+			{
+				std::unique_ptr<FCompactRequestBatch> Batch = BatchPool.Acquire();
+				BufferLock.Lock();
+				CurrentBatch.swap(Batch);
+				const bool bHasTombstones = NumberOfTombstones != 0;
+				BufferSize.store(0, std::memory_order_release);
+				FlushTrigger.OnClearUnlocked();
+				ResetIndexUnlocked();
+				BufferLock.Unlock();
+
+				bool bWritten = false;
+				if(Batch)
+				{
+					if(bHasTombstones)
+					{
+						RemoveTombstones(Batch->Records);
+					}
+					bWritten = WriteBatch(FileLocation, *Batch);
+				}
+				BatchPool.Release(std::move(Batch));
+				return bWritten;
+			}
+
+			/**
+			 * \brief Completely erase all requests from the buffer in a thread safe manner.
+			 */
+			FORCEINLINE void Clear()
+			{
+				BufferLock.Lock();
+				if(CurrentBatch)
+				{
+					CurrentBatch->Reset();
+				}
+				BufferSize.store(0, std::memory_order_release);
+				FlushTrigger.OnClearUnlocked();
+				ResetIndexUnlocked();
+				BufferLock.Unlock();
+			}
+
+			/**
+			 * \brief Take the request with this ID out of the buffer, which is how
+			 * the compact pending table drains as GET responses are consumed.
+			 * The IDs are only indexed once this is first called. The rest keep
+			 * their order for @link EBackpressurePolicy::DROP_OLDEST, the request
+			 * is left as a tombstone until they are half the batch.
+			 * \return Whether or not a request had that ID.
+			 */
+			FORCEINLINE bool RemoveByRequestID(const FRequestID RequestID)
+			{
+				BufferLock.Lock();
+				if(!CurrentBatch)
+				{
+					BufferLock.Unlock();
+					return false;
+				}
+				std::vector<FCompactRequest>& Records = CurrentBatch->Records;
+				for(; IndexedSize < Records.size(); ++IndexedSize)
+				{
+					if(Records[IndexedSize].RequestID != RequestIDStatics::None)
+					{
+						IndexByRequestID[Records[IndexedSize].RequestID] = IndexedSize;
+					}
+				}
+				const auto Found = IndexByRequestID.find(RequestID);
+				if(Found == IndexByRequestID.end())
+				{
+					BufferLock.Unlock();
+					return false;
+				}
+				const size_t Index = Found->second;
+				IndexByRequestID.erase(Found);
+				DeadArenaBytes += Records[Index].PlayerAuthID.Length +
+					Records[Index].PlayerName.Length;
+				Records[Index].RequestID = RequestIDStatics::None;
+				++NumberOfTombstones;
+				while(!Records.empty() && Records.back().RequestID == RequestIDStatics::None)
+				{
+					Records.pop_back();
+					--NumberOfTombstones;
+				}
+				IndexedSize = Records.size();
+				if(Records.empty())
+				{
+					CurrentBatch->Arena.Reset();
+					DeadArenaBytes = 0;
+					FlushTrigger.OnClearUnlocked();
+				}
+				else if(NumberOfTombstones * 2 > Records.size())
+				{
+					CompactUnlocked();
+				}
+				if(DeadArenaBytes > COMPACT_ARENA_RESERVE_SIZE &&
+					DeadArenaBytes > CurrentBatch->Arena.Size() / 2)
+				{
+					CompactArenaUnlocked();
+				}
+				BufferSize.store(Records.size() - NumberOfTombstones, std::memory_order_release);
+				BufferLock.Unlock();
+				return true;
+			}
+
+			/**
+			 * \brief Move out the request IDs dropped by @link EBackpressurePolicy::DROP_OLDEST
+			 * since the last call, only kept if the buffer was made to track them.
+			 * \return Fails without taking the lock if nothing was dropped.
+			 */
+			FORCEINLINE bool TakeDroppedRequestIDs(std::vector<FRequestID>& OutRequestIDs)
+			{
+				if(!bHasDroppedRequestIDs.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+				BufferLock.Lock();
+				OutRequestIDs.swap(DroppedRequestIDs);
+				DroppedRequestIDs.clear();
+				bHasDroppedRequestIDs.store(false, std::memory_order_release);
+				BufferLock.Unlock();
+				return !OutRequestIDs.empty();
+			}
+
+			/** \brief Whether the buffer holds no requests. */
+			FORCEINLINE bool IsEmpty() const noexcept
+			{
+				return Size() == 0;
+			}
+
+			/** \brief The number of requests in the buffer. */
+			FORCEINLINE size_t Size() const noexcept
+			{
+				return BufferSize.load(std::memory_order_acquire);
+			}
+
+			/**
+			 * \return How many pushes failed because the buffer was full.
+			 */
+			FORCEINLINE uint64_t GetNumberRejected() const noexcept
+			{
+				return NumberRejected.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * \return How many requests were dropped by @link EBackpressurePolicy::DROP_OLDEST.
+			 */
+			FORCEINLINE uint64_t GetNumberDropped() const noexcept
+			{
+				return NumberDropped.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * \return How many requests were written out by @link EBackpressurePolicy::SPILL_TO_DISK.
+			 */
+			FORCEINLINE uint64_t GetNumberSpilled() const noexcept
+			{
+				return NumberSpilled.load(std::memory_order_relaxed);
+			}
+
+		private:
+			template<typename TRequest, typename TFlatten>
+			FORCEINLINE bool PushBackInternal(const TRequest& InRequest, const TFlatten& Flatten)
+			{
+				std::chrono::steady_clock::time_point Deadline;
+				bool bHasDeadline = false;
+				for(;;)
+				{
+					BufferLock.Lock();
+					if(!CurrentBatch)
+					{
+						CurrentBatch = BatchPool.Acquire();
+					}
+					if(!MakeRoomUnlocked())
+					{
+						const bool bWait = CapacityConfig.Policy == EBackpressurePolicy::BLOCK;
+						const uint32_t BlockTimeoutMS = CapacityConfig.BlockTimeoutMS;
+						BufferLock.Unlock();
+						if(bWait && WaitForBufferRoom(Deadline, bHasDeadline, BlockTimeoutMS))
+						{
+							continue;
+						}
+						NumberRejected.fetch_add(1, std::memory_order_relaxed);
+						return false;
+					}
+					const size_t ArenaSize = CurrentBatch->Arena.Size();
+					CurrentBatch->Records.push_back(Flatten(CurrentBatch->Arena));
+					const size_t NewSize = CurrentBatch->Records.size() - NumberOfTombstones;
+					BufferSize.store(NewSize, std::memory_order_release);
+					FlushTrigger.OnPushUnlocked(NewSize,
+						CurrentBatch->Arena.Size() - ArenaSize + sizeof(FCompactRequest),
+						InRequest.GetFlushDeadlineNs());
+					BufferLock.Unlock();
+					FlushTrigger.WakeIfPending();
+					return true;
+				}
+			}
+
+			/**
+			 * \brief Apply the backpressure policy if the buffer is full, must be
+			 * called with the lock held.
+			 * \return Whether there is room for one more request.
+			 */
+			FORCEINLINE bool MakeRoomUnlocked()
+			{
+				std::vector<FCompactRequest>& Records = CurrentBatch->Records;
+				if(Records.size() - NumberOfTombstones < CapacityConfig.Capacity)
+				{
+					return true;
+				}
+				if(NumberOfTombstones != 0)
+				{
+					CompactUnlocked();
+				}
+				switch(CapacityConfig.Policy)
+				{
+					case EBackpressurePolicy::DROP_OLDEST:
+						DropOldestUnlocked();
+						return true;
+					case EBackpressurePolicy::SPILL_TO_DISK:
+					{
+						if(CapacityConfig.SpillDirectory.empty())
+						{
+							return false;
+						}
+						const size_t NumberToSpill = Records.size();
+						if(!WriteBatch(CapacityConfig.SpillDirectory, *CurrentBatch))
+						{
+							return false;
+						}
+						CurrentBatch->Reset();
+						ResetIndexUnlocked();
+						FlushTrigger.OnClearUnlocked();
+						NumberSpilled.fetch_add(NumberToSpill, std::memory_order_relaxed);
+						return true;
+					}
+					case EBackpressurePolicy::BLOCK:
+					case EBackpressurePolicy::REJECT:
+					default:
+						return false;
+				}
+			}
+
+			/**
+			 * \brief Drop the oldest sixteenth of the batch, see
+			 * @link FRequestBuffer::DropOldestUnlocked. The batch must have no tombstones.
+			 */
+			FORCEINLINE void DropOldestUnlocked()
+			{
+				std::vector<FCompactRequest>& Records = CurrentBatch->Records;
+				const size_t NumberToDrop = (std::max)(
+					Records.size() / 16, static_cast<size_t>(1));
+				for(size_t i = 0; i < NumberToDrop; ++i)
+				{
+					DeadArenaBytes += Records[i].PlayerAuthID.Length + Records[i].PlayerName.Length;
+					if(bTrackDroppedRequestIDs && Records[i].RequestID != RequestIDStatics::None)
+					{
+						DroppedRequestIDs.push_back(Records[i].RequestID);
+					}
+				}
+				Records.erase(Records.begin(), Records.begin() + NumberToDrop);
+				bHasDroppedRequestIDs.store(!DroppedRequestIDs.empty(), std::memory_order_release);
+				// Positions moved, the index is rebuilt on the next removal
+				IndexByRequestID.clear();
+				IndexedSize = 0;
+				NumberDropped.fetch_add(NumberToDrop, std::memory_order_relaxed);
+			}
+
+			/**
+			 * \brief Write a batch to a file, and tell the UE side how its SETs went.
+			 */
+			static FORCEINLINE bool WriteBatch(const std::string& FileLocation, const FCompactRequestBatch& Batch)
+			{
+				if(Batch.Records.empty())
+				{
+					return false;
+				}
+				const bool bWritten = WriteCompactBatchToFile<TBufferPlatform>(FileLocation, TRequestType, Batch);
+				if(TRequestType == ERequestType::SET &&
+					TBufferPlatform == ERequestBufferType::UE &&
+					UE_WantsSetWriteResults())
+				{
+					for(const FCompactRequest& Record : Batch.Records)
+					{
+						UE_OnSetRequestWritten(Record.RequestID, bWritten);
+					}
+				}
+				return bWritten;
+			}
+
+			/**
+			 * \brief Move the requests still waiting down over the tombstones, in order.
+			 */
+			static FORCEINLINE void RemoveTombstones(std::vector<FCompactRequest>& Records)
+			{
+				Records.erase(std::remove_if(Records.begin(), Records.end(),
+					[](const FCompactRequest& Record)
+					{
+						return Record.RequestID == RequestIDStatics::None;
+					}), Records.end());
+			}
+
+			/**
+			 * \brief Squeeze the tombstones out of the current batch and forget
+			 * the index, whose positions moved.
+			 */
+			FORCEINLINE void CompactUnlocked()
+			{
+				RemoveTombstones(CurrentBatch->Records);
+				NumberOfTombstones = 0;
+				IndexByRequestID.clear();
+				IndexedSize = 0;
+			}
+
+			/**
+			 * \brief Forget the request ID index, the current batch was emptied or swapped.
+			 */
+			FORCEINLINE void ResetIndexUnlocked()
+			{
+				IndexByRequestID.clear();
+				IndexedSize = 0;
+				DeadArenaBytes = 0;
+				NumberOfTombstones = 0;
+			}
+
+			/**
+			 * \brief Copy the strings of the requests still in the batch into a
+			 * fresh arena, dropping the bytes of every request removed by ID.
+			 */
+			FORCEINLINE void CompactArenaUnlocked()
+			{
+				FRequestArena& Arena = CurrentBatch->Arena;
+				FRequestArena Compacted;
+				Compacted.Reserve(Arena.Size() - DeadArenaBytes);
+				for(FCompactRequest& Record : CurrentBatch->Records)
+				{
+					Record.PlayerAuthID = Compacted.Append(Arena.View(Record.PlayerAuthID));
+					Record.PlayerName = Compacted.Append(Arena.View(Record.PlayerName));
+				}
+				Arena = std::move(Compacted);
+				DeadArenaBytes = 0;
+			}
+
+			std::atomic<size_t> BufferSize;
+			std::atomic<uint64_t> NumberRejected;
+			std::atomic<uint64_t> NumberDropped;
+			std::atomic<uint64_t> NumberSpilled;
+			FBufferCapacityConfig CapacityConfig;
+			FFlushTriggerState FlushTrigger;
+			FSpinLoop<true> BufferLock;
+			std::unique_ptr<FCompactRequestBatch> CurrentBatch;
+			TSlabPool<FCompactRequestBatch> BatchPool;
+			/** Position of each request in the current batch, see @link RemoveByRequestID */
+			std::unordered_map<FRequestID, size_t> IndexByRequestID;
+			size_t IndexedSize = 0;
+			/** Arena bytes still held by requests that were removed or dropped */
+			size_t DeadArenaBytes = 0;
+			/** Requests removed by ID from the middle of the batch, their ID is None */
+			size_t NumberOfTombstones = 0;
+			std::vector<FRequestID> DroppedRequestIDs;
+			std::atomic<bool> bHasDroppedRequestIDs;
+			const bool bTrackDroppedRequestIDs;
+		};
+		
+		/**
+		 * \brief Unbounded lock-free queue with any number of producers and a
+		 * single consumer. Producers never wait on each other or on the consumer.
+		 * \tparam T The element type, it must be default constructible.
+		 */
+		template<typename T>
+		class TMPSCQueue
+		{
+			struct FNode
+			{
+				std::atomic<FNode*> Next{nullptr};
+				T Value;
+			};
+			
+		public:
+			TMPSCQueue()
+				: Head{&Stub},
+				Tail{&Stub}
+			{
+			}
+
+			TMPSCQueue(const TMPSCQueue&) = delete;
+			TMPSCQueue& operator=(const TMPSCQueue&) = delete;
+
+			~TMPSCQueue()
+			{
+				T Discarded;
+				while(Pop(Discarded))
+				{
+				}
+			}
+
+			/**
+			 * \brief Add an element, safe to call from any thread.
+			 */
+			FORCEINLINE void Push(T InValue)
+			{
+				FNode* Node = new FNode;
+				Node->Value = std::move(InValue);
+				PushNode(Node);
+			}
+
+			/**
+			 * \brief Take the oldest element, only one thread may pop at a time.
+			 * \return Fails if the queue is empty, or the only element is still
+			 * being linked in by its producer.
+			 */
+			FORCEINLINE bool Pop(T& OutValue)
+			{
+				FNode* Current = Tail;
+				FNode* Next = Current->Next.load(std::memory_order_acquire);
+				if(Current == &Stub)
+				{
+					if(!Next)
+					{
+						return false;
+					}
+					Tail = Next;
+					Current = Next;
+					Next = Next->Next.load(std::memory_order_acquire);
+				}
+				if(!Next)
+				{
+					if(Current != Head.load(std::memory_order_acquire))
+					{
+						return false;
+					}
+					// Put the stub back behind the last node so it can be unlinked
+					PushNode(&Stub);
+					Next = Current->Next.load(std::memory_order_acquire);
+					if(!Next)
+					{
+						return false;
+					}
+				}
+				Tail = Next;
+				OutValue = std::move(Current->Value);
+				delete Current;
+				return true;
+			}
+
+		private:
+			FORCEINLINE void PushNode(FNode* Node) noexcept
+			{
+				Node->Next.store(nullptr, std::memory_order_relaxed);
+				FNode* Previous = Head.exchange(Node, std::memory_order_acq_rel);
+				Previous->Next.store(Node, std::memory_order_release);
+			}
+			
+			std::atomic<FNode*> Head;
+			FNode* Tail;
+			FNode Stub;
+		};
+
+		/**
+		 * \brief A completion waiting in the queue, with the async GET it resolves if any.
+		 */
+		struct FQueuedCompletion
+		{
+			FIPCCompletion Completion;
+			std::shared_ptr<FAsyncGetState> State;
+		};
+		
+		/**
+		 * \brief A buffer for @link ERequestPriority::HIGH requests, flushed on
+		 * its own deadline instead of waiting behind the bulk buffer.
+		 * \tparam TBuffer The request buffer type the lane wraps.
+		 */
+		template<typename TBuffer>
+		class FPriorityLane
+		{
+		public:
+			FPriorityLane()
+				: OpenedAtNs{0},
+				FlushDeadlineNs{0},
+				bHasFlushDirectory{false}
+			{
+				Buffer.SetLanePriority(ERequestPriority::HIGH);
+			}
+
+			/** \brief Set where and how soon HIGH requests are flushed. */
+			FORCEINLINE void Configure(const FPriorityLaneConfig& InConfig)
+			{
+				ConfigLock.Lock();
+				FlushDirectory = InConfig.FlushDirectory;
+				FlushDeadlineNs.store(static_cast<int64_t>(InConfig.FlushDeadlineMS) * 1000000,
+					std::memory_order_relaxed);
+				bHasFlushDirectory.store(!FlushDirectory.empty(), std::memory_order_release);
+				ConfigLock.Unlock();
+			}
+
+			/**
+			 * \brief Push a request into the lane, starting the deadline if the lane was empty.
+			 */
+			template<typename TRequest>
+			FORCEINLINE bool PushBack(TRequest&& InRequest)
+			{
+				if(!Buffer.PushBack(std::forward<TRequest>(InRequest)))
+				{
+					return false;
+				}
+				int64_t Expected = 0;
+				OpenedAtNs.compare_exchange_strong(Expected, GetNowNs(),
+					std::memory_order_acq_rel);
+				return true;
+			}
+
+			/**
+			 * \brief Flush the lane on this thread if it is set to flush with no deadline.
+			 */
+			FORCEINLINE bool FlushIfImmediate()
+			{
+				if(FlushDeadlineNs.load(std::memory_order_relaxed) != 0)
+				{
+					return false;
+				}
+				return FlushIfDue();
+			}
+
+			/**
+			 * \brief Flush the lane to its configured directory if its oldest request
+			 * has waited for the deadline.
+			 */
+			FORCEINLINE bool FlushIfDue()
+			{
+				if(!bHasFlushDirectory.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+				const int64_t OpenedAt = OpenedAtNs.load(std::memory_order_acquire);
+				if(OpenedAt == 0 ||
+					GetNowNs() - OpenedAt < FlushDeadlineNs.load(std::memory_order_relaxed))
+				{
+					return false;
+				}
+				
+				ConfigLock.Lock();
+				const std::string Directory = FlushDirectory;
+				ConfigLock.Unlock();
+				return Flush(Directory);
+			}
+
+			/**
+			 * \brief Write every request in the lane to a file in FileLocation.
+			 */
+			FORCEINLINE bool Flush(const std::string& FileLocation)
+			{
+				const int64_t OpenedAt = OpenedAtNs.exchange(0, std::memory_order_acq_rel);
+				if(Buffer.FlushToFileThroughLock(FileLocation))
+				{
+					return true;
+				}
+				// Anything still in the lane keeps its place in the deadline
+				if(!Buffer.IsEmpty())
+				{
+					int64_t Expected = 0;
+					OpenedAtNs.compare_exchange_strong(Expected,
+						(OpenedAt != 0) ? (OpenedAt) : (GetNowNs()),
+						std::memory_order_acq_rel);
+				}
+				return false;
+			}
+
+			/** \brief Empty the lane and forget when it was opened. */
+			FORCEINLINE void Clear()
+			{
+				Buffer.Clear();
+				OpenedAtNs.store(0, std::memory_order_release);
+			}
+
+			/** \brief The buffer the lane's requests are held in. */
+			FORCEINLINE TBuffer& GetBuffer() noexcept
+			{
+				return Buffer;
+			}
+
+		private:
+			static FORCEINLINE int64_t GetNowNs() noexcept
+			{
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+			
+			TBuffer Buffer;
+			std::atomic<int64_t> OpenedAtNs;
+			std::atomic<int64_t> FlushDeadlineNs;
+			std::atomic<bool> bHasFlushDirectory;
+			FSpinLoop<false> ConfigLock;
+			std::string FlushDirectory;
+		};
+		
+		/**
+		 * \brief Fixed capacity queue between two pipeline stages. Pushes wait for
+		 * room and pops wait for an item, until the queue is closed, asleep on a
+		 * @link FWakeEvent so an idle stage costs nothing.
+		 * \tparam T The element type.
+		 */
+		template<typename T>
+		class TBoundedQueue
+		{
+		public:
+			TBoundedQueue()
+				: Capacity{AWS_PIPELINE_QUEUE_CAPACITY},
+				bClosed{false},
+				Count{0}
+			{
+			}
+
+			/**
+			 * \brief Empty and reopen the queue, must not be called while it is in use.
+			 */
+			FORCEINLINE void Reset(const size_t InCapacity)
+			{
+				Lock.Lock();
+				Items.clear();
+				Capacity = (std::max)(InCapacity, static_cast<size_t>(1));
+				Count.store(0, std::memory_order_release);
+				bClosed.store(false, std::memory_order_release);
+				Lock.Unlock();
+			}
+
+			/**
+			 * \brief Wake every waiter, pops fail once the queue is empty and pushes fail straight away.
+			 */
+			FORCEINLINE void Close() noexcept
+			{
+				bClosed.store(true, std::memory_order_release);
+				NotEmpty.Notify();
+				NotFull.Notify();
+			}
+
+			/**
+			 * \brief Wait for room and push.
+			 * \param OutStalledNs Has the time spent waiting added to it.
+			 * \return Fails if the queue was closed.
+			 */
+			FORCEINLINE bool Push(T&& Value, uint64_t& OutStalledNs)
+			{
+				std::chrono::steady_clock::time_point StallStart;
+				bool bStalled = false;
+				for(;;)
+				{
+					// Snapshot first, so a pop that makes room before the wait isn't slept through
+					const uint32_t SeenSequence = NotFull.Snapshot();
+					if(bClosed.load(std::memory_order_acquire))
+					{
+						return false;
+					}
+					Lock.Lock();
+					if(Items.size() < Capacity)
+					{
+						Items.push_back(std::move(Value));
+						Count.store(Items.size(), std::memory_order_release);
+						Lock.Unlock();
+						NotEmpty.Notify();
+						if(bStalled)
+						{
+							OutStalledNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+								std::chrono::steady_clock::now() - StallStart).count();
+						}
+						return true;
+					}
+					Lock.Unlock();
+					if(!bStalled)
+					{
+						StallStart = std::chrono::steady_clock::now();
+						bStalled = true;
+					}
+					NotFull.WaitFor(SeenSequence, FWakeEvent::NoTimeout);
+				}
+			}
+
+			/**
+			 * \brief Wait for an item and pop it.
+			 * \return Fails once the queue is closed and empty.
+			 */
+			FORCEINLINE bool Pop(T& OutValue)
+			{
+				for(;;)
+				{
+					const uint32_t SeenSequence = NotEmpty.Snapshot();
+					// Read closed first, so an item pushed before closing is never missed
+					const bool bWasClosed = bClosed.load(std::memory_order_acquire);
+					Lock.Lock();
+					if(!Items.empty())
+					{
+						OutValue = std::move(Items.front());
+						Items.pop_front();
+						Count.store(Items.size(), std::memory_order_release);
+						Lock.Unlock();
+						NotFull.Notify();
+						return true;
+					}
+					Lock.Unlock();
+					if(bWasClosed)
+					{
+						return false;
+					}
+					NotEmpty.WaitFor(SeenSequence, FWakeEvent::NoTimeout);
+				}
+			}
+
+			/**
+			 * \brief Pop an item if there is one, without waiting.
+			 */
+			FORCEINLINE bool TryPop(T& OutValue)
+			{
+				Lock.Lock();
+				if(Items.empty())
+				{
+					Lock.Unlock();
+					return false;
+				}
+				OutValue = std::move(Items.front());
+				Items.pop_front();
+				Count.store(Items.size(), std::memory_order_release);
+				Lock.Unlock();
+				NotFull.Notify();
+				return true;
+			}
+
+			/** \brief The number of items waiting in the queue. */
+			FORCEINLINE size_t Size() const noexcept
+			{
+				return Count.load(std::memory_order_acquire);
+			}
+
+		private:
+			FSpinLoop<false> Lock;
+			std::deque<T> Items;
+			size_t Capacity;
+			std::atomic<bool> bClosed;
+			std::atomic<size_t> Count;
+			FWakeEvent NotEmpty;
+			FWakeEvent NotFull;
+		};
+
+		/**
+		 * \brief A fixed set of helper threads that, together with the calling
+		 * thread, run the numbered tasks of one @link Run call at a time. Each
+		 * task is run by exactly one thread, in no particular order.
+		 */
+		class FParallelTaskPool
+		{
+		public:
+			FParallelTaskPool()
+				: bIsStopping{false},
+				Generation{0},
+				TasksLeft{0}
+			{
+			}
+
+			~FParallelTaskPool()
+			{
+				Stop();
+			}
+
+			/**
+			 * \brief Start NumberOfHelpers threads, must not be called while running.
+			 */
+			FORCEINLINE void Start(const size_t NumberOfHelpers)
+			{
+				bIsStopping.store(false, std::memory_order_release);
+				for(size_t i = 0; i < NumberOfHelpers; ++i)
+				{
+					Helpers.emplace_back([this]() { RunHelper(); });
+				}
+			}
+
+			/**
+			 * \brief Join the helpers, must not be called during a @link Run.
+			 */
+			FORCEINLINE void Stop()
+			{
+				bIsStopping.store(true, std::memory_order_release);
+				GenerationEvent.Notify();
+				for(std::thread& Helper : Helpers)
+				{
+					Helper.join();
+				}
+				Helpers.clear();
+			}
+
+			/**
+			 * \return The helpers plus the thread calling @link Run.
+			 */
+			FORCEINLINE size_t GetNumberOfThreads() const noexcept
+			{
+				return Helpers.size() + 1;
+			}
+
+			/**
+			 * \brief Run Task(0) ... Task(NumberOfTasks - 1) across the pool and
+			 * wait for all of them to finish.
+			 */
+			FORCEINLINE void Run(
+				const size_t NumberOfTasks,
+				const std::function<void(size_t)>& Task)
+			{
+				if(NumberOfTasks == 0)
+				{
+					return;
+				}
+				TaskLock.Lock();
+				CurrentTask = &Task;
+				TaskCount = NumberOfTasks;
+				NextTask = 0;
+				TasksLeft.store(NumberOfTasks, std::memory_order_relaxed);
+				const uint64_t RunGeneration = Generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+				TaskLock.Unlock();
+				GenerationEvent.Notify();
+
+				RunTasks(RunGeneration);
+				for(;;)
+				{
+					const uint32_t SeenSequence = DoneEvent.Snapshot();
+					if(TasksLeft.load(std::memory_order_acquire) == 0)
+					{
+						return;
+					}
+					DoneEvent.WaitFor(SeenSequence, FWakeEvent::NoTimeout);
+				}
+			}
+
+		private:
+			/**
+			 * \brief Body of a helper thread: wait for @link Run to start a new
+			 * generation, help run its tasks, then wait for the next, until
+			 * @link Stop.
+			 */
+			FORCEINLINE void RunHelper()
+			{
+				uint64_t LastGeneration = 0;
+				for(;;)
+				{
+					// Snapshot first, so a run or stop that lands before the wait isn't slept through
+					const uint32_t SeenSequence = GenerationEvent.Snapshot();
+					if(bIsStopping.load(std::memory_order_acquire))
+					{
+						return;
+					}
+					const uint64_t CurrentGeneration = Generation.load(std::memory_order_acquire);
+					if(CurrentGeneration == LastGeneration)
+					{
+						GenerationEvent.WaitFor(SeenSequence, FWakeEvent::NoTimeout);
+						continue;
+					}
+					LastGeneration = CurrentGeneration;
+					RunTasks(CurrentGeneration);
+				}
+			}
+
+			/**
+			 * \brief Take tasks of RunGeneration until there are none left. A
+			 * thread that woke too late for its run takes nothing from the next.
+			 */
+			FORCEINLINE void RunTasks(const uint64_t RunGeneration)
+			{
+				for(;;)
+				{
+					TaskLock.Lock();
+					if(Generation.load(std::memory_order_relaxed) != RunGeneration ||
+						NextTask == TaskCount)
+					{
+						TaskLock.Unlock();
+						return;
+					}
+					const size_t Index = NextTask++;
+					const std::function<void(size_t)>* Task = CurrentTask;
+					TaskLock.Unlock();
+
+					(*Task)(Index);
+					if(TasksLeft.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					{
+						DoneEvent.Notify();
+					}
+				}
+			}
+
+			std::vector<std::thread> Helpers;
+			std::atomic<bool> bIsStopping;
+			std::atomic<uint64_t> Generation;
+			std::atomic<size_t> TasksLeft;
+			/** Notified when @link Run starts a generation and on @link Stop, helpers sleep on it */
+			FWakeEvent GenerationEvent;
+			/** Notified by whichever thread finishes the last task of a run */
+			FWakeEvent DoneEvent;
+			FSpinLoop<false> TaskLock;
+			const std::function<void(size_t)>* CurrentTask = nullptr;
+			size_t TaskCount = 0;
+			size_t NextTask = 0;
+		};
+
+		/**
+		 * \brief What a directory entry is, as far as the listing itself says.
+		 */
+		enum class EDirectoryEntryType : uint8_t
+		{
+			FILE = 0,
+			DIRECTORY,
+			OTHER
+		};
+
+	public:
+		/**
+		 * \brief Lists the request files of one directory, handing back only the
+		 * ones that weren't there on the previous scan. Names are filtered on
+		 * their type prefix and extension straight from the directory entries,
+		 * so nothing is stat'ed, and a manifest of paths remembers what was
+		 * already handed back. Not thread safe, each scanner belongs to one
+		 * reader.
+		 */
+		class FDirectoryScanner
+		{
+		public:
+			struct FScannedFile
+			{
+				std::string Path;
+				ERequestType RequestType = ERequestType::GET;
+				ERequestPriority Priority = ERequestPriority::NORMAL;
+				FUniqueID ID;
+			};
+
+			FDirectoryScanner()
+				: TypeMask{0xFF},
+				Generation{0}
+			{
+			}
+
+			/**
+			 * \brief Point the scanner at a directory, forgetting everything it saw.
+			 * \param TypeMask Which request types to report, bit (1 << @link ERequestType) each.
+			 */
+			FORCEINLINE void SetDirectory(const std::string& InDirectory, const uint8_t InTypeMask = 0xFF)
+			{
+				Directory = InDirectory;
+				if(!Directory.empty() && Directory.back() != '/' && Directory.back() != '\\')
+				{
+					Directory.push_back(static_cast<char>(std::filesystem::path::preferred_separator));
+				}
+				TypeMask = InTypeMask;
+				Manifest.clear();
+			}
+
+			/**
+			 * \brief Append the request files that appeared since the last scan,
+			 * @link ERequestPriority::HIGH files first and then in sequence order.
+			 * Files that are gone drop out of the manifest, so a name that comes
+			 * back is new again.
+			 * \return Fails if the directory couldn't be read.
+			 */
+			FORCEINLINE bool Scan(std::vector<FScannedFile>& OutNewFiles)
+			{
+				++Generation;
+				const size_t FirstNew = OutNewFiles.size();
+				const bool bRead = ForEachDirectoryEntry(Directory,
+					[this, &OutNewFiles](const char* Name, const size_t Length, const EDirectoryEntryType Type)
+					{
+						constexpr size_t ExtensionLength = sizeof(FILE_EXTENSION) - 1;
+						if(Type != EDirectoryEntryType::FILE || Length <= ExtensionLength ||
+							std::memcmp(Name + Length - ExtensionLength, FILE_EXTENSION, ExtensionLength) != 0)
+						{
+							return;
+						}
+						// Reuses the buffer, so a known file costs no allocation
+						ScanPath.assign(Directory).append(Name, Length);
+						const auto Known = Manifest.find(ScanPath);
+						if(Known != Manifest.end())
+						{
+							Known->second = Generation;
+							return;
+						}
+						Manifest.emplace(ScanPath, Generation);
+						
+						// Only a name seen for the first time is parsed
+						FScannedFile File;
+						File.Path = ScanPath;
+						if(ParseUniqueFileName(File.Path, File.RequestType, File.ID, File.Priority) &&
+							(TypeMask & (1 << static_cast<uint8_t>(File.RequestType))) != 0)
+						{
+							OutNewFiles.push_back(std::move(File));
+						}
+					});
+				if(!bRead)
+				{
+					Manifest.clear();
+					return false;
+				}
+				
+				for(auto Entry = Manifest.begin(); Entry != Manifest.end();)
+				{
+					if(Entry->second != Generation)
+					{
+						Entry = Manifest.erase(Entry);
+					}
+					else
+					{
+						++Entry;
+					}
+				}
+				std::sort(OutNewFiles.begin() + FirstNew, OutNewFiles.end(),
+					[](const FScannedFile& Left, const FScannedFile& Right)
+					{
+						if(Left.Priority != Right.Priority)
+						{
+							return Left.Priority == ERequestPriority::HIGH;
+						}
+						return Left.ID < Right.ID;
+					});
+				return true;
+			}
+
+			/**
+			 * \brief Forget a file, so the next scan reports it again if it's still there.
+			 * \param FilePath The file name, optionally with its directory.
+			 */
+			FORCEINLINE void Forget(const std::string& FilePath)
+			{
+				// Only the platform's separators count, request file names start
+				// with a '\' that isn't one on POSIX
+				ScanPath.assign(Directory).append(std::filesystem::path(FilePath).filename().string());
+				Manifest.erase(ScanPath);
+			}
+
+			/** \brief The directory being scanned. */
+			FORCEINLINE const std::string& GetDirectory() const noexcept
+			{
+				return Directory;
+			}
+
+			/** \brief The number of files the manifest holds. */
+			FORCEINLINE size_t GetNumberOfKnownFiles() const noexcept
+			{
+				return Manifest.size();
+			}
+
+		private:
+			std::string Directory;
+			uint8_t TypeMask;
+			uint32_t Generation;
+			/** Path of each file -> the scan that last saw it */
+			std::unordered_map<std::string, uint32_t> Manifest;
+			std::string ScanPath;
+		};
+
+	private:
+
+#if IPC_HAS_SEGMENT_FILES
+		/**
+		 * \brief Where a segment file is in its cycle. Only the writer takes a
+		 * segment out of FREE or APPENDING, and only the reader takes one out of READY.
+		 */
+		enum class ESegmentState : uint8_t
+		{
+			FREE = 0,
+			/** Holds a whole batch, or a stream the writer has finished with */
+			READY,
+			/** Claimed by the reader, it goes back to FREE once its batch is handled */
+			CONSUMING,
+			/** A stream still being written, records up to PayloadSize are committed */
+			APPENDING
+		};
+
+		/**
+		 * \brief The start of every segment file, the batch itself follows at
+		 * SEGMENT_PAYLOAD_OFFSET. It is rewritten in place on every change of
+		 * state, so a header whose checksum doesn't match is mid rewrite.
+		 */
+		struct FSegmentHeader
+		{
+			uint32_t Magic;
+			ESegmentState State;
+			ERequestType RequestType;
+			ERequestPriority Priority;
+			/** Records appended over time without a footer, rather than one batch */
+			bool bIsStreamed;
+			/** Orders the batch against files and the other segments */
+			FUniqueID ID;
+			/** How many batches this segment has carried */
+			uint64_t Sequence;
+			/** For a stream, the committed watermark */
+			uint64_t PayloadSize;
+			uint32_t Reserved;
+			uint32_t HeaderCrc;
+		};
+
+		static_assert(sizeof(FSegmentHeader) == 48,
+			"FSegmentHeader is written as is, it must not have any padding");
+
+		/**
+		 * \brief How much of a stream the reader has handled, kept beside the
+		 * segment in a file of its own since the writer owns the header.
+		 */
+		struct FSegmentCursor
+		{
+			uint32_t Magic;
+			uint32_t Reserved;
+			/** The use of the segment Consumed belongs to */
+			uint64_t Sequence;
+			/** Every record before this offset has been handled */
+			uint64_t Consumed;
+			uint32_t Padding;
+			uint32_t CursorCrc;
+		};
+
+		static_assert(sizeof(FSegmentCursor) == 32,
+			"FSegmentCursor is written as is, it must not have any padding");
+
+		/**
+		 * \brief Positioned reads and writes of segment files, so a segment
+		 * never needs seeking, truncating or reopening.
+		 */
+		struct FSegmentFile
+		{
+			/**
+			 * \brief Read the header of an open segment.
+			 * \return Fails if it isn't a segment or is being rewritten.
+			 */
+			static FORCEINLINE bool ReadHeader(const int Handle, FSegmentHeader& OutHeader) noexcept
+			{
+				return ReadAt(Handle, &OutHeader, sizeof(OutHeader), 0) &&
+					OutHeader.Magic == SEGMENT_MAGIC &&
+					OutHeader.HeaderCrc == FCrc32C::Compute(&OutHeader, offsetof(FSegmentHeader, HeaderCrc));
+			}
+
+			/**
+			 * \brief Seal a header with its checksum and write it in one go.
+			 */
+			static FORCEINLINE bool WriteHeader(const int Handle, FSegmentHeader& Header) noexcept
+			{
+				Header.Magic = SEGMENT_MAGIC;
+				Header.HeaderCrc = FCrc32C::Compute(&Header, offsetof(FSegmentHeader, HeaderCrc));
+				return WriteAt(Handle, &Header, sizeof(Header), 0);
+			}
+
+			/** \brief Read exactly Size bytes at Offset, retrying short and interrupted reads. */
+			static FORCEINLINE bool ReadAt(const int Handle, void* Out, size_t Size, off_t Offset) noexcept
+			{
+				char* Bytes = static_cast<char*>(Out);
+				while(Size > 0)
+				{
+					const ssize_t Read = pread(Handle, Bytes, Size, Offset);
+					if(Read < 0 && errno == EINTR)
+					{
+						continue;
+					}
+					if(Read <= 0)
+					{
+						return false;
+					}
+					Bytes += Read;
+					Size -= static_cast<size_t>(Read);
+					Offset += Read;
+				}
+				return true;
+			}
+
+			/** \brief Write exactly Size bytes at Offset, retrying short and interrupted writes. */
+			static FORCEINLINE bool WriteAt(const int Handle, const void* In, size_t Size, off_t Offset) noexcept
+			{
+				const char* Bytes = static_cast<const char*>(In);
+				while(Size > 0)
+				{
+					const ssize_t Written = pwrite(Handle, Bytes, Size, Offset);
+					if(Written < 0 && errno == EINTR)
+					{
+						continue;
+					}
+					if(Written <= 0)
+					{
+						return false;
+					}
+					Bytes += Written;
+					Size -= static_cast<size_t>(Written);
+					Offset += Written;
+				}
+				return true;
+			}
+
+			/**
+			 * \brief Whether a directory entry is a segment file, SEGMENT#Pool#Index.ipcs.
+			 */
+			static FORCEINLINE bool IsSegmentName(const char* Name, const size_t Length) noexcept
+			{
+				constexpr size_t PrefixLength = sizeof(SEGMENT_FILE_PREFIX) - 1;
+				constexpr size_t ExtensionLength = sizeof(SEGMENT_FILE_EXTENSION) - 1;
+				return Length > PrefixLength + 1 + ExtensionLength &&
+					std::memcmp(Name, SEGMENT_FILE_PREFIX, PrefixLength) == 0 &&
+					Name[PrefixLength] == FILE_DELIM_CHAR &&
+					std::memcmp(Name + Length - ExtensionLength, SEGMENT_FILE_EXTENSION, ExtensionLength) == 0;
+			}
+		};
+
+		/**
+		 * \brief The writing end of a set of preallocated segment files that
+		 * are reused batch after batch, so a flush costs two pwrites instead
+		 * of creating a file that the reader then has to unlink. Each writer
+		 * process needs a pool name of its own.
+		 *
+		 * With FSegmentPoolConfig::bStreamRecords, NORMAL batches are appended
+		 * to one long lived segment per request type instead. The watermark in
+		 * its header moves every SEGMENT_COMMIT_BYTES, so the reader can start
+		 * on a large flush before it is all written. A stream is sealed READY
+		 * once it is full or older than RotateAfterMS.
+		 */
+		class FSegmentPool
+		{
+			struct FSegment
+			{
+				int Handle = -1;
+				uint64_t Sequence = 0;
+			};
+
+			struct FStream
+			{
+				size_t Segment = SIZE_MAX;
+				FSegmentHeader Header;
+				uint64_t OpenedAtNs = 0;
+			};
+			
+		public:
+			FSegmentPool()
+				: bIsOpen{false},
+				bIsStreaming{false},
+				BatchesWritten{0},
+				BytesWritten{0},
+				BatchesSpilled{0},
+				StreamsRotated{0},
+				NextSegment{0}
+			{
+			}
+
+			FSegmentPool(const FSegmentPool&) = delete;
+			FSegmentPool& operator=(const FSegmentPool&) = delete;
+
+			~FSegmentPool()
+			{
+				Close();
+			}
+
+			/**
+			 * \brief Create the pool's segment files, or adopt the ones a previous
+			 * run left behind. Segments still waiting on the reader are left as
+			 * they are, a stream left APPENDING is sealed so it can be drained.
+			 * \return Fails if it is already open or a segment couldn't be created.
+			 */
+			FORCEINLINE bool Open(const FSegmentPoolConfig& InConfig)
+			{
+				if(InConfig.Directory.empty() || InConfig.NumberOfSegments == 0 ||
+					InConfig.SegmentBytes == 0)
+				{
+					return false;
+				}
+				std::string PoolName = InConfig.PoolName;
+				if(PoolName.empty())
+				{
+					PoolName.resize(FUniqueID::InstanceDigits);
+					HexStatics::Write(&PoolName[0], FUniqueIDGenerator::GetInstanceID(),
+						FUniqueID::InstanceDigits);
+				}
+				
+				PoolLock.Lock();
+				if(bIsOpen.load(std::memory_order_acquire))
+				{
+					PoolLock.Unlock();
+					return false;
+				}
+				for(uint32_t i = 0; i < InConfig.NumberOfSegments; ++i)
+				{
+					std::string FileName = SEGMENT_FILE_PREFIX;
+					FileName += FILE_DELIM_CHAR;
+					FileName.append(PoolName);
+					FileName += FILE_DELIM_CHAR;
+					const size_t IndexStart = FileName.size();
+					FileName.resize(IndexStart + 4);
+					HexStatics::Write(&FileName[IndexStart], i, 4);
+					FileName.append(SEGMENT_FILE_EXTENSION);
+					
+					FSegment Segment;
+					Segment.Handle = open((std::filesystem::path(InConfig.Directory) / FileName).c_str(),
+						O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+					const off_t FileSize = static_cast<off_t>(SEGMENT_PAYLOAD_OFFSET + InConfig.SegmentBytes);
+					if(Segment.Handle < 0 ||
+						(posix_fallocate(Segment.Handle, 0, FileSize) != 0 &&
+							ftruncate(Segment.Handle, FileSize) != 0))
+					{
+						if(Segment.Handle >= 0)
+						{
+							close(Segment.Handle);
+						}
+						CloseSegments();
+						PoolLock.Unlock();
+						return false;
+					}
+					
+					FSegmentHeader Header;
+					if(!FSegmentFile::ReadHeader(Segment.Handle, Header))
+					{
+						Header = FSegmentHeader();
+						Header.State = ESegmentState::FREE;
+						FSegmentFile::WriteHeader(Segment.Handle, Header);
+					}
+					else if(Header.State == ESegmentState::APPENDING)
+					{
+						Header.State = ESegmentState::READY;
+						FSegmentFile::WriteHeader(Segment.Handle, Header);
+					}
+					Segment.Sequence = Header.Sequence;
+					Segments.push_back(Segment);
+				}
+				Config = InConfig;
+				Config.RotateAfterMS = (std::max)(Config.RotateAfterMS, static_cast<uint32_t>(1));
+				Directory = NormalizeDirectory(InConfig.Directory);
+				NextSegment = 0;
+				for(FStream& Stream : Streams)
+				{
+					Stream = FStream();
+				}
+				bIsStreaming.store(Config.bStreamRecords, std::memory_order_release);
+				bIsOpen.store(true, std::memory_order_release);
+				PoolLock.Unlock();
+				return true;
+			}
+
+			/**
+			 * \brief Stop writing to the pool, sealing any open streams. The
+			 * segment files stay for the next Open.
+			 */
+			FORCEINLINE void Close()
+			{
+				PoolLock.Lock();
+				for(FStream& Stream : Streams)
+				{
+					SealStream(Stream);
+				}
+				bIsOpen.store(false, std::memory_order_release);
+				bIsStreaming.store(false, std::memory_order_release);
+				CloseSegments();
+				PoolLock.Unlock();
+			}
+
+			/** \brief Whether the pool has its segments open. */
+			FORCEINLINE bool IsOpen() const noexcept
+			{
+				return bIsOpen.load(std::memory_order_acquire);
+			}
+
+			/** \brief Whether batches are appended to open streams rather than one per segment. */
+			FORCEINLINE bool IsStreaming() const noexcept
+			{
+				return bIsStreaming.load(std::memory_order_acquire);
+			}
+
+			/**
+			 * \brief Write a batch into the next free segment and mark it READY.
+			 * \param FileLocation Where the batch would have gone as a file, only
+			 * batches for the pool's own directory are taken.
+			 * \return Fails if the batch is for another directory, doesn't fit in
+			 * a segment, or every segment is still waiting on the reader. The
+			 * caller writes a file instead.
+			 */
+			FORCEINLINE bool Write(
+				const std::string& FileLocation,
+				const ERequestType RequestType,
+				const ERequestPriority Priority,
+				const std::string_view Payload)
+			{
+				if(!bIsOpen.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+				PoolLock.Lock();
+				if(!bIsOpen.load(std::memory_order_relaxed) ||
+					NormalizeDirectory(FileLocation) != Directory)
+				{
+					PoolLock.Unlock();
+					return false;
+				}
+				if(Payload.size() <= Config.SegmentBytes)
+				{
+					const size_t i = TakeFreeSegment();
+					FSegmentHeader Header;
+					// The payload has to be in place before the header says READY
+					if(i != SIZE_MAX &&
+						FSegmentFile::WriteAt(Segments[i].Handle, Payload.data(), Payload.size(),
+							SEGMENT_PAYLOAD_OFFSET))
+					{
+						Header.State = ESegmentState::READY;
+						Header.RequestType = RequestType;
+						Header.Priority = Priority;
+						Header.bIsStreamed = false;
+						Header.ID = FUniqueIDGenerator::GenerateFileID(RequestType);
+						Header.Sequence = ++Segments[i].Sequence;
+						Header.PayloadSize = Payload.size();
+						if(FSegmentFile::WriteHeader(Segments[i].Handle, Header))
+						{
+							PoolLock.Unlock();
+							BatchesWritten.fetch_add(1, std::memory_order_relaxed);
+							BytesWritten.fetch_add(Payload.size(), std::memory_order_relaxed);
+							return true;
+						}
+					}
+				}
+				PoolLock.Unlock();
+				BatchesSpilled.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			/**
+			 * \brief Append records to the open stream of their request type,
+			 * committing them as they go and rotating to a fresh segment when
+			 * the stream fills up.
+			 * \param Records Whole records, without a file footer.
+			 * \return How many bytes from the front of Records were committed. The
+			 * caller writes the rest as a file, which happens when every segment
+			 * is busy or a record is larger than a segment.
+			 */
+			FORCEINLINE size_t Append(
+				const std::string& FileLocation,
+				const ERequestType RequestType,
+				const std::string_view Records)
+			{
+				if(!bIsStreaming.load(std::memory_order_acquire))
+				{
+					return 0;
+				}
+				PoolLock.Lock();
+				if(!bIsStreaming.load(std::memory_order_relaxed) ||
+					NormalizeDirectory(FileLocation) != Directory)
+				{
+					PoolLock.Unlock();
+					return 0;
+				}
+				
+				FStream& Stream = Streams[static_cast<uint8_t>(RequestType)];
+				size_t Committed = 0;
+				while(Committed < Records.size())
+				{
+					if(Stream.Segment != SIZE_MAX && IsStreamDue(Stream))
+					{
+						SealStream(Stream);
+					}
+					if(Stream.Segment == SIZE_MAX && !OpenStream(Stream, RequestType))
+					{
+						break;
+					}
+					
+					// Commit whole records only, at most SEGMENT_COMMIT_BYTES at a time
+					FSegmentHeader& Header = Stream.Header;
+					std::string_view Slice = Records.substr(Committed, (std::min)(
+						Config.SegmentBytes - Header.PayloadSize, static_cast<uint64_t>(SEGMENT_COMMIT_BYTES)));
+					if(Slice.size() < Records.size() - Committed)
+					{
+						const size_t LastRecordEnd = RecordStatics::FindLastRecordEnd(Slice);
+						if(LastRecordEnd == 0)
+						{
+							if(Header.PayloadSize == 0)
+							{
+								// A record bigger than a whole segment
+								break;
+							}
+							SealStream(Stream);
+							continue;
+						}
+						Slice = Slice.substr(0, LastRecordEnd);
+					}
+					const int Handle = Segments[Stream.Segment].Handle;
+					if(!FSegmentFile::WriteAt(Handle, Slice.data(), Slice.size(),
+						SEGMENT_PAYLOAD_OFFSET + Header.PayloadSize))
+					{
+						break;
+					}
+					Header.PayloadSize += Slice.size();
+					if(!FSegmentFile::WriteHeader(Handle, Header))
+					{
+						Header.PayloadSize -= Slice.size();
+						break;
+					}
+					Committed += Slice.size();
+				}
+				PoolLock.Unlock();
+				
+				if(Committed > 0)
+				{
+					BatchesWritten.fetch_add(1, std::memory_order_relaxed);
+					BytesWritten.fetch_add(Committed, std::memory_order_relaxed);
+				}
+				if(Committed < Records.size())
+				{
+					BatchesSpilled.fetch_add(1, std::memory_order_relaxed);
+				}
+				return Committed;
+			}
+
+			/**
+			 * \brief Seal the streams that are past RotateAfterMS, so the reader
+			 * can recycle them even when nothing more is being flushed.
+			 */
+			FORCEINLINE void RotateIfDue()
+			{
+				if(!bIsStreaming.load(std::memory_order_acquire))
+				{
+					return;
+				}
+				PoolLock.Lock();
+				for(FStream& Stream : Streams)
+				{
+					if(Stream.Segment != SIZE_MAX && IsStreamDue(Stream))
+					{
+						SealStream(Stream);
+					}
+				}
+				PoolLock.Unlock();
+			}
+
+			/** \brief Get a snapshot of the pool's counters and segment states. */
+			FORCEINLINE FSegmentPoolStats GetStats()
+			{
+				FSegmentPoolStats Stats;
+				Stats.BatchesWritten = BatchesWritten.load(std::memory_order_relaxed);
+				Stats.BytesWritten = BytesWritten.load(std::memory_order_relaxed);
+				Stats.BatchesSpilled = BatchesSpilled.load(std::memory_order_relaxed);
+				Stats.StreamsRotated = StreamsRotated.load(std::memory_order_relaxed);
+				PoolLock.Lock();
+				Stats.NumberOfSegments = Segments.size();
+				for(const FSegment& Segment : Segments)
+				{
+					FSegmentHeader Header;
+					if(FSegmentFile::ReadHeader(Segment.Handle, Header) &&
+						Header.State == ESegmentState::FREE)
+					{
+						++Stats.SegmentsFree;
+					}
+				}
+				PoolLock.Unlock();
+				return Stats;
+			}
+
+		private:
+			/**
+			 * \brief Normalize a directory so "dir" and "dir/" compare equal.
+			 */
+			static FORCEINLINE std::filesystem::path NormalizeDirectory(const std::string& InDirectory)
+			{
+				std::filesystem::path Normal = std::filesystem::path(InDirectory).lexically_normal();
+				if(!Normal.has_filename() && Normal.has_relative_path())
+				{
+					Normal = Normal.parent_path();
+				}
+				return Normal;
+			}
+
+			/**
+			 * \brief Find the next FREE segment, round robin.
+			 * \return SIZE_MAX if every segment is busy.
+			 */
+			FORCEINLINE size_t TakeFreeSegment()
+			{
+				for(size_t n = 0; n < Segments.size(); ++n)
+				{
+					const size_t i = (NextSegment + n) % Segments.size();
+					FSegmentHeader Header;
+					if(FSegmentFile::ReadHeader(Segments[i].Handle, Header) &&
+						Header.State == ESegmentState::FREE)
+					{
+						NextSegment = i + 1;
+						return i;
+					}
+				}
+				return SIZE_MAX;
+			}
+
+			/** \brief Take a free segment and start appending to it. */
+			FORCEINLINE bool OpenStream(FStream& Stream, const ERequestType RequestType)
+			{
+				const size_t i = TakeFreeSegment();
+				if(i == SIZE_MAX)
+				{
+					return false;
+				}
+				FSegmentHeader& Header = Stream.Header;
+				Header = FSegmentHeader();
+				Header.State = ESegmentState::APPENDING;
+				Header.RequestType = RequestType;
+				Header.Priority = ERequestPriority::NORMAL;
+				Header.bIsStreamed = true;
+				Header.ID = FUniqueIDGenerator::GenerateFileID(RequestType);
+				Header.Sequence = ++Segments[i].Sequence;
+				Header.PayloadSize = 0;
+				if(!FSegmentFile::WriteHeader(Segments[i].Handle, Header))
+				{
+					return false;
+				}
+				Stream.Segment = i;
+				Stream.OpenedAtNs = FUniqueIDGenerator::GetMonotonicTimeNs();
+				return true;
+			}
+
+			/**
+			 * \brief Hand a stream to the reader, an empty one goes straight back to FREE.
+			 */
+			FORCEINLINE void SealStream(FStream& Stream)
+			{
+				if(Stream.Segment == SIZE_MAX)
+				{
+					return;
+				}
+				Stream.Header.State = (Stream.Header.PayloadSize > 0) ?
+					(ESegmentState::READY) : (ESegmentState::FREE);
+				FSegmentFile::WriteHeader(Segments[Stream.Segment].Handle, Stream.Header);
+				Stream.Segment = SIZE_MAX;
+				StreamsRotated.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			/** \brief Whether a stream is full or old enough to be rotated. */
+			FORCEINLINE bool IsStreamDue(const FStream& Stream) const noexcept
+			{
+				return Stream.Header.PayloadSize >= Config.SegmentBytes ||
+					FUniqueIDGenerator::GetMonotonicTimeNs() - Stream.OpenedAtNs >=
+						Config.RotateAfterMS * 1000000ull;
+			}
+			
+			FORCEINLINE void CloseSegments()
+			{
+				for(const FSegment& Segment : Segments)
+				{
+					close(Segment.Handle);
+				}
+				Segments.clear();
+			}
+			
+			std::atomic<bool> bIsOpen;
+			std::atomic<bool> bIsStreaming;
+			std::atomic<uint64_t> BatchesWritten;
+			std::atomic<uint64_t> BytesWritten;
+			std::atomic<uint64_t> BatchesSpilled;
+			std::atomic<uint64_t> StreamsRotated;
+			FSpinLoop<true> PoolLock;
+			FSegmentPoolConfig Config;
+			std::filesystem::path Directory;
+			std::vector<FSegment> Segments;
+			size_t NextSegment;
+			/** The open stream of each @link ERequestType */
+			FStream Streams[3];
+		};
+
+		/**
+		 * \brief The reading end of every segment pool in one directory. It
+		 * claims READY segments by marking them CONSUMING and frees them once
+		 * their batch is handled. The committed records of a stream are handed
+		 * out as they appear, without touching the header the writer owns, and
+		 * the stream is claimed like any other segment once it is sealed. How
+		 * far a stream has been handled is kept in a @link FSegmentCursor file
+		 * beside it, so a restarted reader doesn't hand it out again. New
+		 * pools are only looked for every SEGMENT_RESCAN_INTERVAL_MS, otherwise
+		 * a poll is one pread per segment.
+		 */
+		class FSegmentReader
+		{
+			struct FSegment
+			{
+				int Handle = -1;
+				/** The segment's @link FSegmentCursor file, opened on first use */
+				int CursorHandle = -1;
+				std::string Path;
+				bool bClaimed = false;
+				/** Whether the range that ends the segment has been handled */
+				bool bIsLastFinished = false;
+				/** Which use of the segment Cursor belongs to */
+				uint64_t Sequence = 0;
+				/** How far into a stream has been handed out */
+				uint64_t Cursor = 0;
+				/** How far into a stream has been handled, with no gaps */
+				uint64_t Consumed = 0;
+				/** Where the last range ends, once it is handed out */
+				uint64_t End = 0;
+				/** Ranges handled ahead of Consumed, start -> end */
+				std::map<uint64_t, uint64_t> Finished;
+			};
+			
+		public:
+			/**
+			 * \brief A run of records in a segment that has been handed out.
+			 */
+			struct FSegmentRange
+			{
+				uint32_t Index = 0;
+				/** Which use of the segment the range belongs to */
+				uint64_t Sequence = 0;
+				uint64_t Offset = 0;
+				uint64_t Size = 0;
+				/** Stream records, they have no file footer */
+				bool bIsStreamed = false;
+				/** The segment is freed once this range is handled */
+				bool bIsLast = false;
+			};
+
+			struct FReadySegment
+			{
+				std::string Path;
+				FUniqueID ID;
+				ERequestPriority Priority = ERequestPriority::NORMAL;
+				FSegmentRange Range;
+			};
+
+			FSegmentReader() = default;
+			FSegmentReader(const FSegmentReader&) = delete;
+			FSegmentReader& operator=(const FSegmentReader&) = delete;
+
+			~FSegmentReader()
+			{
+				Close();
+			}
+
+			/**
+			 * \brief Claim the READY segments of one request type in Directory,
+			 * and the newly committed records of its open streams.
+			 * \return Whether a stream of that type is still being written.
+			 */
+			FORCEINLINE bool Poll(
+				const std::string& Directory,
+				const ERequestType RequestType,
+				std::vector<FReadySegment>& OutSegments)
+			{
+				ReaderLock.Lock();
+				const uint64_t NowNs = FUniqueIDGenerator::GetMonotonicTimeNs();
+				if(LastListNs == 0 || NowNs - LastListNs >= SEGMENT_RESCAN_INTERVAL_MS * 1000000ull)
+				{
+					OpenNewSegments(Directory);
+					LastListNs = NowNs;
+				}
+				bool bIsTailing = false;
+				for(size_t i = 0; i < Segments.size(); ++i)
+				{
+					FSegment& Segment = Segments[i];
+					FSegmentHeader Header;
+					if(Segment.bClaimed ||
+						!FSegmentFile::ReadHeader(Segment.Handle, Header) ||
+						Header.RequestType != RequestType ||
+						(Header.State != ESegmentState::READY && Header.State != ESegmentState::APPENDING))
+					{
+						continue;
+					}
+					if(Segment.Sequence != Header.Sequence)
+					{
+						ResetProgress(Segment, Header.Sequence);
+					}
+					if(!Header.bIsStreamed)
+					{
+						Segment.Cursor = 0;
+					}
+					
+					FReadySegment Ready;
+					Ready.Path = Segment.Path;
+					Ready.ID = Header.ID;
+					Ready.Priority = Header.Priority;
+					Ready.Range.Index = static_cast<uint32_t>(i);
+					Ready.Range.Sequence = Header.Sequence;
+					Ready.Range.Offset = Segment.Cursor;
+					Ready.Range.Size = Header.PayloadSize - (std::min)(Segment.Cursor, Header.PayloadSize);
+					Ready.Range.bIsStreamed = Header.bIsStreamed;
+					if(Header.State == ESegmentState::APPENDING)
+					{
+						bIsTailing = true;
+						if(Ready.Range.Size == 0)
+						{
+							continue;
+						}
+					}
+					else
+					{
+						Header.State = ESegmentState::CONSUMING;
+						if(!FSegmentFile::WriteHeader(Segment.Handle, Header))
+						{
+							continue;
+						}
+						Segment.bClaimed = true;
+						Segment.End = Header.PayloadSize;
+						Ready.Range.bIsLast = true;
+					}
+					Segment.Cursor += Ready.Range.Size;
+					OutSegments.push_back(std::move(Ready));
+				}
+				ReaderLock.Unlock();
+				return bIsTailing;
+			}
+
+			/**
+			 * \brief Copy out a range that was handed out by @link Poll.
+			 */
+			FORCEINLINE bool ReadRange(const FSegmentRange& Range, std::string& OutText)
+			{
+				ReaderLock.Lock();
+				const int Handle = (Range.Index < Segments.size()) ? (Segments[Range.Index].Handle) : (-1);
+				ReaderLock.Unlock();
+				OutText.resize(Range.Size);
+				return Handle >= 0 && (Range.Size == 0 ||
+					FSegmentFile::ReadAt(Handle, &OutText[0], OutText.size(),
+						SEGMENT_PAYLOAD_OFFSET + Range.Offset));
+			}
+
+			/**
+			 * \brief Give back a range that couldn't be read, so a later poll hands
+			 * it out again. A stream is rewound to it, the ranges after it are
+			 * handed out again as well.
+			 */
+			FORCEINLINE void Unclaim(const FSegmentRange& Range)
+			{
+				ReaderLock.Lock();
+				if(Range.Index < Segments.size())
+				{
+					FSegment& Segment = Segments[Range.Index];
+					FSegmentHeader Header;
+					if(Range.bIsLast && FSegmentFile::ReadHeader(Segment.Handle, Header))
+					{
+						Header.State = ESegmentState::READY;
+						if(FSegmentFile::WriteHeader(Segment.Handle, Header))
+						{
+							Segment.bClaimed = false;
+						}
+					}
+					Segment.Cursor = (std::min)(Segment.Cursor, Range.Offset);
+				}
+				ReaderLock.Unlock();
+			}
+
+			/**
+			 * \brief Mark a range handed out by @link Poll as handled. A stream
+			 * remembers how far it has been handled, without gaps, so a reader
+			 * that starts again resumes from there. Once every range up to the
+			 * end of a claimed segment is handled it goes back to its writer.
+			 */
+			FORCEINLINE void Finish(const FSegmentRange& Range)
+			{
+				ReaderLock.Lock();
+				if(Range.Index < Segments.size() && Segments[Range.Index].Sequence == Range.Sequence)
+				{
+					FSegment& Segment = Segments[Range.Index];
+					Segment.bIsLastFinished |= Range.bIsLast;
+					Segment.Finished.emplace(Range.Offset, Range.Offset + Range.Size);
+					const uint64_t WasConsumed = Segment.Consumed;
+					for(auto It = Segment.Finished.begin();
+						It != Segment.Finished.end() && It->first <= Segment.Consumed;
+						It = Segment.Finished.erase(It))
+					{
+						Segment.Consumed = (std::max)(Segment.Consumed, It->second);
+					}
+					if(Segment.bClaimed && Segment.bIsLastFinished && Segment.Consumed >= Segment.End)
+					{
+						ReleaseUnlocked(Segment);
+					}
+					else if(Range.bIsStreamed && Segment.Consumed != WasConsumed)
+					{
+						SaveCursorUnlocked(Segment);
+					}
+				}
+				ReaderLock.Unlock();
+			}
+
+			/**
+			 * \brief Let go of every segment. Ones that were claimed but never
+			 * released are READY again the next time they are polled, and a
+			 * stream resumes after the records that were handled.
+			 */
+			FORCEINLINE void Close()
+			{
+				ReaderLock.Lock();
+				for(const FSegment& Segment : Segments)
+				{
+					close(Segment.Handle);
+					if(Segment.CursorHandle >= 0)
+					{
+						close(Segment.CursorHandle);
+					}
+				}
+				Segments.clear();
+				KnownNames.clear();
+				LastListNs = 0;
+				ReaderLock.Unlock();
+			}
+
+		private:
+			/**
+			 * \brief Open the segment files that appeared since the last listing.
+			 * A segment left CONSUMING is from a reader that never finished it.
+			 */
+			FORCEINLINE void OpenNewSegments(const std::string& Directory)
+			{
+				const std::filesystem::path Root(Directory);
+				ForEachDirectoryEntry(Directory,
+					[this, &Root](const char* Name, const size_t Length, const EDirectoryEntryType Type)
+					{
+						if(Type != EDirectoryEntryType::FILE ||
+							!FSegmentFile::IsSegmentName(Name, Length) ||
+							!KnownNames.emplace(Name, Length).second)
+						{
+							return;
+						}
+						FSegment Segment;
+						Segment.Path = (Root / std::string_view(Name, Length)).string();
+						Segment.Handle = open(Segment.Path.c_str(), O_RDWR | O_CLOEXEC);
+						if(Segment.Handle < 0)
+						{
+							KnownNames.erase(std::string(Name, Length));
+							return;
+						}
+						FSegmentHeader Header;
+						if(FSegmentFile::ReadHeader(Segment.Handle, Header))
+						{
+							if(Header.State == ESegmentState::CONSUMING)
+							{
+								Header.State = ESegmentState::READY;
+								FSegmentFile::WriteHeader(Segment.Handle, Header);
+							}
+							if(Header.bIsStreamed && Header.State != ESegmentState::FREE)
+							{
+								LoadCursor(Segment, Header);
+							}
+						}
+						Segments.push_back(std::move(Segment));
+					});
+			}
+
+			/**
+			 * \brief Start over on a new use of a segment.
+			 */
+			static FORCEINLINE void ResetProgress(FSegment& Segment, const uint64_t Sequence)
+			{
+				Segment.Sequence = Sequence;
+				Segment.Cursor = 0;
+				Segment.Consumed = 0;
+				Segment.End = 0;
+				Segment.bIsLastFinished = false;
+				Segment.Finished.clear();
+			}
+
+			/**
+			 * \brief Pick a stream up where the last reader left off, if its
+			 * cursor is for this use of the segment.
+			 */
+			static FORCEINLINE void LoadCursor(FSegment& Segment, const FSegmentHeader& Header)
+			{
+				Segment.CursorHandle = open((Segment.Path + SEGMENT_CURSOR_EXTENSION).c_str(),
+					O_RDWR | O_CLOEXEC);
+				FSegmentCursor Cursor;
+				if(Segment.CursorHandle < 0 ||
+					!FSegmentFile::ReadAt(Segment.CursorHandle, &Cursor, sizeof(Cursor), 0) ||
+					Cursor.Magic != SEGMENT_MAGIC ||
+					Cursor.CursorCrc != FCrc32C::Compute(&Cursor, offsetof(FSegmentCursor, CursorCrc)) ||
+					Cursor.Sequence != Header.Sequence)
+				{
+					return;
+				}
+				ResetProgress(Segment, Header.Sequence);
+				Segment.Cursor = (std::min)(Cursor.Consumed, Header.PayloadSize);
+				Segment.Consumed = Segment.Cursor;
+			}
+
+			/**
+			 * \brief Write how far a stream has been handled next to it.
+			 */
+			static FORCEINLINE void SaveCursorUnlocked(FSegment& Segment)
+			{
+				if(Segment.CursorHandle < 0)
+				{
+					Segment.CursorHandle = open((Segment.Path + SEGMENT_CURSOR_EXTENSION).c_str(),
+						O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+					if(Segment.CursorHandle < 0)
+					{
+						return;
+					}
+				}
+				FSegmentCursor Cursor = {};
+				Cursor.Magic = SEGMENT_MAGIC;
+				Cursor.Sequence = Segment.Sequence;
+				Cursor.Consumed = Segment.Consumed;
+				Cursor.CursorCrc = FCrc32C::Compute(&Cursor, offsetof(FSegmentCursor, CursorCrc));
+				FSegmentFile::WriteAt(Segment.CursorHandle, &Cursor, sizeof(Cursor), 0);
+			}
+
+			/**
+			 * \brief Hand a claimed segment back to its writer.
+			 */
+			static FORCEINLINE void ReleaseUnlocked(FSegment& Segment)
+			{
+				FSegmentHeader Header;
+				if(FSegmentFile::ReadHeader(Segment.Handle, Header))
+				{
+					Header.State = ESegmentState::FREE;
+					Header.PayloadSize = 0;
+					FSegmentFile::WriteHeader(Segment.Handle, Header);
+				}
+				Segment.bClaimed = false;
+				ResetProgress(Segment, Segment.Sequence);
+			}
+			
+			FSpinLoop<true> ReaderLock;
+			std::vector<FSegment> Segments;
+			std::unordered_set<std::string> KnownNames;
+			uint64_t LastListNs = 0;
+		};
+#endif
+
+		/**
+		 * \brief Processes the GET and SET files in the AWS inbox in four stages
+		 * joined by @link TBoundedQueue, so that backend latency overlaps with
+		 * reading and writing files:
+		 * ingest (the AWS read threads) -> parse -> backend batch calls -> serialize.
+		 */
+		class FAWSRequestPipeline
+		{
+			struct FIngestedFile
+			{
+				std::string Path;
+				ERequestType RequestType = ERequestType::GET;
+				/** Given to every GET in the file, so its response takes the same lane back */
+				ERequestPriority Priority = ERequestPriority::NORMAL;
+				std::string Producer;
+#if IPC_HAS_SEGMENT_FILES
+				/** Set when the records are in a segment rather than a file */
+				FSegmentReader* Segments = nullptr;
+				FSegmentReader::FSegmentRange SegmentRange;
+#endif
+			};
+
+			/**
+			 * The batches of one ingested file that haven't finished yet, the file
+			 * is only removed once every row in them has, see @link ReleaseTicket
+			 */
+			struct FFileTicket
+			{
+				FIngestedFile File;
+				/** One for the parse stage, plus one per batch still in flight */
+				std::atomic<size_t> References{1};
+				/** A row never finished, so the file is left to be ingested again */
+				std::atomic<bool> bKeepFile{false};
+				/** Only some records verified, so the file is set aside rather than removed */
+				bool bIsPartial = false;
+			};
+
+			/** A file of one parallel parse round */
+			struct FParseFile
+			{
+				FIngestedFile File;
+				std::string Text;
+				size_t RecordsEnd = 0;
+				/** Gone, or given back to be ingested again, so it has no chunks */
+				bool bIsSkipped = false;
+				/** Failed its integrity check for good, only what verified is used */
+				bool bIsPartial = false;
+			};
+
+			/** Whole records of one file, parsed by whichever parse worker took them */
+			struct FParseChunk
+			{
+				size_t FileIndex = 0;
+				size_t Start = 0;
+				size_t End = 0;
+				size_t NumberOfRecords = 0;
+				std::vector<FGetRequest> GetRequests;
+				std::vector<FPlayerAttributeList> SetRequests;
+			};
+
+			struct FRequestBatch
+			{
+				ERequestType RequestType = ERequestType::GET;
+				std::vector<FGetRequest> GetRequests;
+				std::vector<FPlayerAttributeList> SetRequests;
+				std::shared_ptr<FFileTicket> Ticket;
+			};
+
+			struct FResponseBatch
+			{
+				std::vector<FGetRequest> GetRequests;
+				std::vector<FPlayerAttributeList> Stored;
+				std::vector<EBackendResult> Results;
+				std::shared_ptr<FFileTicket> Ticket;
+			};
+
+			struct FFileClaim
+			{
+				uint8_t Attempts = 0;
+			};
+
+			struct FCandidateFile
+			{
+				std::string Path;
+				FUniqueID ID;
+				ERequestPriority Priority = ERequestPriority::NORMAL;
+				uint64_t Bytes = 0;
+#if IPC_HAS_SEGMENT_FILES
+				FSegmentReader* Segments = nullptr;
+				FSegmentReader::FSegmentRange SegmentRange;
+#endif
+			};
+
+			/**
+			 * \brief Scheduling state of one producer, indexed by @link ERequestType
+			 * where it is kept per type, since each type is ingested on its own thread.
+			 */
+			struct FProducerState
+			{
+				uint32_t Weight = 1;
+				uint64_t Deficit[3] = {0, 0, 0};
+				size_t PendingFiles[3] = {0, 0, 0};
+				uint64_t PendingBytes[3] = {0, 0, 0};
+				uint64_t OldestPendingNs[3] = {0, 0, 0};
+				uint64_t LastScanNs = 0;
+				uint64_t FilesIngested = 0;
+				/** Files scanned but not yet queued, in the order they'll be consumed */
+				std::vector<FCandidateFile> Pending[3];
+				FDirectoryScanner Scanners[3];
+#if IPC_HAS_SEGMENT_FILES
+				FSegmentReader Segments;
+#endif
+			};
+
+			struct FStageCounters
+			{
+				std::atomic<uint64_t> ItemsProcessed{0};
+				std::atomic<uint64_t> RowsProcessed{0};
+				std::atomic<uint64_t> BusyNs{0};
+				std::atomic<uint64_t> StalledNs{0};
+
+				FORCEINLINE void Reset() noexcept
+				{
+					ItemsProcessed.store(0, std::memory_order_relaxed);
+					RowsProcessed.store(0, std::memory_order_relaxed);
+					BusyNs.store(0, std::memory_order_relaxed);
+					StalledNs.store(0, std::memory_order_relaxed);
+				}
+
+				FORCEINLINE void Record(
+					const uint64_t Rows,
+					const std::chrono::steady_clock::time_point Start,
+					const uint64_t Stalled,
+					const uint64_t Items = 1) noexcept
+				{
+					const uint64_t Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+						std::chrono::steady_clock::now() - Start).count();
+					ItemsProcessed.fetch_add(Items, std::memory_order_relaxed);
+					RowsProcessed.fetch_add(Rows, std::memory_order_relaxed);
+					BusyNs.fetch_add(Elapsed - (std::min)(Elapsed, Stalled), std::memory_order_relaxed);
+					StalledNs.fetch_add(Stalled, std::memory_order_relaxed);
+				}
+
+				FORCEINLINE void Snapshot(FPipelineStageStats& Out) const noexcept
+				{
+					Out.ItemsProcessed = ItemsProcessed.load(std::memory_order_relaxed);
+					Out.RowsProcessed = RowsProcessed.load(std::memory_order_relaxed);
+					Out.BusyNs = BusyNs.load(std::memory_order_relaxed);
+					Out.StalledNs = StalledNs.load(std::memory_order_relaxed);
+				}
+			};
+			
+			/** A file that fails its integrity check is retried this many times in
+			 * case it was still being written, then what verified is used */
+			static constexpr uint8_t MaxIngestAttempts = 3;
+			
+		public:
+			FAWSRequestPipeline()
+				: bIsRunning{false},
+				bIsStopping{false},
+				NumberOfRunningWorkers{0},
+				RowsThrottled{0},
+				RowsFailed{0}
+			{
+			}
+
+			/**
+			 * \brief Start the parse, backend and serialize threads.
+			 * \return Fails if the pipeline is already running or has no inbox.
+			 */
+			FORCEINLINE bool Start(const FAWSProcessorConfig& InConfig)
+			{
+				if(InConfig.InboxDirectory.empty() ||
+					bIsRunning.exchange(true, std::memory_order_acq_rel))
+				{
+					return false;
+				}
+				Config = InConfig;
+				Config.MaxInFlightBatches = (std::max)(Config.MaxInFlightBatches, static_cast<size_t>(1));
+				Config.BatchSize = (std::max)(Config.BatchSize, static_cast<size_t>(1));
+				Config.QueueCapacity = (std::max)(Config.QueueCapacity, static_cast<size_t>(1));
+				Config.FairShareQuantumBytes = (std::max)(Config.FairShareQuantumBytes,
+					static_cast<uint64_t>(1));
+				if(Config.NumberOfParseWorkers == 0)
+				{
+					Config.NumberOfParseWorkers = (std::max)(
+						static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+				}
+				IngestQueue.Reset(Config.QueueCapacity);
+				RequestQueues.clear();
+				for(size_t i = 0; i < Config.MaxInFlightBatches; ++i)
+				{
+					RequestQueues.push_back(std::make_unique<TBoundedQueue<FRequestBatch>>());
+					RequestQueues.back()->Reset(Config.QueueCapacity);
+				}
+				ResponseQueue.Reset(Config.QueueCapacity);
+				bIsStopping.store(false, std::memory_order_release);
+				for(FStageCounters* Counters : {&IngestCounters, &ParseCounters,
+					&BackendCounters, &SerializeCounters})
+				{
+					Counters->Reset();
+				}
+				RowsThrottled.store(0, std::memory_order_relaxed);
+				RowsFailed.store(0, std::memory_order_relaxed);
+				ClaimLock.Lock();
+				Claims.clear();
+				ClaimLock.Unlock();
+				// The inbox may have moved, every producer is scanned afresh
+				ProducerLock.Lock();
+				for(auto& Producer : Producers)
+				{
+					for(size_t i = 0; i < 3; ++i)
+					{
+						Producer.second.Scanners[i] = FDirectoryScanner();
+						Producer.second.Pending[i].clear();
+						Producer.second.Deficit[i] = 0;
+					}
+#if IPC_HAS_SEGMENT_FILES
+					Producer.second.Segments.Close();
+#endif
+				}
+				ProducerLock.Unlock();
+
+				NumberOfRunningWorkers.store(Config.MaxInFlightBatches, std::memory_order_release);
+				// The parse stage's own thread is one of its workers
+				ParseWorkers.Start(Config.NumberOfParseWorkers - 1);
+				Threads.emplace_back([this]() { RunParseStage(); });
+				for(size_t i = 0; i < Config.MaxInFlightBatches; ++i)
+				{
+					Threads.emplace_back([this, i]() { RunBackendStage(*RequestQueues[i]); });
+				}
+				Threads.emplace_back([this]() { RunSerializeStage(); });
+				return true;
+			}
+
+			/**
+			 * \brief Stop taking new files, finish everything already ingested and
+			 * join the threads.
+			 */
+			FORCEINLINE void Stop()
+			{
+				if(!bIsRunning.load(std::memory_order_acquire))
+				{
+					return;
+				}
+				// Each stage closes the queue after it once its input runs dry
+				bIsStopping.store(true, std::memory_order_release);
+				IngestQueue.Close();
+				for(std::thread& Thread : Threads)
+				{
+					Thread.join();
+				}
+				Threads.clear();
+				ParseWorkers.Stop();
+				bIsRunning.store(false, std::memory_order_release);
+			}
+
+			/**
+			 * \brief Queue the files of one request type from the inbox and every
+			 * producer's subdirectory of it. Each directory is scanned incrementally,
+			 * only files new since the last call are looked at. Producers take turns by
+			 * deficit round-robin over file bytes, so one busy producer can't
+			 * starve the rest, and each producer's files go in
+			 * @link ERequestPriority::HIGH first then in order. Called by the AWS
+			 * read threads.
+			 * \return Whether files were left behind because this call queued as
+			 * many as the queue holds.
+			 */
+			FORCEINLINE bool Ingest(const ERequestType RequestType)
+			{
+				if(!bIsRunning.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+				const auto Start = std::chrono::steady_clock::now();
+				const uint8_t TypeIndex = static_cast<uint8_t>(RequestType);
+				
+				// Pick up producers that created their own subdirectory
+				std::vector<std::string> Names;
+				ForEachDirectoryEntry(Config.InboxDirectory,
+					[&Names](const char* Name, const size_t Length, const EDirectoryEntryType Type)
+					{
+						if(Type == EDirectoryEntryType::DIRECTORY)
+						{
+							Names.emplace_back(Name, Length);
+						}
+					});
+				ProducerLock.Lock();
+				Producers[std::string()];
+				for(const std::string& Name : Names)
+				{
+					Producers[Name];
+				}
+				Names.clear();
+				std::vector<FProducerState*> States;
+				for(auto& Producer : Producers)
+				{
+					Names.push_back(Producer.first);
+					States.push_back(&Producer.second);
+				}
+				ProducerLock.Unlock();
+
+				// Only files that are new since the last scan are sized
+				std::vector<std::vector<FCandidateFile>> NewFiles(Names.size());
+				bool bIsTailing = false;
+				const uint64_t NowNs = FUniqueIDGenerator::GetMonotonicTimeNs();
+				for(size_t i = 0; i < Names.size(); ++i)
+				{
+					ScanProducer(Names[i], RequestType, *States[i], NewFiles[i], bIsTailing);
+				}
+				bIsTailingStream[TypeIndex].store(bIsTailing, std::memory_order_relaxed);
+
+				// Deficit round-robin, each round a producer may take Quantum x
+				// weight bytes, its weight growing with the log of its backlog
+				std::vector<FIngestedFile> Admitted;
+				size_t Budget = Config.QueueCapacity;
+				bool bLeftFiles = false;
+				ProducerLock.Lock();
+				std::vector<size_t> Heads(Names.size(), 0);
+				size_t NumberActive = 0;
+				for(size_t i = 0; i < Names.size(); ++i)
+				{
+					FProducerState& State = *States[i];
+					std::vector<FCandidateFile>& Pending = State.Pending[TypeIndex];
+					const size_t Merged = Pending.size();
+					Pending.insert(Pending.end(), std::make_move_iterator(NewFiles[i].begin()),
+						std::make_move_iterator(NewFiles[i].end()));
+					std::inplace_merge(Pending.begin(), Pending.begin() + Merged, Pending.end(),
+						&IsConsumedBefore);
+					
+					State.PendingFiles[TypeIndex] = Pending.size();
+					State.PendingBytes[TypeIndex] = 0;
+					State.OldestPendingNs[TypeIndex] = 0;
+					for(const FCandidateFile& Candidate : Pending)
+					{
+						State.PendingBytes[TypeIndex] += Candidate.Bytes;
+						if(State.OldestPendingNs[TypeIndex] == 0 ||
+							Candidate.ID.TimeNs < State.OldestPendingNs[TypeIndex])
+						{
+							State.OldestPendingNs[TypeIndex] = Candidate.ID.TimeNs;
+						}
+					}
+					State.LastScanNs = NowNs;
+					if(Pending.empty())
+					{
+						State.Deficit[TypeIndex] = 0;
+					}
+					else
+					{
+						++NumberActive;
+					}
+				}
+				
+				size_t Turn = NextTurn[TypeIndex];
+				while(NumberActive > 0 && Budget > 0)
+				{
+					const size_t i = Turn++ % Names.size();
+					std::vector<FCandidateFile>& Queue = States[i]->Pending[TypeIndex];
+					if(Heads[i] == Queue.size())
+					{
+						continue;
+					}
+					FProducerState& State = *States[i];
+					const uint64_t Backlog = Queue.size() - Heads[i];
+					uint64_t Weight = State.Weight;
+					for(uint64_t Remaining = Backlog; Remaining > 1; Remaining >>= 1)
+					{
+						Weight += State.Weight;
+					}
+					State.Deficit[TypeIndex] += Config.FairShareQuantumBytes * Weight;
+					while(Heads[i] < Queue.size() && Budget > 0 &&
+						Queue[Heads[i]].Bytes <= State.Deficit[TypeIndex])
+					{
+						FCandidateFile& Candidate = Queue[Heads[i]++];
+						State.Deficit[TypeIndex] -= Candidate.Bytes;
+						++State.FilesIngested;
+						--Budget;
+						FIngestedFile File;
+						File.Path = std::move(Candidate.Path);
+						File.RequestType = RequestType;
+						File.Priority = Candidate.Priority;
+						File.Producer = Names[i];
+#if IPC_HAS_SEGMENT_FILES
+						File.Segments = Candidate.Segments;
+						File.SegmentRange = Candidate.SegmentRange;
+#endif
+						Admitted.push_back(std::move(File));
+					}
+					if(Heads[i] == Queue.size())
+					{
+						// An emptied queue doesn't bank its unused share
+						State.Deficit[TypeIndex] = 0;
+						--NumberActive;
+					}
+				}
+				NextTurn[TypeIndex] = Turn;
+				bLeftFiles = NumberActive > 0;
+				for(size_t i = 0; i < Names.size(); ++i)
+				{
+					std::vector<FCandidateFile>& Pending = States[i]->Pending[TypeIndex];
+					Pending.erase(Pending.begin(), Pending.begin() + Heads[i]);
+				}
+				ProducerLock.Unlock();
+				if(Admitted.empty())
+				{
+					return bLeftFiles;
+				}
+
+				uint64_t Stalled = 0;
+				for(FIngestedFile& File : Admitted)
+				{
+					IngestQueue.Push(std::move(File), Stalled);
+				}
+				IngestCounters.Record(Admitted.size(), Start, Stalled);
+				return bLeftFiles;
+			}
+
+			/**
+			 * \brief Whether a segment stream of this type was still being written
+			 * at the last ingest, the read thread then polls it more often.
+			 */
+			FORCEINLINE bool IsTailingStream(const ERequestType RequestType) const noexcept
+			{
+				return bIsTailingStream[static_cast<uint8_t>(RequestType)].load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * \brief Give a producer a bigger or smaller share of the ingest, it
+			 * doesn't need to have created its subdirectory yet.
+			 * \param Weight How many quanta it gets per round, at least 1.
+			 */
+			FORCEINLINE void RegisterProducer(const std::string& Name, const uint32_t Weight)
+			{
+				ProducerLock.Lock();
+				Producers[Name].Weight = (std::max)(Weight, static_cast<uint32_t>(1));
+				ProducerLock.Unlock();
+			}
+
+			/**
+			 * \brief The backlog of every producer as of its last scan.
+			 */
+			FORCEINLINE void GetProducerStats(std::vector<FProducerStats>& OutStats)
+			{
+				ProducerLock.Lock();
+				for(const auto& Producer : Producers)
+				{
+					const FProducerState& State = Producer.second;
+					FProducerStats Stats;
+					Stats.Name = Producer.first;
+					Stats.Weight = State.Weight;
+					Stats.FilesIngested = State.FilesIngested;
+					uint64_t OldestNs = 0;
+					for(size_t i = 0; i < 3; ++i)
+					{
+						Stats.PendingFiles += State.PendingFiles[i];
+						Stats.PendingBytes += State.PendingBytes[i];
+						if(State.OldestPendingNs[i] != 0 &&
+							(OldestNs == 0 || State.OldestPendingNs[i] < OldestNs))
+						{
+							OldestNs = State.OldestPendingNs[i];
+						}
+					}
+					if(OldestNs != 0 && State.LastScanNs > OldestNs)
+					{
+						Stats.LagMS = (State.LastScanNs - OldestNs) / 1000000;
+					}
+					OutStats.push_back(std::move(Stats));
+				}
+				ProducerLock.Unlock();
+			}
+
+			/**
+			 * \brief Snapshot the stage counters and queue depths.
+			 */
+			FORCEINLINE FAWSProcessorStats GetStats() const
+			{
+				FAWSProcessorStats Stats;
+				IngestCounters.Snapshot(Stats.Ingest);
+				ParseCounters.Snapshot(Stats.Parse);
+				BackendCounters.Snapshot(Stats.Backend);
+				SerializeCounters.Snapshot(Stats.Serialize);
+				Stats.Parse.QueueDepth = IngestQueue.Size();
+				for(const std::unique_ptr<TBoundedQueue<FRequestBatch>>& Queue : RequestQueues)
+				{
+					Stats.Backend.QueueDepth += Queue->Size();
+				}
+				Stats.Serialize.QueueDepth = ResponseQueue.Size();
+				Stats.RowsThrottled = RowsThrottled.load(std::memory_order_relaxed);
+				Stats.RowsFailed = RowsFailed.load(std::memory_order_relaxed);
+				return Stats;
+			}
+
+		private:
+			/**
+			 * \brief Size the files of one type that appeared in a producer's
+			 * directory since its last scan, HIGH files first and then in the
+			 * order they were written. Only the ingest thread of that type
+			 * touches the producer's scanner for it.
+			 */
+			FORCEINLINE void ScanProducer(
+				const std::string& Name,
+				const ERequestType RequestType,
+				FProducerState& State,
+				std::vector<FCandidateFile>& OutNewFiles,
+				bool& OutIsTailing)
+			{
+				const uint8_t TypeIndex = static_cast<uint8_t>(RequestType);
+				const std::string Directory = (Name.empty()) ?
+					(Config.InboxDirectory) :
+					((std::filesystem::path(Config.InboxDirectory) / Name).string());
+				FDirectoryScanner& Scanner = State.Scanners[TypeIndex];
+				if(Scanner.GetDirectory().empty())
+				{
+					Scanner.SetDirectory(Directory, static_cast<uint8_t>(1 << TypeIndex));
+				}
+				
+				std::vector<FDirectoryScanner::FScannedFile> Scanned;
+				Scanner.Scan(Scanned);
+				OutNewFiles.reserve(Scanned.size());
+				for(FDirectoryScanner::FScannedFile& File : Scanned)
+				{
+					FCandidateFile Candidate;
+					std::error_code Error;
+					Candidate.Bytes = std::filesystem::file_size(File.Path, Error);
+					if(Error)
+					{
+						// Report it again next scan, rather than never, if it's still there
+						Scanner.Forget(File.Path);
+						continue;
+					}
+					Candidate.Path = std::move(File.Path);
+					Candidate.ID = File.ID;
+					Candidate.Priority = File.Priority;
+					OutNewFiles.push_back(std::move(Candidate));
+				}
+#if IPC_HAS_SEGMENT_FILES
+				// Segments that became READY, and newly committed stream records,
+				// queue up alongside the files
+				std::vector<FSegmentReader::FReadySegment> ReadySegments;
+				if(State.Segments.Poll(Directory, RequestType, ReadySegments))
+				{
+					OutIsTailing = true;
+				}
+				for(FSegmentReader::FReadySegment& Segment : ReadySegments)
+				{
+					FCandidateFile Candidate;
+					Candidate.Path = std::move(Segment.Path);
+					Candidate.ID = Segment.ID;
+					Candidate.Priority = Segment.Priority;
+					Candidate.Bytes = Segment.Range.Size;
+					Candidate.Segments = &State.Segments;
+					Candidate.SegmentRange = Segment.Range;
+					OutNewFiles.push_back(std::move(Candidate));
+				}
+				if(!ReadySegments.empty())
+				{
+					// Ranges of one stream share its ID and must stay in order
+					std::stable_sort(OutNewFiles.begin(), OutNewFiles.end(), &IsConsumedBefore);
+				}
+#endif
+			}
+
+			/** \brief Whether Left is to be consumed first: HIGH files, then oldest ID. */
+			static FORCEINLINE bool IsConsumedBefore(const FCandidateFile& Left, const FCandidateFile& Right)
+			{
+				if(Left.Priority != Right.Priority)
+				{
+					return Left.Priority == ERequestPriority::HIGH;
+				}
+				return Left.ID < Right.ID;
+			}
+
+			/**
+			 * \brief Read and verify each file, split it into backend sized batches
+			 * and remove it from the inbox.
+			 */
+			FORCEINLINE void RunParseStage()
+			{
+				if(ParseWorkers.GetNumberOfThreads() > 1)
+				{
+					RunParallelParseStage();
+					CloseRequestQueues();
+					return;
+				}
+				
+				FIngestedFile File;
+				std::vector<std::string> Records;
+				std::string SegmentText;
+				std::vector<FRequestBatch> Batches(RequestQueues.size());
+				while(IngestQueue.Pop(File))
+				{
+					const auto Start = std::chrono::steady_clock::now();
+					Records.clear();
+					bool bIsPartial = false;
+#if IPC_HAS_SEGMENT_FILES
+					if(File.Segments)
+					{
+						// Segment ranges are committed whole, there is nothing to wait for
+						if(!File.Segments->ReadRange(File.SegmentRange, SegmentText))
+						{
+							File.Segments->Unclaim(File.SegmentRange);
+							continue;
+						}
+						if(File.SegmentRange.bIsStreamed)
+						{
+							VerifyRecordLines(File.Path, SegmentText, SegmentText.size(), Records);
+						}
+						else
+						{
+							VerifyRecordsFromText(File.Path, SegmentText, Records);
+						}
+					}
+					else
+#endif
+					if(!ReadVerifiedRecordsFromFile(File.Path, Records))
+					{
+						if(SkipUnverifiedFile(File))
+						{
+							continue;
+						}
+						bIsPartial = true;
+					}
+
+					uint64_t Stalled = 0;
+					std::shared_ptr<FFileTicket> Ticket = MakeTicket(std::move(File), bIsPartial);
+					const ERequestType RequestType = Ticket->File.RequestType;
+					for(const std::string& Record : Records)
+					{
+						if(RequestType == ERequestType::GET)
+						{
+							FGetRequest Request;
+							if(ParseGetRecord(Record, Request))
+							{
+								Request.SetPriority(Ticket->File.Priority);
+								AddToShard(Batches, Ticket, std::move(Request), Stalled);
+							}
+						}
+						else
+						{
+							FPlayerAttributeList Attributes;
+							if(ParseSetRecord(Record, Attributes))
+							{
+								AddToShard(Batches, Ticket, std::move(Attributes), Stalled);
+							}
+						}
+					}
+					PushShardBatches(Batches, Ticket, Stalled);
+					ReleaseTicket(Ticket);
+					ParseCounters.Record(Records.size(), Start, Stalled);
+				}
+				CloseRequestQueues();
+			}
+
+			/**
+			 * \brief The parse stage with @link FAWSProcessorConfig::NumberOfParseWorkers
+			 * above one. Each round takes a file per worker from the ingest queue,
+			 * reads and checks them concurrently, splits them into record aligned
+			 * chunks, so one large file is shared out too, and parses the chunks
+			 * concurrently into their own vectors. The chunks are then batched in
+			 * file order, so each player's requests reach the backend stage in the
+			 * order they were written.
+			 */
+			FORCEINLINE void RunParallelParseStage()
+			{
+				const size_t NumberOfThreads = ParseWorkers.GetNumberOfThreads();
+				std::vector<FParseFile> Files;
+				std::vector<FParseChunk> Chunks;
+				std::vector<FRequestBatch> Batches(RequestQueues.size());
+				FIngestedFile File;
+				while(IngestQueue.Pop(File))
+				{
+					const auto Start = std::chrono::steady_clock::now();
+					// Only take what's already queued, waiting for a full round adds latency
+					Files.clear();
+					do
+					{
+						Files.emplace_back();
+						Files.back().File = std::move(File);
+					}
+					while(Files.size() < NumberOfThreads && IngestQueue.TryPop(File));
+
+					ParseWorkers.Run(Files.size(), [this, &Files](const size_t Index)
+					{
+						LoadParseFile(Files[Index]);
+					});
+
+					// Chunks no smaller than AWS_PARSE_CHUNK_BYTES, about one per thread
+					size_t TotalBytes = 0;
+					for(const FParseFile& Parse : Files)
+					{
+						TotalBytes += (Parse.bIsSkipped) ? (0) : (Parse.RecordsEnd);
+					}
+					const size_t ChunkBytes = (std::max)(static_cast<size_t>(AWS_PARSE_CHUNK_BYTES),
+						TotalBytes / NumberOfThreads + 1);
+					Chunks.clear();
+					for(size_t FileIndex = 0; FileIndex < Files.size(); ++FileIndex)
+					{
+						const FParseFile& Parse = Files[FileIndex];
+						if(Parse.bIsSkipped)
+						{
+							continue;
+						}
+						// Every file gets at least one chunk, even an empty one, so it's finished
+						const std::string_view Records(Parse.Text.data(), Parse.RecordsEnd);
+						size_t ChunkStart = 0;
+						do
+						{
+							FParseChunk& Chunk = Chunks.emplace_back();
+							Chunk.FileIndex = FileIndex;
+							Chunk.Start = ChunkStart;
+							Chunk.End = RecordStatics::FindChunkEnd(Records, ChunkStart, ChunkBytes);
+							ChunkStart = Chunk.End;
+						}
+						while(ChunkStart < Parse.RecordsEnd);
+					}
+
+					ParseWorkers.Run(Chunks.size(), [this, &Files, &Chunks](const size_t Index)
+					{
+						ParseChunk(Files[Chunks[Index].FileIndex], Chunks[Index]);
+					});
+
+					uint64_t Stalled = 0;
+					uint64_t NumberOfRecords = 0;
+					std::shared_ptr<FFileTicket> Ticket;
+					for(size_t i = 0; i < Chunks.size(); ++i)
+					{
+						FParseChunk& Chunk = Chunks[i];
+						if(i == 0 || Chunks[i - 1].FileIndex != Chunk.FileIndex)
+						{
+							FParseFile& Parse = Files[Chunk.FileIndex];
+							Ticket = MakeTicket(std::move(Parse.File), Parse.bIsPartial);
+						}
+						for(FGetRequest& Request : Chunk.GetRequests)
+						{
+							AddToShard(Batches, Ticket, std::move(Request), Stalled);
+						}
+						for(FPlayerAttributeList& Attributes : Chunk.SetRequests)
+						{
+							AddToShard(Batches, Ticket, std::move(Attributes), Stalled);
+						}
+						NumberOfRecords += Chunk.NumberOfRecords;
+						
+						// Batches don't span files, as in the serial stage
+						if(i + 1 == Chunks.size() || Chunks[i + 1].FileIndex != Chunk.FileIndex)
+						{
+							PushShardBatches(Batches, Ticket, Stalled);
+							ReleaseTicket(Ticket);
+						}
+					}
+					ParseCounters.Record(NumberOfRecords, Start, Stalled,
+						static_cast<uint64_t>(std::count_if(Files.begin(), Files.end(),
+							[](const FParseFile& Parse) { return !Parse.bIsSkipped; })));
+				}
+			}
+
+			/**
+			 * \brief Read a file, or segment range, of a parallel parse round and
+			 * check its footer. Runs on a parse worker.
+			 */
+			FORCEINLINE void LoadParseFile(FParseFile& Parse)
+			{
+#if IPC_HAS_SEGMENT_FILES
+				if(Parse.File.Segments)
+				{
+					// Segment ranges are committed whole, there is nothing to wait for
+					if(!Parse.File.Segments->ReadRange(Parse.File.SegmentRange, Parse.Text))
+					{
+						Parse.File.Segments->Unclaim(Parse.File.SegmentRange);
+						Parse.bIsSkipped = true;
+						return;
+					}
+					if(Parse.File.SegmentRange.bIsStreamed)
+					{
+						Parse.RecordsEnd = Parse.Text.size();
+					}
+					else if(!Parse.Text.empty())
+					{
+						CountFileIntegrity(VerifyFileFooter(Parse.Text, Parse.RecordsEnd));
+					}
+					return;
+				}
+#endif
+				{
+					const std::ifstream Stream(Parse.File.Path, std::ios::binary);
+					std::stringstream StreamBuffer;
+					StreamBuffer << Stream.rdbuf();
+					Parse.Text = StreamBuffer.str();
+				}
+				if(Parse.Text.empty() ||
+					!CountFileIntegrity(VerifyFileFooter(Parse.Text, Parse.RecordsEnd)))
+				{
+					Parse.bIsSkipped = SkipUnverifiedFile(Parse.File);
+					Parse.bIsPartial = !Parse.bIsSkipped;
+				}
+			}
+
+			/**
+			 * \brief Check and parse the records of one chunk. Runs on a parse worker.
+			 */
+			static FORCEINLINE void ParseChunk(const FParseFile& Parse, FParseChunk& Chunk)
+			{
+				std::vector<std::string> Records;
+				VerifyRecordLines(Parse.File.Path, Parse.Text, Chunk.Start, Chunk.End, Records);
+				Chunk.NumberOfRecords = Records.size();
+				for(const std::string& Record : Records)
+				{
+					if(Parse.File.RequestType == ERequestType::GET)
+					{
+						FGetRequest Request;
+						if(ParseGetRecord(Record, Request))
+						{
+							Request.SetPriority(Parse.File.Priority);
+							Chunk.GetRequests.push_back(std::move(Request));
+						}
+					}
+					else
+					{
+						FPlayerAttributeList Attributes;
+						if(ParseSetRecord(Record, Attributes))
+						{
+							Chunk.SetRequests.push_back(std::move(Attributes));
+						}
+					}
+				}
+			}
+
+			/**
+			 * \brief Deal with a file that failed its integrity check.
+			 * \return Whether to skip it, because it's gone or has been given back
+			 * to be ingested again.
+			 */
+			FORCEINLINE bool SkipUnverifiedFile(const FIngestedFile& File)
+			{
+				std::error_code Error;
+				if(!std::filesystem::exists(File.Path, Error))
+				{
+					// Removed from under us, nothing to retry
+					ClaimLock.Lock();
+					Claims.erase(File.Path);
+					ClaimLock.Unlock();
+					return true;
+				}
+				// Probably still being written, leave it for the next ingest
+				ClaimLock.Lock();
+				const bool bReleased = ++Claims[File.Path].Attempts < MaxIngestAttempts;
+				ClaimLock.Unlock();
+				return bReleased && RequeueFile(File);
+			}
+
+			/**
+			 * \brief Remove a file whose records have all been handled, or mark a
+			 * segment range handled.
+			 */
+			FORCEINLINE void FinishParsedFile(const FIngestedFile& File)
+			{
+#if IPC_HAS_SEGMENT_FILES
+				if(File.Segments)
+				{
+					File.Segments->Finish(File.SegmentRange);
+					return;
+				}
+#endif
+				std::error_code Error;
+				std::filesystem::remove(File.Path, Error);
+				ClaimLock.Lock();
+				Claims.erase(File.Path);
+				ClaimLock.Unlock();
+			}
+
+			/**
+			 * \brief Make one backend batch call per batch. There is one of these
+			 * threads per in-flight batch, each with its own queue, and a player's
+			 * requests always go to the same one so they're applied in order.
+			 */
+			FORCEINLINE void RunBackendStage(TBoundedQueue<FRequestBatch>& RequestQueue)
+			{
+				FRequestBatch Batch;
+				std::vector<std::string> PlayerAuthIDs;
+				std::vector<EBackendResult> Results;
+				while(RequestQueue.Pop(Batch))
+				{
+					const auto Start = std::chrono::steady_clock::now();
+					uint64_t Stalled = 0;
+					const std::shared_ptr<IAWSBackend> Backend = AWS_GetBackend();
+					if(Batch.RequestType == ERequestType::GET)
+					{
+						FResponseBatch Response;
+						Response.GetRequests = std::move(Batch.GetRequests);
+						Response.Stored.resize(Response.GetRequests.size());
+						Response.Results.assign(Response.GetRequests.size(), EBackendResult::FAILED);
+						Response.Ticket = std::move(Batch.Ticket);
+						if(!Backend ||
+							!CallWithRetries(Response.Results, [&](const std::vector<size_t>& Rows)
+							{
+								PlayerAuthIDs.clear();
+								for(const size_t Row : Rows)
+								{
+									PlayerAuthIDs.push_back(Response.GetRequests[Row].GetPlayerAuthIDString());
+								}
+								std::vector<FPlayerAttributeList> Stored;
+								Backend->GetPlayers(PlayerAuthIDs, Stored, Results);
+								for(size_t i = 0; i < Rows.size(); ++i)
+								{
+									Response.Stored[Rows[i]] = std::move(Stored[i]);
+									Response.Results[Rows[i]] = Results[i];
+								}
+							}))
+						{
+							Response.Ticket->bKeepFile.store(true, std::memory_order_relaxed);
+						}
+						CountFailures(Response.Results);
+						const size_t NumberOfRows = Response.GetRequests.size();
+						ResponseQueue.Push(std::move(Response), Stalled);
+						BackendCounters.Record(NumberOfRows, Start, Stalled);
+					}
+					else
+					{
+						std::vector<EBackendResult> SetResults(Batch.SetRequests.size(),
+							EBackendResult::FAILED);
+						if(!Backend ||
+							!CallWithRetries(SetResults, [&](const std::vector<size_t>& Rows)
+							{
+								std::vector<FPlayerAttributeList> Players;
+								Players.reserve(Rows.size());
+								for(const size_t Row : Rows)
+								{
+									Players.push_back(Batch.SetRequests[Row]);
+								}
+								Backend->SetPlayers(Players, Results);
+								for(size_t i = 0; i < Rows.size(); ++i)
+								{
+									SetResults[Rows[i]] = Results[i];
+								}
+							}))
+						{
+							Batch.Ticket->bKeepFile.store(true, std::memory_order_relaxed);
+						}
+						CountFailures(SetResults);
+						BackendCounters.Record(Batch.SetRequests.size(), Start, Stalled);
+						ReleaseTicket(Batch.Ticket);
+					}
+					Batch.GetRequests.clear();
+					Batch.SetRequests.clear();
+					Batch.Ticket.reset();
+				}
+				if(NumberOfRunningWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					ResponseQueue.Close();
+				}
+			}
+
+			/**
+			 * \brief Turn backend results into GET responses in the AWS SET buffers,
+			 * flushing them to the outbox whenever the stage catches up. A file's
+			 * batches are only let go once their responses have been flushed.
+			 */
+			FORCEINLINE void RunSerializeStage()
+			{
+				FResponseBatch Response;
+				std::vector<std::shared_ptr<FFileTicket>> Unflushed;
+				while(ResponseQueue.Pop(Response))
+				{
+					const auto Start = std::chrono::steady_clock::now();
+					for(size_t i = 0; i < Response.GetRequests.size(); ++i)
+					{
+						if((Response.Results[i] == EBackendResult::OK ||
+							Response.Results[i] == EBackendResult::NOT_FOUND) &&
+							!AddGetResponse(Response.GetRequests[i], Response.Stored[i]))
+						{
+							RowsFailed.fetch_add(1, std::memory_order_relaxed);
+							Response.Ticket->bKeepFile.store(true, std::memory_order_relaxed);
+						}
+					}
+					Unflushed.push_back(std::move(Response.Ticket));
+					if(ResponseQueue.Size() == 0)
+					{
+						FlushResponses(Unflushed);
+					}
+					SerializeCounters.Record(Response.GetRequests.size(), Start, 0);
+				}
+				FlushResponses(Unflushed);
+			}
+
+			/**
+			 * \brief Add a GET response to the AWS SET buffers, flushing them to the
+			 * outbox and trying again if they're full.
+			 */
+			FORCEINLINE bool AddGetResponse(const FGetRequest& Request, const FPlayerAttributeList& Stored)
+			{
+				FSetRequest GetResponse = MakeGetResponse(Request, Stored);
+				if(AWS_AddSetRequestToBuffer(GetResponse))
+				{
+					return true;
+				}
+				if(Config.OutboxDirectory.empty())
+				{
+					return false;
+				}
+				AWS_PrioritySetLane.Flush(Config.OutboxDirectory);
+				AWS_SetRequestBuffer.FlushToFileThroughLock(Config.OutboxDirectory);
+				return AWS_AddSetRequestToBuffer(std::move(GetResponse));
+			}
+
+			/**
+			 * \brief Flush the GET responses to the outbox, then let go of the files
+			 * they came from. Without an outbox they're left in the AWS SET buffers.
+			 */
+			FORCEINLINE void FlushResponses(std::vector<std::shared_ptr<FFileTicket>>& InOutTickets)
+			{
+				if(!Config.OutboxDirectory.empty())
+				{
+					AWS_PrioritySetLane.Flush(Config.OutboxDirectory);
+					AWS_SetRequestBuffer.FlushToFileThroughLock(Config.OutboxDirectory);
+				}
+				for(std::shared_ptr<FFileTicket>& Ticket : InOutTickets)
+				{
+					ReleaseTicket(Ticket);
+				}
+				InOutTickets.clear();
+			}
+
+			/**
+			 * \brief Run Call on every row, then again on the rows that were
+			 * throttled, backing off 1ms, 2ms, 4ms... up to
+			 * @link FAWSProcessorConfig::MaxThrottleRetries doublings. Rows are
+			 * retried on this thread so a player's later requests wait for them.
+			 * \return Fails if the pipeline was stopped with rows still throttled.
+			 */
+			template<typename TCall>
+			FORCEINLINE bool CallWithRetries(
+				std::vector<EBackendResult>& InOutResults,
+				const TCall& Call)
+			{
+				std::vector<size_t> Rows(InOutResults.size());
+				for(size_t i = 0; i < Rows.size(); ++i)
+				{
+					Rows[i] = i;
+				}
+				for(uint32_t Attempt = 0; !Rows.empty(); ++Attempt)
+				{
+					if(Attempt != 0)
+					{
+						if(bIsStopping.load(std::memory_order_acquire))
+						{
+							return false;
+						}
+						const uint32_t Doublings = (std::min)(Attempt - 1, Config.MaxThrottleRetries);
+						std::this_thread::sleep_for(std::chrono::milliseconds(1ull << (std::min)(Doublings, 16u)));
+					}
+					Call(Rows);
+					Rows.erase(std::remove_if(Rows.begin(), Rows.end(), [&](const size_t Row)
+					{
+						return InOutResults[Row] != EBackendResult::THROTTLED;
+					}), Rows.end());
+				}
+				return true;
+			}
+
+			/**
+			 * \brief Add the rows that ended THROTTLED or FAILED to the stats.
+			 */
+			FORCEINLINE void CountFailures(const std::vector<EBackendResult>& Results) noexcept
+			{
+				for(const EBackendResult Result : Results)
+				{
+					if(Result == EBackendResult::THROTTLED)
+					{
+						RowsThrottled.fetch_add(1, std::memory_order_relaxed);
+					}
+					else if(Result == EBackendResult::FAILED)
+					{
+						RowsFailed.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			}
+
+			/**
+			 * \brief Start tracking the batches of a parsed file.
+			 */
+			FORCEINLINE std::shared_ptr<FFileTicket> MakeTicket(FIngestedFile&& File, const bool bIsPartial)
+			{
+				std::shared_ptr<FFileTicket> Ticket = std::make_shared<FFileTicket>();
+				Ticket->File = std::move(File);
+				Ticket->bIsPartial = bIsPartial;
+				return Ticket;
+			}
+
+			/**
+			 * \brief Add a request to the batch of the backend worker that owns its
+			 * player, handing the batch over once it's full.
+			 */
+			template<typename TRequest>
+			FORCEINLINE void AddToShard(
+				std::vector<FRequestBatch>& Batches,
+				const std::shared_ptr<FFileTicket>& Ticket,
+				TRequest&& Request,
+				uint64_t& OutStalledNs)
+			{
+				const size_t Shard =
+					std::hash<std::string_view>()(GetShardKey(Request)) % Batches.size();
+				FRequestBatch& Batch = Batches[Shard];
+				std::vector<std::decay_t<TRequest>>& Requests = GetBatchRequests(Batch, Request);
+				Requests.push_back(std::forward<TRequest>(Request));
+				if(Requests.size() >= Config.BatchSize)
+				{
+					PushBatch(Shard, Batch, Ticket, OutStalledNs);
+				}
+			}
+
+			static FORCEINLINE std::string_view GetShardKey(const FGetRequest& Request) noexcept
+			{
+				return Request.GetPlayerAuthIDString();
+			}
+
+			static FORCEINLINE std::string_view GetShardKey(const FPlayerAttributeList& Attributes) noexcept
+			{
+				return Attributes.GetPlayerAuthID().Value;
+			}
+
+			static FORCEINLINE std::vector<FGetRequest>& GetBatchRequests(
+				FRequestBatch& Batch, const FGetRequest&) noexcept
+			{
+				return Batch.GetRequests;
+			}
+
+			static FORCEINLINE std::vector<FPlayerAttributeList>& GetBatchRequests(
+				FRequestBatch& Batch, const FPlayerAttributeList&) noexcept
+			{
+				return Batch.SetRequests;
+			}
+
+			/**
+			 * \brief Hand every non empty batch of a file to its backend worker,
+			 * batches don't span files.
+			 */
+			FORCEINLINE void PushShardBatches(
+				std::vector<FRequestBatch>& Batches,
+				const std::shared_ptr<FFileTicket>& Ticket,
+				uint64_t& OutStalledNs)
+			{
+				for(size_t Shard = 0; Shard < Batches.size(); ++Shard)
+				{
+					if(!Batches[Shard].GetRequests.empty() || !Batches[Shard].SetRequests.empty())
+					{
+						PushBatch(Shard, Batches[Shard], Ticket, OutStalledNs);
+					}
+				}
+			}
+
+			/**
+			 * \brief Hand a batch to a backend worker and start a new one.
+			 */
+			FORCEINLINE void PushBatch(
+				const size_t Shard,
+				FRequestBatch& Batch,
+				const std::shared_ptr<FFileTicket>& Ticket,
+				uint64_t& OutStalledNs)
+			{
+				Ticket->References.fetch_add(1, std::memory_order_relaxed);
+				Batch.RequestType = Ticket->File.RequestType;
+				Batch.Ticket = Ticket;
+				RequestQueues[Shard]->Push(std::move(Batch), OutStalledNs);
+				Batch = FRequestBatch();
+			}
+
+			FORCEINLINE void CloseRequestQueues()
+			{
+				for(std::unique_ptr<TBoundedQueue<FRequestBatch>>& Queue : RequestQueues)
+				{
+					Queue->Close();
+				}
+			}
+
+			/**
+			 * \brief Drop a reference to a file's batches. After the last one the
+			 * file is removed, or set aside if only some of it verified, or left in
+			 * place to be ingested again if a row never finished.
+			 */
+			FORCEINLINE void ReleaseTicket(std::shared_ptr<FFileTicket>& Ticket)
+			{
+				if(!Ticket || Ticket->References.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				{
+					Ticket.reset();
+					return;
+				}
+				const FIngestedFile& File = Ticket->File;
+				if(Ticket->bKeepFile.load(std::memory_order_relaxed))
+				{
+					RequeueFile(File);
+				}
+				else if(Ticket->bIsPartial && !IsSegmentFile(File))
+				{
+					// Not removed, the records that didn't verify may be recovered by hand
+					std::error_code Error;
+					std::filesystem::rename(File.Path, File.Path + UNVERIFIED_FILE_EXTENSION, Error);
+					ClaimLock.Lock();
+					Claims.erase(File.Path);
+					ClaimLock.Unlock();
+				}
+				else
+				{
+					FinishParsedFile(File);
+				}
+				Ticket.reset();
+			}
+
+			static FORCEINLINE bool IsSegmentFile(const FIngestedFile& File) noexcept
+			{
+#if IPC_HAS_SEGMENT_FILES
+				return File.Segments != nullptr;
+#else
+				(void)File;
+				return false;
+#endif
+			}
+
+			/**
+			 * \brief Give a file back to its producer's pending files to be
+			 * ingested again. The scanner won't list it again, it has seen it. A
+			 * segment range is given back to its reader instead, which hands it
+			 * out again.
+			 * \return Fails if it isn't one of our files.
+			 */
+			FORCEINLINE bool RequeueFile(const FIngestedFile& File)
+			{
+#if IPC_HAS_SEGMENT_FILES
+				if(File.Segments)
+				{
+					File.Segments->Unclaim(File.SegmentRange);
+					return true;
+				}
+#endif
+				FCandidateFile Candidate;
+				ERequestType FileType;
+				if(!ParseUniqueFileName(File.Path, FileType, Candidate.ID, Candidate.Priority))
+				{
+					return false;
+				}
+				std::error_code Error;
+				Candidate.Bytes = std::filesystem::file_size(File.Path, Error);
+				Candidate.Path = File.Path;
+				
+				ProducerLock.Lock();
+				std::vector<FCandidateFile>& Pending =
+					Producers[File.Producer].Pending[static_cast<uint8_t>(FileType)];
+				Pending.insert(std::upper_bound(Pending.begin(), Pending.end(), Candidate,
+					&IsConsumedBefore), std::move(Candidate));
+				ProducerLock.Unlock();
+				return true;
+			}
+			
+			FAWSProcessorConfig Config;
+			std::atomic<bool> bIsRunning;
+			/** Set by Stop so throttled rows stop being retried */
+			std::atomic<bool> bIsStopping;
+			std::atomic<size_t> NumberOfRunningWorkers;
+			/** Per @link ERequestType, whether the last ingest saw a stream still being written */
+			std::atomic<bool> bIsTailingStream[3] = {{false}, {false}, {false}};
+			std::vector<std::thread> Threads;
+			FParallelTaskPool ParseWorkers;
+			TBoundedQueue<FIngestedFile> IngestQueue;
+			/** One per backend worker, see @link AddToShard */
+			std::vector<std::unique_ptr<TBoundedQueue<FRequestBatch>>> RequestQueues;
+			TBoundedQueue<FResponseBatch> ResponseQueue;
+			FSpinLoop<false> ClaimLock;
+			std::unordered_map<std::string, FFileClaim> Claims;
+			FSpinLoop<false> ProducerLock;
+			std::map<std::string, FProducerState> Producers;
+			size_t NextTurn[3] = {0, 0, 0};
+			FStageCounters IngestCounters;
+			FStageCounters ParseCounters;
+			FStageCounters BackendCounters;
+			FStageCounters SerializeCounters;
+			std::atomic<uint64_t> RowsThrottled;
+			std::atomic<uint64_t> RowsFailed;
+		};
+		
+		/**
+		 * \brief The last attributes written for each player, kept as hashes so an
+		 * entry is a fixed 16 bytes however long the values are. A SET is staged
+		 * when it is buffered and only lands in the table once the write of its
+		 * file is acknowledged, so a lost write is never treated as sent. A new
+		 * SET is compared with the player's newest staged values, so one that
+		 * undoes a SET still in flight is not mistaken for unchanged. Past the
+		 * capacity players are evicted, their next SET then goes out in full.
+		 */
+		class FPlayerShadowTable
+		{
+			struct FPlayerShadow
+			{
+				uint64_t PlayerNameHash = 0;
+				uint8_t PresenceMask = 0;
+				bool bIsOnline = false;
+			};
+
+			struct FStagedShadow
+			{
+				uint64_t Key = 0;
+				FPlayerShadow Shadow;
+			};
+			
+		public:
+			FPlayerShadowTable()
+				: Capacity{PLAYER_SHADOW_CAPACITY}
+			{
+			}
+
+			/**
+			 * \brief Work out which attributes of a SET differ from what was last
+			 * written, or staged to be written if a write is still in flight. Does
+			 * not change the table, call @link Stage before the SET is buffered.
+			 * \return A mask of @link FCompactRequest::AttributeBit for every changed
+			 * attribute. PLAYER_AUTH is never reported, it is the key.
+			 */
+			FORCEINLINE uint8_t GetChangedAttributes(const FSetRequest& InRequest)
+			{
+				const FPlayerAttributeList& Attributes = InRequest.GetPlayerAttributeList();
+				const uint64_t Key = HashString(InRequest.GetPlayerAuthIDString());
+				FPlayerShadow Shadow;
+				TableLock.Lock();
+				const auto Found = Shadows.find(Key);
+				if(Found != Shadows.end())
+				{
+					Shadow = Found->second;
+				}
+				const auto FoundStaged = StagedByPlayer.find(Key);
+				if(FoundStaged != StagedByPlayer.end())
+				{
+					for(const FRequestID RequestID : FoundStaged->second)
+					{
+						Merge(Shadow, Staging[RequestID].Shadow);
+					}
+				}
+				TableLock.Unlock();
+
+				uint8_t Changed = 0;
+				for(size_t i = 0; i < Attributes.Size(); ++i)
+				{
+					const EAttributeName Name = Attributes[static_cast<int>(i)];
+					const uint8_t Bit = FCompactRequest::AttributeBit(Name);
+					const bool bWasSent = (Shadow.PresenceMask & Bit) != 0;
+					switch(Name)
+					{
+						case EAttributeName::PLAYER_NAME:
+							if(!bWasSent || Shadow.PlayerNameHash !=
+								HashString(Attributes.GetPlayerName().Value))
+							{
+								Changed |= Bit;
+							}
+							break;
+						case EAttributeName::IS_ONLINE:
+							if(!bWasSent || Shadow.bIsOnline != Attributes.GetIsOnline().Value)
+							{
+								Changed |= Bit;
+							}
+							break;
+						default:
+							break;
+					}
+				}
+				return Changed;
+			}
+
+			/**
+			 * \brief Hold the attributes of a SET about to be buffered until its write
+			 * is acknowledged. A SET with no request ID can never be acknowledged,
+			 * so it is committed straight away.
+			 */
+			FORCEINLINE void Stage(const FSetRequest& InRequest)
+			{
+				const FPlayerAttributeList& Attributes = InRequest.GetPlayerAttributeList();
+				FStagedShadow Staged;
+				Staged.Key = HashString(InRequest.GetPlayerAuthIDString());
+				Staged.Shadow.PresenceMask = Attributes.GetAttributeMask();
+				Staged.Shadow.PlayerNameHash = HashString(Attributes.GetPlayerName().Value);
+				Staged.Shadow.bIsOnline = Attributes.GetIsOnline().Value;
+				TableLock.Lock();
+				if(InRequest.GetRequestID() == RequestIDStatics::None)
+				{
+					CommitUnlocked(Staged);
+				}
+				else
+				{
+					// SETs that are never written, like dropped ones, must not pile up
+					if(Staging.size() >= Capacity)
+					{
+						UnstageUnlocked(Staging.begin());
+					}
+					if(Staging.emplace(InRequest.GetRequestID(), Staged).second)
+					{
+						StagedByPlayer[Staged.Key].push_back(InRequest.GetRequestID());
+					}
+				}
+				TableLock.Unlock();
+			}
+
+			/**
+			 * \brief Commit a staged SET once the write of its file succeeded, or
+			 * throw it away if the write failed or the SET never got buffered.
+			 */
+			FORCEINLINE void Acknowledge(const FRequestID RequestID, const bool bWritten)
+			{
+				TableLock.Lock();
+				const auto Found = Staging.find(RequestID);
+				if(Found != Staging.end())
+				{
+					if(bWritten)
+					{
+						CommitUnlocked(Found->second);
+					}
+					UnstageUnlocked(Found);
+				}
+				TableLock.Unlock();
+			}
+
+			/**
+			 * \brief Forget what was written or staged for a player, so their next
+			 * SET goes out in full.
+			 */
+			FORCEINLINE void Forget(const std::string& PlayerAuthID)
+			{
+				const uint64_t Key = HashString(PlayerAuthID);
+				TableLock.Lock();
+				Shadows.erase(Key);
+				const auto FoundStaged = StagedByPlayer.find(Key);
+				if(FoundStaged != StagedByPlayer.end())
+				{
+					for(const FRequestID RequestID : FoundStaged->second)
+					{
+						Staging.erase(RequestID);
+					}
+					StagedByPlayer.erase(FoundStaged);
+				}
+				TableLock.Unlock();
+			}
+
+			/**
+			 * \brief Set the most players, and the most staged SETs, the table holds.
+			 */
+			FORCEINLINE void SetCapacity(const size_t InCapacity)
+			{
+				TableLock.Lock();
+				Capacity = (std::max)(InCapacity, size_t(1));
+				while(Shadows.size() > Capacity)
+				{
+					Shadows.erase(Shadows.begin());
+				}
+				while(Staging.size() > Capacity)
+				{
+					UnstageUnlocked(Staging.begin());
+				}
+				TableLock.Unlock();
+			}
+
+			/**
+			 * \brief Forget every player and every staged SET.
+			 */
+			FORCEINLINE void Clear()
+			{
+				TableLock.Lock();
+				Shadows.clear();
+				Staging.clear();
+				StagedByPlayer.clear();
+				TableLock.Unlock();
+			}
+
+		private:
+			static FORCEINLINE uint64_t HashString(const std::string& InString) noexcept
+			{
+				return std::hash<std::string_view>()(InString);
+			}
+
+			/**
+			 * \brief Merge a written SET into its player's shadow, must be called with the lock held.
+			 */
+			FORCEINLINE void CommitUnlocked(const FStagedShadow& Staged)
+			{
+				auto Found = Shadows.find(Staged.Key);
+				if(Found == Shadows.end())
+				{
+					if(Shadows.size() >= Capacity)
+					{
+						Shadows.erase(Shadows.begin());
+					}
+					Found = Shadows.emplace(Staged.Key, FPlayerShadow()).first;
+				}
+				Merge(Found->second, Staged.Shadow);
+			}
+
+			/**
+			 * \brief Take the attributes present in From over those in Into.
+			 */
+			static FORCEINLINE void Merge(FPlayerShadow& Into, const FPlayerShadow& From) noexcept
+			{
+				const uint8_t Mask = From.PresenceMask;
+				Into.PresenceMask |= Mask;
+				if(Mask & FCompactRequest::AttributeBit(EAttributeName::PLAYER_NAME))
+				{
+					Into.PlayerNameHash = From.PlayerNameHash;
+				}
+				if(Mask & FCompactRequest::AttributeBit(EAttributeName::IS_ONLINE))
+				{
+					Into.bIsOnline = From.bIsOnline;
+				}
+			}
+
+			/**
+			 * \brief Remove a staged SET and its place in its player's staging
+			 * order, must be called with the lock held.
+			 */
+			FORCEINLINE void UnstageUnlocked(
+				const std::unordered_map<FRequestID, FStagedShadow>::iterator Found)
+			{
+				const auto FoundStaged = StagedByPlayer.find(Found->second.Key);
+				if(FoundStaged != StagedByPlayer.end())
+				{
+					std::vector<FRequestID>& RequestIDs = FoundStaged->second;
+					const auto FoundID = std::find(RequestIDs.begin(), RequestIDs.end(), Found->first);
+					if(FoundID != RequestIDs.end())
+					{
+						RequestIDs.erase(FoundID);
+					}
+					if(RequestIDs.empty())
+					{
+						StagedByPlayer.erase(FoundStaged);
+					}
+				}
+				Staging.erase(Found);
+			}
+			
+			FSpinLoop<false> TableLock;
+			size_t Capacity;
+			std::unordered_map<uint64_t, FPlayerShadow> Shadows;
+			std::unordered_map<FRequestID, FStagedShadow> Staging;
+			/** The request IDs staged for each player, oldest first */
+			std::unordered_map<uint64_t, std::vector<FRequestID>> StagedByPlayer;
+		};
+		
+#if IPC_HAS_UNIX_SOCKETS
+		/**
+		 * \brief What a frame on the socket transport carries.
+		 */
+		enum class ESocketFrameType : uint8_t
+		{
+			BATCH = 0,
+			CREDIT = 1
+		};
+
+		/**
+		 * \brief Sent in front of every frame. A BATCH frame is followed by
+		 * PayloadSize bytes in the file format, a CREDIT frame has no payload.
+		 * Either can return Credits to the other end.
+		 */
+		struct FSocketFrameHeader
+		{
+			uint32_t Magic;
+			uint32_t PayloadSize;
+			uint32_t Credits;
+			ESocketFrameType FrameType;
+			ERequestType RequestType;
+			ERequestPriority Priority;
+			uint8_t Reserved;
+		};
+
+		static_assert(sizeof(FSocketFrameHeader) == 16,
+			"FSocketFrameHeader is sent as is, it must not have any padding");
+
+		/**
+		 * \brief A batch answering one the peer sent, waiting for a credit.
+		 */
+		struct FSocketReply
+		{
+			ERequestPriority Priority;
+			std::string Payload;
+		};
+
+		/**
+		 * \brief One connection of the socket transport. Any thread can send,
+		 * only the transport's thread receives. The transport's thread never
+		 * waits on the send lock, the credits it returns go out on the next
+		 * frame sent or, failing that, on their own once the socket has room.
+		 */
+		class FSocketPeer
+		{
+		public:
+			explicit FSocketPeer(const int InSocket)
+				: Socket{InSocket},
+				SendCredits{0},
+				CreditsToGrant{0},
+				bIsClosed{false},
+				HeaderBytesRead{0},
+				PayloadBytesRead{0}
+			{
+			}
+
+			FSocketPeer(const FSocketPeer&) = delete;
+			FSocketPeer& operator=(const FSocketPeer&) = delete;
+
+			~FSocketPeer()
+			{
+				close(Socket);
+			}
+
+			/**
+			 * \brief Send one frame, the header and payload are handed to the
+			 * kernel together in a single gathered write.
+			 * \return Fails if the connection is closed or broke while sending.
+			 */
+			FORCEINLINE bool SendFrame(
+				const ESocketFrameType FrameType,
+				const ERequestType RequestType,
+				const ERequestPriority Priority,
+				const uint32_t Credits,
+				const std::string_view Payload)
+			{
+				FSocketFrameHeader Header = {};
+				Header.Magic = SOCKET_FRAME_MAGIC;
+				Header.PayloadSize = static_cast<uint32_t>(Payload.size());
+				Header.FrameType = FrameType;
+				Header.RequestType = RequestType;
+				Header.Priority = Priority;
+
+				iovec Parts[2];
+				Parts[0].iov_base = &Header;
+				Parts[0].iov_len = sizeof(Header);
+				Parts[1].iov_base = const_cast<char*>(Payload.data());
+				Parts[1].iov_len = Payload.size();
+				
+				bool bSent = true;
+				SendLock.RunLambdaThroughLock([&]()
+				{
+					// Any credits the transport's thread couldn't send go along with this
+					Header.Credits = Credits + CreditsToGrant.exchange(0, std::memory_order_acq_rel);
+					msghdr Message = {};
+					Message.msg_iov = Parts;
+					Message.msg_iovlen = (Payload.empty()) ? (1) : (2);
+					while(Message.msg_iovlen > 0)
+					{
+						const ssize_t Sent = sendmsg(Socket, &Message, MSG_NOSIGNAL);
+						if(Sent < 0)
+						{
+							if(errno == EINTR)
+							{
+								continue;
+							}
+							bSent = false;
+							return;
+						}
+						// Skip past whatever the kernel took on a partial write
+						size_t Remaining = static_cast<size_t>(Sent);
+						while(Message.msg_iovlen > 0 && Remaining >= Message.msg_iov->iov_len)
+						{
+							Remaining -= Message.msg_iov->iov_len;
+							++Message.msg_iov;
+							--Message.msg_iovlen;
+						}
+						if(Message.msg_iovlen > 0)
+						{
+							Message.msg_iov->iov_base =
+								static_cast<char*>(Message.msg_iov->iov_base) + Remaining;
+							Message.msg_iov->iov_len -= Remaining;
+						}
+					}
+				});
+				if(!bSent)
+				{
+					bIsClosed.store(true, std::memory_order_release);
+				}
+				return bSent;
+			}
+
+			/**
+			 * \brief Return credits to the other end without ever blocking, for
+			 * the transport's thread. They are sent now if the socket is free and
+			 * has room, otherwise they go with the next frame or the next call.
+			 * \return Fails if some are still waiting to be sent.
+			 */
+			FORCEINLINE bool GrantCredits(const uint32_t Credits)
+			{
+				if(Credits != 0)
+				{
+					CreditsToGrant.fetch_add(Credits, std::memory_order_acq_rel);
+				}
+				if(CreditsToGrant.load(std::memory_order_acquire) == 0)
+				{
+					return true;
+				}
+				if(!SendLock.TryLock())
+				{
+					return false;
+				}
+				FSocketFrameHeader Header = {};
+				Header.Magic = SOCKET_FRAME_MAGIC;
+				Header.Credits = CreditsToGrant.exchange(0, std::memory_order_acq_rel);
+				Header.FrameType = ESocketFrameType::CREDIT;
+				Header.RequestType = ERequestType::GET;
+				Header.Priority = ERequestPriority::NORMAL;
+				ssize_t Sent;
+				do
+				{
+					Sent = send(Socket, &Header, sizeof(Header), MSG_DONTWAIT | MSG_NOSIGNAL);
+				}
+				while(Sent < 0 && errno == EINTR);
+				SendLock.Unlock();
+				if(Sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+				{
+					CreditsToGrant.fetch_add(Header.Credits, std::memory_order_acq_rel);
+					return false;
+				}
+				if(Sent != static_cast<ssize_t>(sizeof(Header)))
+				{
+					// A frame can't be left half written, and finishing it could block
+					bIsClosed.store(true, std::memory_order_release);
+				}
+				return true;
+			}
+
+			/**
+			 * \brief Use up one of the credits the other end has granted.
+			 * \return Fails if there are none left.
+			 */
+			FORCEINLINE bool TryTakeCredit() noexcept
+			{
+				int32_t Credits = SendCredits.load(std::memory_order_acquire);
+				while(Credits > 0)
+				{
+					if(SendCredits.compare_exchange_weak(Credits, Credits - 1,
+						std::memory_order_acq_rel))
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/**
+			 * \brief Give back a credit that was taken for a batch that was never sent.
+			 */
+			FORCEINLINE void ReturnCredit() noexcept
+			{
+				SendCredits.fetch_add(1, std::memory_order_acq_rel);
+			}
+
+			/**
+			 * \brief Read everything the socket has without blocking, calling
+			 * OnFrame for every frame that is now complete.
+			 * \param OnFrame Called with the header and payload of each frame.
+			 * \return Fails once the connection is closed or sent a bad frame.
+			 */
+			template<typename TOnFrame>
+			FORCEINLINE bool Receive(const uint32_t MaxFrameBytes, const TOnFrame& OnFrame)
+			{
+				for(;;)
+				{
+					char* Destination;
+					size_t Wanted;
+					if(HeaderBytesRead < sizeof(FSocketFrameHeader))
+					{
+						Destination = reinterpret_cast<char*>(&PendingHeader) + HeaderBytesRead;
+						Wanted = sizeof(FSocketFrameHeader) - HeaderBytesRead;
+					}
+					else
+					{
+						Destination = Payload.data() + PayloadBytesRead;
+						Wanted = Payload.size() - PayloadBytesRead;
+					}
+
+					if(Wanted > 0)
+					{
+						const ssize_t Read = recv(Socket, Destination, Wanted, MSG_DONTWAIT);
+						if(Read == 0)
+						{
+							return false;
+						}
+						if(Read < 0)
+						{
+							if(errno == EINTR)
+							{
+								continue;
+							}
+							return errno == EAGAIN || errno == EWOULDBLOCK;
+						}
+						if(HeaderBytesRead < sizeof(FSocketFrameHeader))
+						{
+							HeaderBytesRead += static_cast<size_t>(Read);
+							if(HeaderBytesRead < sizeof(FSocketFrameHeader))
+							{
+								continue;
+							}
+							if(PendingHeader.Magic != SOCKET_FRAME_MAGIC ||
+								PendingHeader.PayloadSize > MaxFrameBytes)
+							{
+								return false;
+							}
+							Payload.resize(PendingHeader.PayloadSize);
+							PayloadBytesRead = 0;
+						}
+						else
+						{
+							PayloadBytesRead += static_cast<size_t>(Read);
+						}
+						if(PayloadBytesRead < Payload.size())
+						{
+							continue;
+						}
+					}
+
+					SendCredits.fetch_add(static_cast<int32_t>(PendingHeader.Credits),
+						std::memory_order_acq_rel);
+					if(PendingHeader.FrameType == ESocketFrameType::BATCH)
+					{
+						OnFrame(PendingHeader, Payload);
+					}
+					HeaderBytesRead = 0;
+					PayloadBytesRead = 0;
+					Payload.clear();
+				}
+			}
+
+			/**
+			 * \brief Queue a reply for @link SendReplies, from the transport's thread.
+			 */
+			FORCEINLINE void QueueReply(const ERequestPriority Priority, std::string&& Payload)
+			{
+				Replies.push_back(FSocketReply{Priority, std::move(Payload)});
+			}
+
+			/**
+			 * \brief Send the queued replies for as long as there are credits,
+			 * from the transport's thread.
+			 * \param OnSent Called with the size of each reply sent.
+			 */
+			template<typename TOnSent>
+			FORCEINLINE void SendReplies(const TOnSent& OnSent)
+			{
+				while(!Replies.empty() && TryTakeCredit())
+				{
+					const FSocketReply& Reply = Replies.front();
+					if(!SendFrame(ESocketFrameType::BATCH, ERequestType::SET, Reply.Priority, 0,
+						Reply.Payload))
+					{
+						return;
+					}
+					OnSent(Reply.Payload.size());
+					Replies.pop_front();
+				}
+			}
+
+			/** \brief The descriptor of the connection. */
+			FORCEINLINE int GetSocket() const noexcept
+			{
+				return Socket;
+			}
+
+			/** \brief Whether the connection has been closed by either end. */
+			FORCEINLINE bool IsClosed() const noexcept
+			{
+				return bIsClosed.load(std::memory_order_acquire);
+			}
+
+		private:
+			const int Socket;
+			std::atomic<int32_t> SendCredits;
+			/** Credits for the other end that haven't been sent yet */
+			std::atomic<uint32_t> CreditsToGrant;
+			std::atomic<bool> bIsClosed;
+			FSpinLoop<false> SendLock;
+
+			// Only touched by the receiving thread
+			FSocketFrameHeader PendingHeader;
+			size_t HeaderBytesRead;
+			std::string Payload;
+			size_t PayloadBytesRead;
+			std::deque<FSocketReply> Replies;
+		};
+
+		/**
+		 * \brief Streams batches over an AF_UNIX socket instead of writing them to
+		 * files. The AWS side listens and the UE side keeps one connection open
+		 * to it, reconnecting if it is lost. Each end grants the other a number
+		 * of credits and returns one each time it has finished handling a batch,
+		 * so a slow reader holds up the writer instead of piling batches up in
+		 * the socket. The listening end only sends replies, each on the
+		 * connection the batch it answers came in on.
+		 */
+		class FSocketTransport
+		{
+		public:
+			/**
+			 * Called with each batch received, anything left in OutReply is sent
+			 * back to the peer that sent the batch as a SET batch.
+			 */
+			using FBatchHandler = std::function<void(ERequestType, ERequestPriority,
+				const std::string& Payload, std::string& OutReply)>;
+
+			FSocketTransport()
+				: ListenSocket{-1},
+				bIsOpen{false},
+				bShouldStop{false},
+				BatchesSent{0},
+				BatchesReceived{0},
+				BytesSent{0},
+				BytesReceived{0},
+				SendsWithoutCredit{0},
+				Reconnects{0}
+			{
+				WakePipe[0] = -1;
+				WakePipe[1] = -1;
+			}
+
+			FSocketTransport(const FSocketTransport&) = delete;
+			FSocketTransport& operator=(const FSocketTransport&) = delete;
+
+			~FSocketTransport()
+			{
+				Close();
+			}
+
+			/**
+			 * \brief Accept connections on Config.SocketPath, replacing any socket
+			 * file left behind there.
+			 * \param OnBatch Called on the transport's thread for every batch received.
+			 * \return Fails if it is already open or the socket couldn't be bound.
+			 */
+			FORCEINLINE bool Listen(const FSocketTransportConfig& InConfig, FBatchHandler OnBatch)
+			{
+				sockaddr_un Address;
+				if(bIsOpen.load(std::memory_order_acquire) ||
+					!MakeAddress(InConfig.SocketPath, Address))
+				{
+					return false;
+				}
+				const int Socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+				if(Socket < 0)
+				{
+					return false;
+				}
+				unlink(InConfig.SocketPath.c_str());
+				if(bind(Socket, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0 ||
+					listen(Socket, SOMAXCONN) != 0)
+				{
+					close(Socket);
+					return false;
+				}
+				ListenSocket = Socket;
+				return Open(InConfig, std::move(OnBatch));
+			}
+
+			/**
+			 * \brief Connect to the end listening on Config.SocketPath. If the
+			 * connection is lost it is retried every Config.ReconnectIntervalMS.
+			 * \param OnBatch Called on the transport's thread for every batch received.
+			 * \return Fails if it is already open or nothing is listening.
+			 */
+			FORCEINLINE bool Connect(const FSocketTransportConfig& InConfig, FBatchHandler OnBatch)
+			{
+				if(bIsOpen.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+				const int Socket = ConnectSocket(InConfig.SocketPath);
+				if(Socket < 0)
+				{
+					return false;
+				}
+				AddPeer(Socket, InConfig.Credits);
+				return Open(InConfig, std::move(OnBatch));
+			}
+
+			/**
+			 * \brief Stop the transport's thread and close every connection.
+			 */
+			FORCEINLINE void Close()
+			{
+				if(!bIsOpen.exchange(false, std::memory_order_acq_rel))
+				{
+					return;
+				}
+				bShouldStop.store(true, std::memory_order_release);
+				const char Byte = 0;
+				(void)!write(WakePipe[1], &Byte, 1);
+				if(Thread.joinable())
+				{
+					Thread.join();
+				}
+				
+				// Stop listening first, or a connecting end that sees its peer go
+				// could reconnect into the backlog and send a batch that is lost
+				if(ListenSocket >= 0)
+				{
+					close(ListenSocket);
+					unlink(Config.SocketPath.c_str());
+					ListenSocket = -1;
+				}
+				PeersLock.Lock();
+				Peers.clear();
+				PeersLock.Unlock();
+				close(WakePipe[0]);
+				close(WakePipe[1]);
+				WakePipe[0] = -1;
+				WakePipe[1] = -1;
+			}
+
+			/** \brief Whether the transport is listening or connecting. */
+			FORCEINLINE bool IsOpen() const noexcept
+			{
+				return bIsOpen.load(std::memory_order_acquire);
+			}
+
+			/**
+			 * \brief Whether a connecting end has its connection, it doesn't while
+			 * it waits to reconnect.
+			 */
+			FORCEINLINE bool IsConnected()
+			{
+				return ListenSocket < 0 && GetConnectedPeer() != nullptr;
+			}
+
+			/**
+			 * \brief Send a batch to the end this one connected to. A listening end
+			 * has no one to send to, it replies from its batch handler instead.
+			 * \param Payload The batch, in the same format as a file.
+			 * \return Fails if it isn't connected, has no credits left, or the
+			 * write failed, the caller can keep the batch and retry.
+			 */
+			FORCEINLINE bool Send(
+				const ERequestType RequestType,
+				const ERequestPriority Priority,
+				const std::string_view Payload)
+			{
+				const std::shared_ptr<FSocketPeer> Peer = GetConnectedPeer();
+				if(!Peer || ListenSocket >= 0)
+				{
+					return false;
+				}
+				if(!Peer->TryTakeCredit())
+				{
+					SendsWithoutCredit.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				if(!Peer->SendFrame(ESocketFrameType::BATCH, RequestType, Priority, 0, Payload))
+				{
+					// Gone, the transport's thread will reconnect
+					const char Byte = 0;
+					(void)!write(WakePipe[1], &Byte, 1);
+					return false;
+				}
+				BatchesSent.fetch_add(1, std::memory_order_relaxed);
+				BytesSent.fetch_add(Payload.size(), std::memory_order_relaxed);
+				return true;
+			}
+
+			/** \brief Get a snapshot of the transport's counters. */
+			FORCEINLINE FSocketTransportStats GetStats()
+			{
+				FSocketTransportStats Stats;
+				Stats.BatchesSent = BatchesSent.load(std::memory_order_relaxed);
+				Stats.BatchesReceived = BatchesReceived.load(std::memory_order_relaxed);
+				Stats.BytesSent = BytesSent.load(std::memory_order_relaxed);
+				Stats.BytesReceived = BytesReceived.load(std::memory_order_relaxed);
+				Stats.SendsWithoutCredit = SendsWithoutCredit.load(std::memory_order_relaxed);
+				Stats.Reconnects = Reconnects.load(std::memory_order_relaxed);
+				PeersLock.Lock();
+				Stats.NumberOfPeers = static_cast<size_t>(std::count_if(Peers.begin(), Peers.end(),
+					[](const std::shared_ptr<FSocketPeer>& Peer) { return !Peer->IsClosed(); }));
+				PeersLock.Unlock();
+				return Stats;
+			}
+
+		private:
+			static FORCEINLINE bool MakeAddress(const std::string& SocketPath, sockaddr_un& OutAddress)
+			{
+				OutAddress = {};
+				OutAddress.sun_family = AF_UNIX;
+				if(SocketPath.empty() || SocketPath.size() >= sizeof(OutAddress.sun_path))
+				{
+					return false;
+				}
+				std::memcpy(OutAddress.sun_path, SocketPath.c_str(), SocketPath.size() + 1);
+				return true;
+			}
+
+			/**
+			 * \return The connected socket, or -1 if nothing is listening on SocketPath.
+			 */
+			static FORCEINLINE int ConnectSocket(const std::string& SocketPath)
+			{
+				sockaddr_un Address;
+				if(!MakeAddress(SocketPath, Address))
+				{
+					return -1;
+				}
+				const int Socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+				if(Socket < 0)
+				{
+					return -1;
+				}
+				if(connect(Socket, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0)
+				{
+					close(Socket);
+					return -1;
+				}
+				return Socket;
+			}
+
+			/**
+			 * \return The first peer whose connection hasn't broken, if any.
+			 */
+			FORCEINLINE std::shared_ptr<FSocketPeer> GetConnectedPeer()
+			{
+				std::shared_ptr<FSocketPeer> Connected;
+				PeersLock.Lock();
+				for(const std::shared_ptr<FSocketPeer>& Peer : Peers)
+				{
+					if(!Peer->IsClosed())
+					{
+						Connected = Peer;
+						break;
+					}
+				}
+				PeersLock.Unlock();
+				return Connected;
+			}
+
+			FORCEINLINE bool Open(const FSocketTransportConfig& InConfig, FBatchHandler&& OnBatch)
+			{
+				if(pipe2(WakePipe, O_CLOEXEC | O_NONBLOCK) != 0)
+				{
+					PeersLock.Lock();
+					Peers.clear();
+					PeersLock.Unlock();
+					if(ListenSocket >= 0)
+					{
+						close(ListenSocket);
+						ListenSocket = -1;
+					}
+					return false;
+				}
+				Config = InConfig;
+				BatchHandler = std::move(OnBatch);
+				bShouldStop.store(false, std::memory_order_release);
+				bIsOpen.store(true, std::memory_order_release);
+				Thread = std::thread([this]()
+				{
+					Run();
+				});
+				return true;
+			}
+
+			/**
+			 * \brief Start tracking a new connection and grant it its credits.
+			 */
+			FORCEINLINE void AddPeer(const int Socket, const uint32_t Credits)
+			{
+				std::shared_ptr<FSocketPeer> Peer = std::make_shared<FSocketPeer>(Socket);
+				Peer->GrantCredits(Credits);
+				PeersLock.Lock();
+				Peers.push_back(std::move(Peer));
+				PeersLock.Unlock();
+			}
+
+			/**
+			 * \brief The transport's thread, it sleeps in poll until a connection
+			 * arrives, a peer has data, or the transport is closed. A connecting
+			 * end that lost its peer also wakes to try to reconnect.
+			 */
+			FORCEINLINE void Run()
+			{
+				std::vector<pollfd> PollSockets;
+				std::vector<std::shared_ptr<FSocketPeer>> Polled;
+				std::string Reply;
+				std::chrono::steady_clock::time_point NextReconnect;
+				while(!bShouldStop.load(std::memory_order_acquire))
+				{
+					int TimeoutMS = -1;
+					PollSockets.clear();
+					Polled.clear();
+					PollSockets.push_back(pollfd{WakePipe[0], POLLIN, 0});
+					if(ListenSocket >= 0)
+					{
+						PollSockets.push_back(pollfd{ListenSocket, POLLIN, 0});
+					}
+					PeersLock.Lock();
+					// Forget the connections that broke since the last poll
+					Peers.erase(std::remove_if(Peers.begin(), Peers.end(),
+						[](const std::shared_ptr<FSocketPeer>& Peer) { return Peer->IsClosed(); }),
+						Peers.end());
+					Polled = Peers;
+					PeersLock.Unlock();
+					if(ListenSocket < 0 && Polled.empty())
+					{
+						// Until it's back the buffers write files, see IsConnected
+						const auto Now = std::chrono::steady_clock::now();
+						if(Now >= NextReconnect)
+						{
+							NextReconnect = Now + std::chrono::milliseconds(Config.ReconnectIntervalMS);
+							const int Socket = ConnectSocket(Config.SocketPath);
+							if(Socket >= 0)
+							{
+								AddPeer(Socket, Config.Credits);
+								Reconnects.fetch_add(1, std::memory_order_relaxed);
+								continue;
+							}
+						}
+						TimeoutMS = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+							NextReconnect - Now).count()) + 1;
+					}
+					const size_t FirstPeer = PollSockets.size();
+					for(const std::shared_ptr<FSocketPeer>& Peer : Polled)
+					{
+						short Events = POLLIN;
+						if(!Peer->GrantCredits(0))
+						{
+							// The socket is full or a sender has it, try again shortly
+							Events |= POLLOUT;
+							TimeoutMS = 1;
+						}
+						PollSockets.push_back(pollfd{Peer->GetSocket(), Events, 0});
+					}
+
+					if(poll(PollSockets.data(), PollSockets.size(), TimeoutMS) < 0)
+					{
+						continue;
+					}
+					if(ListenSocket >= 0 && (PollSockets[1].revents & POLLIN) != 0)
+					{
+						const int Socket = accept4(ListenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+						if(Socket >= 0)
+						{
+							AddPeer(Socket, Config.Credits);
+						}
+					}
+					for(size_t i = 0; i < Polled.size(); ++i)
+					{
+						if((PollSockets[FirstPeer + i].revents & ~POLLOUT) == 0)
+						{
+							continue;
+						}
+						FSocketPeer& Peer = *Polled[i];
+						const bool bIsConnected = Peer.Receive(Config.MaxFrameBytes,
+							[&](const FSocketFrameHeader& Header, const std::string& Payload)
+							{
+								BatchesReceived.fetch_add(1, std::memory_order_relaxed);
+								BytesReceived.fetch_add(Payload.size(), std::memory_order_relaxed);
+								Reply.clear();
+								if(BatchHandler)
+								{
+									BatchHandler(Header.RequestType, Header.Priority, Payload, Reply);
+								}
+								if(!Reply.empty())
+								{
+									Peer.QueueReply(Header.Priority, std::move(Reply));
+								}
+								// Handled, so the peer can send another
+								Peer.GrantCredits(1);
+							});
+						Peer.SendReplies([this](const size_t Bytes)
+						{
+							BatchesSent.fetch_add(1, std::memory_order_relaxed);
+							BytesSent.fetch_add(Bytes, std::memory_order_relaxed);
+						});
+						if(!bIsConnected || Peer.IsClosed())
+						{
+							PeersLock.Lock();
+							Peers.erase(std::remove(Peers.begin(), Peers.end(), Polled[i]), Peers.end());
+							PeersLock.Unlock();
+						}
+					}
+				}
+			}
+
+			int ListenSocket;
+			int WakePipe[2];
+			std::atomic<bool> bIsOpen;
+			std::atomic<bool> bShouldStop;
+			std::thread Thread;
+			FSocketTransportConfig Config;
+			FBatchHandler BatchHandler;
+			FSpinLoop<false> PeersLock;
+			std::vector<std::shared_ptr<FSocketPeer>> Peers;
+			
+			std::atomic<uint64_t> BatchesSent;
+			std::atomic<uint64_t> BatchesReceived;
+			std::atomic<uint64_t> BytesSent;
+			std::atomic<uint64_t> BytesReceived;
+			std::atomic<uint64_t> SendsWithoutCredit;
+			std::atomic<uint64_t> Reconnects;
+		};
+#endif
+		
+		/*
+		 * TODO Need to make sure any requests in the buffers are written to file
+		 * TODO upon shutdown of the threads & erasing the buffers...
+		 * TODO ... obivous data loss otherwise
+		 *
+		 * TODO
+		 */
+		template<ERequestBufferType TBufferRequestType>
+		class IPC_ALIGN_TO_CACHE_LINE FBufferThread
+		{
+			static constexpr int TickRate =
+				(TBufferRequestType == ERequestBufferType::UE) ?
+					(UE_BufferTickRateMS) : (AWS_BufferTickRateMS);
+			
+		public:
+			FBufferThread()
+				: IsRunning{false},
+				ShouldStop{false}
+			{
+			}
+			
+			/**
+			 * \brief Start the thread
+			 * \param Functor The functor that represents one tick of this thread.
+			 */
+			virtual FORCEINLINE void StartThread(
+				const std::function<void()>& Functor)
+			{
+				StartAdaptiveThread([=]() -> uint32_t
+				{
+					Functor();
+					return TickRate;
+				});
+			}
+
+			/**
+			 * \brief Start the thread, sleeping between ticks for as long as the
+			 * last tick asked for, or until @link Wake is called.
+			 * \param Functor One tick of this thread, returns how many milliseconds
+			 * until it next needs to run.
+			 */
+			virtual FORCEINLINE void StartAdaptiveThread(
+				const std::function<uint32_t()>& Functor)
+			{
+				if(IsRunning.exchange(true, std::memory_order_acq_rel))
+				{
+					return;
+				}
+				// A thread that was stopped can be started again
+				ShouldStop.store(false, std::memory_order_release);
+				
+				std::thread([=] ()
+				{
+					for(;;)
+					{
+						if(ShouldStop.load(std::memory_order_acquire))
+						{
+							break;
+						}
+
+						// Snapshot first, so a wake during the tick isn't slept through
+						const uint32_t SeenSequence = WakeEvent.Snapshot();
+						const uint32_t WaitMS = Functor();
+						WakeEvent.WaitFor(SeenSequence, (std::max)(WaitMS, static_cast<uint32_t>(1)));
+					}
+
+					IsRunning.store(false, std::memory_order_release);
+				}).detach();
+			}
+
+			/**
+			 * \brief Stop the thread from running.
+			 */
+			virtual FORCEINLINE void StopThread()
+			{
+				ShouldStop.store(true, std::memory_order_release);
+				WakeEvent.Notify();
+			}
+
+			/**
+			 * \brief Run the next tick now instead of waiting for the current sleep to end.
+			 */
+			FORCEINLINE void Wake() noexcept
+			{
+				WakeEvent.Notify();
+			}
+
+			/** \brief The event that wakes this thread before its next tick. */
+			FORCEINLINE FWakeEvent* GetWakeEvent() noexcept
+			{
+				return &WakeEvent;
+			}
+
+			/*
+			 * \brief Check whether or not the thread is currently running.
+			 */
+			virtual FORCEINLINE bool GetIsRunning() const
+			{
+				return IsRunning.load(std::memory_order_acquire);
+			}
+
+		private:
+			std::atomic<bool> IsRunning;
+			std::atomic<bool> ShouldStop;
+			FWakeEvent WakeEvent;
+		};
+		
+	public:
+		/**
+		 * \brief Thread safe in-memory @link IAWSBackend, for running the whole
+		 * UE -> AWS -> UE pipeline on one machine with no network.
+		 */
+		class FInMemoryBackend final : public IAWSBackend
+		{
+			static constexpr size_t NumberOfShards = 16;
+
+			struct IPC_ALIGN_TO_CACHE_LINE FShard
+			{
+				FSpinLoop<false> Lock;
+				std::unordered_map<std::string, FPlayerAttributeList> Players;
+			};
+			
+		public:
+			explicit FInMemoryBackend(const FInMemoryBackendConfig& InConfig = FInMemoryBackendConfig())
+				: Config(InConfig),
+				Tokens{static_cast<double>(InConfig.MaxPlayersPerSecond)},
+				LastRefill{std::chrono::steady_clock::now()},
+				NumberOfGets{0},
+				NumberOfSets{0},
+				NumberThrottled{0}
+			{
+			}
+
+			virtual EBackendResult GetPlayer(
+				const std::string& PlayerAuthID,
+				FPlayerAttributeList& OutAttributes) override
+			{
+				if(!BeginCall(1))
+				{
+					return EBackendResult::THROTTLED;
+				}
+				return GetPlayerUnthrottled(PlayerAuthID, OutAttributes);
+			}
+
+			virtual EBackendResult SetPlayer(const FPlayerAttributeList& InAttributes) override
+			{
+				if(!BeginCall(1))
+				{
+					return EBackendResult::THROTTLED;
+				}
+				return SetPlayerUnthrottled(InAttributes);
+			}
+
+			virtual void GetPlayers(
+				const std::vector<std::string>& PlayerAuthIDs,
+				std::vector<FPlayerAttributeList>& OutAttributes,
+				std::vector<EBackendResult>& OutResults) override
+			{
+				OutAttributes.resize(PlayerAuthIDs.size());
+				OutResults.resize(PlayerAuthIDs.size());
+				const bool bAllowed = BeginCall(PlayerAuthIDs.size());
+				for(size_t i = 0; i < PlayerAuthIDs.size(); ++i)
+				{
+					OutResults[i] = (bAllowed) ?
+						(GetPlayerUnthrottled(PlayerAuthIDs[i], OutAttributes[i])) :
+						(EBackendResult::THROTTLED);
+				}
+			}
+
+			virtual void SetPlayers(
+				const std::vector<FPlayerAttributeList>& InAttributes,
+				std::vector<EBackendResult>& OutResults) override
+			{
+				OutResults.resize(InAttributes.size());
+				const bool bAllowed = BeginCall(InAttributes.size());
+				for(size_t i = 0; i < InAttributes.size(); ++i)
+				{
+					OutResults[i] = (bAllowed) ?
+						(SetPlayerUnthrottled(InAttributes[i])) :
+						(EBackendResult::THROTTLED);
+				}
+			}
+
+			/** \brief How many GETs have been answered. */
+			FORCEINLINE uint64_t GetNumberOfGets() const noexcept
+			{
+				return NumberOfGets.load(std::memory_order_relaxed);
+			}
+
+			/** \brief How many SETs have been applied. */
+			FORCEINLINE uint64_t GetNumberOfSets() const noexcept
+			{
+				return NumberOfSets.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * \return How many players were refused by throttling.
+			 */
+			FORCEINLINE uint64_t GetNumberThrottled() const noexcept
+			{
+				return NumberThrottled.load(std::memory_order_relaxed);
+			}
+
+		private:
+			FORCEINLINE EBackendResult GetPlayerUnthrottled(
+				const std::string& PlayerAuthID,
+				FPlayerAttributeList& OutAttributes)
+			{
+				NumberOfGets.fetch_add(1, std::memory_order_relaxed);
+				FShard& Shard = GetShard(PlayerAuthID);
+				EBackendResult Result = EBackendResult::NOT_FOUND;
+				Shard.Lock.Lock();
+				const auto Found = Shard.Players.find(PlayerAuthID);
+				if(Found != Shard.Players.end())
+				{
+					OutAttributes = Found->second;
+					Result = EBackendResult::OK;
+				}
+				Shard.Lock.Unlock();
+				return Result;
+			}
+
+			FORCEINLINE EBackendResult SetPlayerUnthrottled(const FPlayerAttributeList& InAttributes)
+			{
+				const std::string& PlayerAuthID = InAttributes.GetPlayerAuthID().Value;
+				if(PlayerAuthID.empty())
+				{
+					return EBackendResult::FAILED;
+				}
+				NumberOfSets.fetch_add(1, std::memory_order_relaxed);
+				FShard& Shard = GetShard(PlayerAuthID);
+				Shard.Lock.Lock();
+				MergePlayerAttributes(InAttributes, Shard.Players[PlayerAuthID]);
+				Shard.Lock.Unlock();
+				return EBackendResult::OK;
+			}
+
+			FORCEINLINE FShard& GetShard(const std::string& PlayerAuthID)
+			{
+				return Shards[std::hash<std::string>()(PlayerAuthID) % NumberOfShards];
+			}
+
+			/**
+			 * \brief Take NumberOfPlayers tokens from the throttle and then sleep
+			 * for the configured latency.
+			 * \return Fails if the call is throttled, throttled calls still pay the latency.
+			 */
+			FORCEINLINE bool BeginCall(const size_t NumberOfPlayers)
+			{
+				bool bAllowed = true;
+				if(Config.MaxPlayersPerSecond != 0)
+				{
+					const double Rate = static_cast<double>(Config.MaxPlayersPerSecond);
+					ThrottleLock.Lock();
+					const auto Now = std::chrono::steady_clock::now();
+					Tokens = (std::min)(Rate, Tokens + Rate *
+						std::chrono::duration<double>(Now - LastRefill).count());
+					LastRefill = Now;
+					if(Tokens >= static_cast<double>(NumberOfPlayers))
+					{
+						Tokens -= static_cast<double>(NumberOfPlayers);
+					}
+					else
+					{
+						bAllowed = false;
+					}
+					ThrottleLock.Unlock();
+					if(!bAllowed)
+					{
+						NumberThrottled.fetch_add(NumberOfPlayers, std::memory_order_relaxed);
+					}
+				}
+
+				uint32_t LatencyUs = Config.LatencyUs;
+				if(Config.LatencyJitterUs != 0)
+				{
+					thread_local std::minstd_rand Random(static_cast<uint32_t>(
+						std::hash<std::thread::id>()(std::this_thread::get_id())));
+					LatencyUs += Random() % (Config.LatencyJitterUs + 1);
+				}
+				if(LatencyUs != 0)
+				{
+					std::this_thread::sleep_for(std::chrono::microseconds(LatencyUs));
+				}
+				return bAllowed;
+			}
+			
+			const FInMemoryBackendConfig Config;
+			FSpinLoop<false> ThrottleLock;
+			double Tokens;
+			std::chrono::steady_clock::time_point LastRefill;
+			std::atomic<uint64_t> NumberOfGets;
+			std::atomic<uint64_t> NumberOfSets;
+			std::atomic<uint64_t> NumberThrottled;
+			std::array<FShard, NumberOfShards> Shards;
+		};
+		
+		template<typename T, EAttributeTypes TAttributeType> using FColumnAttribute	=
+			TableDataStatics::Internal::IColumnAttribute<T, TAttributeType>;
+		
+		inline static const FColumnAttribute<std::string, EAttributeTypes::STRING>
+			TableKey_PlayerAuthID = TableDataStatics::TableKey_PlayerAuthID;
+		inline static const FColumnAttribute<std::string, EAttributeTypes::STRING>
+			TableKey_PlayerName = TableDataStatics::TableKey_PlayerName;
+		inline static const FColumnAttribute<std::string, EAttributeTypes::STRING>
+			TableKey_IsOnline = TableDataStatics::TableKey_IsOnline;
+
+		template<ERequestBufferType TBufferRequestType> using FWriteBufferThread =
+			FBufferThread<TBufferRequestType>;
+		template<ERequestBufferType TBufferRequestType> using FReadBufferThread =
+			FBufferThread<TBufferRequestType>;
+		
+		IPCFileManager() = default;
+		~IPCFileManager() = default;
+
+
+		
+		/* 
+		 * The AWS Process will never need to make a get request to the
+		 * unreal process, the AWS process will only make a set request to
+		 * the unreal process, after the unreal process makes a get request
+		 *
+		 * UE get request -> AWS Process -> Loads from DynamoDB ->
+		 * AWS set request -> UE Process
+		 *
+		 * UE set request -> AWS Process -> Set in DynamoDB
+		 */
+		
+		/*
+		 * #################################################
+		 * ############### UNREAL FUNCTIONS ################
+		 * #################################################
+		 */
+		
+		/**
+		 * \brief Initialize the system on the UE side
+		 */
+		static FORCEINLINE void UE_Initialize()
+		{
+			Initialize();
+			UE_CompactGetRequestBuffer.Initialize();
+			UE_CompactSetRequestBuffer.Initialize();
+			UE_CompactPendingGetRequests.Initialize();
+			UE_GetRequestBuffer.Initialize();
+			UE_GetRequestBuffer.SetWakeEvent(UE_GetWriteThread.GetWakeEvent());
+			UE_CompactGetRequestBuffer.SetWakeEvent(UE_GetWriteThread.GetWakeEvent());
+			UE_GetWriteThread.StartAdaptiveThread([=]() -> uint32_t
+			{
+				UE_PriorityGetLane.FlushIfDue();
+#if IPC_HAS_SEGMENT_FILES
+				UE_SegmentPool.RotateIfDue();
+#endif
+				if(bUseCompactRequestBuffers.load(std::memory_order_relaxed))
+				{
+					return FlushBufferIfTriggered(UE_CompactGetRequestBuffer,
+						UE_GetRequestFlushConfig, UE_BufferTickRateMS);
+				}
+				return FlushBufferIfTriggered(UE_GetRequestBuffer,
+					UE_GetRequestFlushConfig, UE_BufferTickRateMS);
+			});
+			
+			UE_SetRequestBuffer.Initialize();
+			UE_SetRequestBuffer.SetWakeEvent(UE_SetWriteThread.GetWakeEvent());
+			UE_CompactSetRequestBuffer.SetWakeEvent(UE_SetWriteThread.GetWakeEvent());
+			UE_SetWriteThread.StartAdaptiveThread([=]() -> uint32_t
+			{
+				UE_PrioritySetLane.FlushIfDue();
+#if IPC_HAS_SEGMENT_FILES
+				UE_SegmentPool.RotateIfDue();
+#endif
+				if(bUseCompactRequestBuffers.load(std::memory_order_relaxed))
+				{
+					return FlushBufferIfTriggered(UE_CompactSetRequestBuffer,
+						UE_SetRequestFlushConfig, UE_BufferTickRateMS);
+				}
+				return FlushBufferIfTriggered(UE_SetRequestBuffer,
+					UE_SetRequestFlushConfig, UE_BufferTickRateMS);
+			});
+
+			UE_SetReadThread.StartThread([=]()
+			{
+				UE_ConsumeResponseFiles();
+			});
+
+			UE_GetPendingRequestsBuffer.Initialize();
+			UE_GetPendingThread.StartThread([=]()
+			{
+				UE_ExpireAsyncGets();
+			});
+		}
+		
+		/**
+		 * \brief Shutdown the threads and erase all buffers on the UE side
+		 */
+		static FORCEINLINE void UE_Shutdown()
+		{
+			UE_SetWriteThread.StopThread();
+			UE_SetReadThread.StopThread();
+			UE_GetWriteThread.StopThread();
+			UE_GetPendingThread.StopThread();
+			
+			// Wait for all threads to shutdown before erasing the buffers...
+			while(UE_SetWriteThread.GetIsRunning() ||
+				UE_SetReadThread.GetIsRunning() ||
+				UE_GetWriteThread.GetIsRunning() ||
+				UE_GetPendingThread.GetIsRunning())
+			{
+				std::this_thread::sleep_for(
+					std::chrono::milliseconds(10));
+			}
+#if IPC_HAS_UNIX_SOCKETS
+			UE_Transport.Close();
+#endif
+#if IPC_HAS_SEGMENT_FILES
+			UE_SegmentPool.Close();
+#endif
+			UE_GetRequestBuffer.Clear();
+			UE_SetRequestBuffer.Clear();
+			UE_GetPendingRequestsBuffer.Clear();
+			UE_CompactGetRequestBuffer.Clear();
+			UE_CompactSetRequestBuffer.Clear();
+			UE_CompactPendingGetRequests.Clear();
+			UE_PriorityGetLane.Clear();
+			UE_PrioritySetLane.Clear();
+			UE_CancelAsyncGets();
+			Shutdown();
+		}
+
+		/**
+		 * \brief Store UE requests as pooled @link FCompactRequest records instead
+		 * of @link FGetRequest / @link FSetRequest objects. Call before @link UE_Initialize.
+		 * The compact buffers take their capacity and backpressure policy from
+		 * the same UE_Configure*Buffer calls as the regular ones.
+		 */
+		static FORCEINLINE void UE_SetUseCompactRequestBuffers(
+			const bool bUseCompact) noexcept
+		{
+			bUseCompactRequestBuffers.store(bUseCompact, std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Choose how both sides write their records from now on. Files,
+		 * segments and socket batches are read whichever encoding they hold.
+		 */
+		static FORCEINLINE void SetRecordEncoding(const ERecordEncoding Encoding) noexcept
+		{
+			RecordEncoding.store(Encoding, std::memory_order_relaxed);
+		}
+
+		/** \brief How records are written, see @link SetRecordEncoding. */
+		static FORCEINLINE ERecordEncoding GetRecordEncoding() noexcept
+		{
+			return RecordEncoding.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Add a @link FGetRequest to the buffer
+		 * \param GetRequest The @link FGetRequest to add to the buffer
+		 * \return Whether or not the Add worked
+		 */
+		static FORCEINLINE bool UE_AddGetRequestToBuffer(
+			const FGetRequest& GetRequest)
+		{
+			if(GetRequest.IsEmpty())
+			{
+				return false;
+			}
+			if(GetRequest.GetPriority() == ERequestPriority::HIGH)
+			{
+				return UE_AddPriorityGetRequest(GetRequest);
+			}
+			if(bUseCompactRequestBuffers.load(std::memory_order_relaxed))
+			{
+				return UE_AddCompactGetRequest(GetRequest);
+			}
+			// Pending first, a response can't arrive before the GET is in its buffer
+			if(!UE_AddPendingGetRequest(FPendingGetRequest(GetRequest)))
+			{
+				return false;
+			}
+			if(!UE_GetRequestBuffer.PushBack(GetRequest))
+			{
+				UE_RemovePendingGetRequest(GetRequest.GetRequestID());
+				return false;
+			}
+			UE_FailDroppedGetRequests();
+			return true;
+		}
+
+		/**
+		 * \brief Move a @link FGetRequest into the buffer. The pending copy is the
+		 * only copy made, GetRequest is moved from if this returns true.
+		 * \param GetRequest The @link FGetRequest to add to the buffer
+		 * \return Whether or not the Add worked
+		 */
+		static FORCEINLINE bool UE_AddGetRequestToBuffer(
+			FGetRequest&& GetRequest)
+		{
+			if(GetRequest.IsEmpty())
+			{
+				return false;
+			}
+			if(GetRequest.GetPriority() == ERequestPriority::HIGH)
+			{
+				return UE_AddPriorityGetRequest(std::move(GetRequest));
+			}
+			if(bUseCompactRequestBuffers.load(std::memory_order_relaxed))
+			{
+				return UE_AddCompactGetRequest(GetRequest);
+			}
+			const FRequestID RequestID = GetRequest.GetRequestID();
+			if(!UE_AddPendingGetRequest(FPendingGetRequest(GetRequest)))
+			{
+				return false;
+			}
+			if(!UE_GetRequestBuffer.PushBack(std::move(GetRequest)))
+			{
+				UE_RemovePendingGetRequest(RequestID);
+				return false;
+			}
+			UE_FailDroppedGetRequests();
+			return true;
+		}
+
+		/**
+		 * \brief Construct a @link FGetRequest once and move it into the buffer.
+		 * \param Args The arguments for one of the @link FGetRequest constructors.
+		 * \return Whether or not the Add worked
+		 */
+		template<typename... TArgs>
+		static FORCEINLINE bool UE_EmplaceGetRequestToBuffer(TArgs&&... Args)
+		{
+			return UE_AddGetRequestToBuffer(FGetRequest(std::forward<TArgs>(Args)...));
+		}
+
+		/**
+		 * \brief Buffer a GET and get a future that resolves when its response
+		 * is consumed by @link UE_ConsumeGetResponseFile or @link UE_ResolveGetResponse.
+		 * If the GET can't be buffered, or its request ID is already waiting for a
+		 * response, the future is already @link EAsyncGetStatus::FAILED.
+		 * \param GetRequest The @link FGetRequest to send.
+		 * \param TimeoutMS How long to wait for the response before the future
+		 * resolves with @link EAsyncGetStatus::TIMED_OUT.
+		 * \param Delivery With @link ECompletionDelivery::QUEUED the future only
+		 * completes, and its continuation only runs, inside @link UE_DispatchCompletions.
+		 */
+		static FORCEINLINE FGetFuture UE_GetAsync(
+			FGetRequest GetRequest,
+			const uint32_t TimeoutMS = ASYNC_GET_TIMEOUT_MS,
+			const ECompletionDelivery Delivery = ECompletionDelivery::INLINE)
+		{
+			std::shared_ptr<FAsyncGetState> State = std::make_shared<FAsyncGetState>(
+				GetRequest.GetRequestID(),
+				GetRequest.GetPlayerAuthIDString(),
+				std::chrono::steady_clock::now() + std::chrono::milliseconds(TimeoutMS),
+				Delivery);
+			
+			// Register before buffering so a fast response can't be missed
+			UE_AsyncGetLock.Lock();
+			const bool bRegistered = UE_AsyncGets.emplace(State->GetRequestID(), State).second;
+			UE_AsyncGetLock.Unlock();
+			if(!bRegistered)
+			{
+				// Responses are matched by request ID, a reused one could never resolve
+				UE_CompleteAsyncGet(State, EAsyncGetStatus::FAILED);
+			}
+			else if(!UE_AddGetRequestToBuffer(std::move(GetRequest)) &&
+				UE_RemoveAsyncGet(State))
+			{
+				UE_CompleteAsyncGet(State, EAsyncGetStatus::FAILED);
+			}
+			return FGetFuture(std::move(State));
+		}
+
+		/**
+		 * \brief Resolve the asynchronous GET a response answers, and stop
+		 * tracking it, or the plain GET it answers, as pending. A response for a GET that already timed out
+		 * resolves nothing, so it can't answer a newer GET for the same player.
+		 * \param RequestID The request ID the response carried, with
+		 * @link RequestIDStatics::None every GET for the player is resolved.
+		 * \param Response The attributes read back from the AWS side.
+		 * \return How many GETs were resolved.
+		 */
+		static FORCEINLINE size_t UE_ResolveGetResponse(
+			const FRequestID RequestID,
+			const FPlayerAttributeList& Response)
+		{
+			// Plain GETs have no async state, their pending entry goes here
+			UE_RemovePendingGetRequest(RequestID);
+
+			std::vector<std::shared_ptr<FAsyncGetState>> Resolved;
+			UE_AsyncGetLock.Lock();
+			if(RequestID != RequestIDStatics::None)
+			{
+				const auto Found = UE_AsyncGets.find(RequestID);
+				if(Found != UE_AsyncGets.end())
+				{
+					Resolved.push_back(std::move(Found->second));
+					UE_AsyncGets.erase(Found);
+				}
+			}
+			else
+			{
+				// Only records from writers that predate request IDs get here
+				const std::string& PlayerAuthID = Response.GetPlayerAuthID().Value;
+				for(auto It = UE_AsyncGets.begin(); It != UE_AsyncGets.end();)
+				{
+					if(It->second->GetPlayerAuthID() == PlayerAuthID)
+					{
+						Resolved.push_back(std::move(It->second));
+						It = UE_AsyncGets.erase(It);
+					}
+					else
+					{
+						++It;
+					}
+				}
+			}
+			UE_AsyncGetLock.Unlock();
+
+			// Continuations run without the lock held, they may start new GETs
+			for(const std::shared_ptr<FAsyncGetState>& State : Resolved)
+			{
+				UE_RemovePendingGetRequest(State->GetRequestID());
+				UE_CompleteAsyncGet(State, EAsyncGetStatus::READY, &Response);
+			}
+			return Resolved.size();
+		}
+
+		/**
+		 * \brief Read a response file written by the AWS side and resolve the
+		 * asynchronous GETs it answers.
+		 * \param FileLocation The full path of the file.
+		 * \return How many GETs were resolved.
+		 */
+		static FORCEINLINE size_t UE_ConsumeGetResponseFile(const std::string& FileLocation)
+		{
+			std::vector<FSetRequest> Responses;
+			ReadSetRequestsFromFile(FileLocation, Responses);
+			size_t NumberResolved = 0;
+			for(const FSetRequest& Response : Responses)
+			{
+				NumberResolved += UE_ResolveGetResponse(Response.GetRequestID(),
+					Response.GetPlayerAttributeList());
+			}
+			return NumberResolved;
+		}
+
+		/**
+		 * \brief Set the directory the AWS side writes its GET responses to, see
+		 * @link FAWSProcessorConfig::OutboxDirectory. The UE read thread then
+		 * consumes every response file that appears there, see
+		 * @link UE_ConsumeResponseFiles. Empty stops the scanning.
+		 */
+		static FORCEINLINE void UE_SetResponseDirectory(const std::string& Directory)
+		{
+			UE_ResponseScanLock.Lock();
+			UE_ResponseScanner.SetDirectory(Directory,
+				static_cast<uint8_t>(1 << static_cast<uint8_t>(ERequestType::SET)));
+			UE_ResponseReadAttempts.clear();
+			UE_ResponseScanLock.Unlock();
+		}
+
+		/**
+		 * \brief Resolve the asynchronous GETs answered by the response files
+		 * that appeared in the response directory since the last scan, then
+		 * remove the files. A file that fails its integrity check may still be
+		 * being written, so it is read again on later scans before what verified
+		 * is taken as all there is. Runs on the UE read thread each tick, so it
+		 * only needs calling by hand when the threads are not running.
+		 * \return How many GETs were resolved.
+		 */
+		static FORCEINLINE size_t UE_ConsumeResponseFiles()
+		{
+			std::vector<FDirectoryScanner::FScannedFile> Scanned;
+			UE_ResponseScanLock.Lock();
+			if(!UE_ResponseScanner.GetDirectory().empty())
+			{
+				UE_ResponseScanner.Scan(Scanned);
+			}
+			UE_ResponseScanLock.Unlock();
+
+			size_t NumberResolved = 0;
+			std::vector<FSetRequest> Responses;
+			for(const FDirectoryScanner::FScannedFile& File : Scanned)
+			{
+				Responses.clear();
+				const bool bVerified = ReadSetRequestsFromFile(File.Path, Responses);
+				// Resolving twice is harmless, a resolved GET is no longer tracked
+				for(const FSetRequest& Response : Responses)
+				{
+					NumberResolved += UE_ResolveGetResponse(Response.GetRequestID(),
+						Response.GetPlayerAttributeList());
+				}
+
+				UE_ResponseScanLock.Lock();
+				if(!bVerified && ++UE_ResponseReadAttempts[File.Path] < MaxResponseReadAttempts)
+				{
+					UE_ResponseScanner.Forget(File.Path);
+					UE_ResponseScanLock.Unlock();
+					continue;
+				}
+				UE_ResponseReadAttempts.erase(File.Path);
+				UE_ResponseScanLock.Unlock();
+				std::error_code Error;
+				std::filesystem::remove(File.Path, Error);
+			}
+			return NumberResolved;
+		}
+
+#if IPC_HAS_UNIX_SOCKETS
+		/**
+		 * \brief Open one persistent connection to the AWS process over a Unix
+		 * domain socket. While it is connected the UE buffers send their batches
+		 * over it instead of writing files, and the responses that come back
+		 * resolve the asynchronous GETs on the transport's own thread. If the AWS
+		 * process goes away the buffers go back to files until it reconnects.
+		 * \return Fails if it is already open or nothing is listening on the socket.
+		 */
+		static FORCEINLINE bool UE_ConnectTransport(const FSocketTransportConfig& Config)
+		{
+			return UE_Transport.Connect(Config, [SocketPath = Config.SocketPath](
+				const ERequestType RequestType,
+				const ERequestPriority /*Priority*/,
+				const std::string& Payload,
+				std::string& /*OutReply*/)
+			{
+				if(RequestType != ERequestType::SET)
+				{
+					return;
+				}
+				std::vector<std::string> Records;
+				VerifyRecordsFromText(SocketPath, Payload, Records);
+				for(const std::string& Record : Records)
+				{
+					FPlayerAttributeList Response;
+					FRequestID RequestID;
+					if(ParseSetRecord(Record, Response, RequestID))
+					{
+						UE_ResolveGetResponse(RequestID, Response);
+					}
+				}
+			});
+		}
+
+		/**
+		 * \brief Close the connection to the AWS process and go back to writing files.
+		 */
+		static FORCEINLINE void UE_DisconnectTransport()
+		{
+			UE_Transport.Close();
+		}
+
+		/** \brief Get a snapshot of the UE end's socket transport counters. */
+		static FORCEINLINE FSocketTransportStats UE_GetTransportStats()
+		{
+			return UE_Transport.GetStats();
+		}
+#endif
+
+#if IPC_HAS_SEGMENT_FILES
+		/**
+		 * \brief Write the batches flushed to Config.Directory into a pool of
+		 * preallocated segment files, which the AWS processor consumes and hands
+		 * back, instead of creating and deleting a file per batch. Batches that
+		 * don't fit, or that find every segment busy, are still written as files.
+		 * With Config.bStreamRecords the records are appended to a stream the
+		 * AWS processor reads while it is being written.
+		 * \return Fails if a pool is already open or its files couldn't be created.
+		 */
+		static FORCEINLINE bool UE_OpenSegmentPool(const FSegmentPoolConfig& Config)
+		{
+			return UE_SegmentPool.Open(Config);
+		}
+
+		/**
+		 * \brief Go back to a file per batch, the segment files are kept for reuse.
+		 */
+		static FORCEINLINE void UE_CloseSegmentPool()
+		{
+			UE_SegmentPool.Close();
+		}
+
+		/** \brief Get a snapshot of the UE segment pool's counters. */
+		static FORCEINLINE FSegmentPoolStats UE_GetSegmentPoolStats()
+		{
+			return UE_SegmentPool.GetStats();
+		}
+#endif
+
+		/**
+		 * \brief Time out every asynchronous GET past its deadline. Runs on the
+		 * UE pending thread each tick, so it only needs calling by hand when the
+		 * threads are not running.
+		 * \return How many GETs timed out.
+		 */
+		static FORCEINLINE size_t UE_ExpireAsyncGets()
+		{
+			const auto Now = std::chrono::steady_clock::now();
+			std::vector<std::shared_ptr<FAsyncGetState>> Expired;
+			UE_AsyncGetLock.Lock();
+			for(auto It = UE_AsyncGets.begin(); It != UE_AsyncGets.end();)
+			{
+				if(It->second->GetDeadline() <= Now)
+				{
+					Expired.push_back(std::move(It->second));
+					It = UE_AsyncGets.erase(It);
+				}
+				else
+				{
+					++It;
+				}
+			}
+			UE_AsyncGetLock.Unlock();
+
+			for(const std::shared_ptr<FAsyncGetState>& State : Expired)
+			{
+				UE_RemovePendingGetRequest(State->GetRequestID());
+				UE_CompleteAsyncGet(State, EAsyncGetStatus::TIMED_OUT);
+			}
+			return Expired.size();
+		}
+
+		/**
+		 * \return How many asynchronous GETs are waiting for a response.
+		 */
+		static FORCEINLINE size_t UE_GetNumberOfAsyncGets()
+		{
+			UE_AsyncGetLock.Lock();
+			const size_t NumberOfGets = UE_AsyncGets.size();
+			UE_AsyncGetLock.Unlock();
+			return NumberOfGets;
+		}
+
+		/**
+		 * \brief Set the function @link UE_DispatchCompletions calls for every
+		 * completion, GET responses and SET acknowledgements alike.
+		 */
+		static FORCEINLINE void UE_SetCompletionHandler(
+			std::function<void(const FIPCCompletion&)> Handler)
+		{
+			std::shared_ptr<const std::function<void(const FIPCCompletion&)>> NewHandler;
+			if(Handler)
+			{
+				NewHandler = std::make_shared<const std::function<void(const FIPCCompletion&)>>(
+					std::move(Handler));
+			}
+			UE_CompletionHandlerLock.Lock();
+			UE_CompletionHandler.swap(NewHandler);
+			UE_CompletionHandlerLock.Unlock();
+		}
+
+		/**
+		 * \brief Queue an acknowledgement for every UE SET once the file it is in
+		 * has been written, or has failed to write.
+		 */
+		static FORCEINLINE void UE_SetAcknowledgeSetRequests(const bool bAcknowledge) noexcept
+		{
+			bAcknowledgeSetRequests.store(bAcknowledge, std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Deliver queued completions on the calling thread, usually the game
+		 * thread once per frame. Queued async GETs complete here, so their Then
+		 * callbacks and coroutines run here too. Only one thread dispatches at a
+		 * time, a call made while another is dispatching returns 0.
+		 * \param MaxCount The most completions to deliver, 0 for no limit.
+		 * \param TimeBudgetUs Stop once this long has been spent, 0 for no limit.
+		 * The completion that crosses the budget is still delivered.
+		 * \return How many completions were delivered.
+		 */
+		static FORCEINLINE size_t UE_DispatchCompletions(
+			const size_t MaxCount,
+			const uint32_t TimeBudgetUs)
+		{
+			if(bIsDispatchingCompletions.exchange(true, std::memory_order_acquire))
+			{
+				return 0;
+			}
+			
+			UE_CompletionHandlerLock.Lock();
+			const std::shared_ptr<const std::function<void(const FIPCCompletion&)>> Handler =
+				UE_CompletionHandler;
+			UE_CompletionHandlerLock.Unlock();
+			
+			const auto Deadline = std::chrono::steady_clock::now() +
+				std::chrono::microseconds(TimeBudgetUs);
+			size_t NumberDispatched = 0;
+			FQueuedCompletion Queued;
+			while((MaxCount == 0 || NumberDispatched < MaxCount) &&
+				UE_CompletionQueue.Pop(Queued))
+			{
+				if(Queued.State)
+				{
+					Queued.State->Complete(Queued.Completion.Status,
+						&Queued.Completion.Attributes);
+					Queued.State.reset();
+				}
+				if(Handler)
+				{
+					(*Handler)(Queued.Completion);
+				}
+				++NumberDispatched;
+				if(TimeBudgetUs != 0 && std::chrono::steady_clock::now() >= Deadline)
+				{
+					break;
+				}
+			}
+			
+			bIsDispatchingCompletions.store(false, std::memory_order_release);
+			return NumberDispatched;
+		}
+		
+		/**
+		 * \brief Add a contiguous range of @link FGetRequest, taking each buffer
+		 * lock as few times as possible.
+		 * \param GetRequests The first request in the range.
+		 * \param Count The number of requests in the range.
+		 * \return How many requests from the front of the range were added.
+		 */
+		static FORCEINLINE size_t UE_AddGetRequestsToBuffer(
+			const FGetRequest* GetRequests,
+			const size_t Count)
+		{
+			return AddGetRequestRange<false>(GetRequests, Count);
+		}
+
+		/**
+		 * \brief Move a contiguous range of @link FGetRequest into the buffer, see
+		 * @link UE_AddGetRequestsToBuffer. Only the added requests are moved from.
+		 */
+		static FORCEINLINE size_t UE_MoveGetRequestsToBuffer(
+			FGetRequest* GetRequests,
+			const size_t Count)
+		{
+			return AddGetRequestRange<true>(GetRequests, Count);
+		}
+		
+		/**
+		 * \brief Add a @link FSetRequest to the buffer
+		 * \param SetRequest The @link FSetRequest to add to the buffer
+		 * \return Whether or not the Add worked
+		 */
+		static FORCEINLINE bool UE_AddSetRequestToBuffer(
+			const FSetRequest& SetRequest)
+		{
+			return UE_AddSetRequestInternal(SetRequest);
+		}
+
+		/**
+		 * \brief Move a @link FSetRequest into the buffer, SetRequest is moved
+		 * from if this returns true.
+		 * \param SetRequest The @link FSetRequest to add to the buffer
+		 * \return Whether or not the Add worked
+		 */
+		static FORCEINLINE bool UE_AddSetRequestToBuffer(
+			FSetRequest&& SetRequest)
+		{
+			return UE_AddSetRequestInternal(std::move(SetRequest));
+		}
+
+		/**
+		 * \brief Construct a @link FSetRequest once and move it into the buffer.
+		 * \param Args The arguments for one of the @link FSetRequest constructors.
+		 * \return Whether or not the Add worked
+		 */
+		template<typename... TArgs>
+		static FORCEINLINE bool UE_EmplaceSetRequestToBuffer(TArgs&&... Args)
+		{
+			return UE_AddSetRequestToBuffer(FSetRequest(std::forward<TArgs>(Args)...));
+		}
+
+		/**
+		 * \brief Add a contiguous range of @link FSetRequest, taking the buffer
+		 * lock as few times as possible.
+		 * \param SetRequests The first request in the range.
+		 * \param Count The number of requests in the range.
+		 * \return How many requests from the front of the range were added.
+		 */
+		static FORCEINLINE size_t UE_AddSetRequestsToBuffer(
+			const FSetRequest* SetRequests,
+			const size_t Count)
+		{
+			if(bUseDeltaSetRequests.load(std::memory_order_relaxed))
+			{
+				size_t NumberAdded = 0;
+				while(NumberAdded < Count &&
+					UE_AddSetRequestToBuffer(SetRequests[NumberAdded]))
+				{
+					++NumberAdded;
+				}
+				return NumberAdded;
+			}
+			return AddSetRequestRange<false>(UE_SetRequestBuffer, UE_PrioritySetLane,
+				SetRequests, Count,
+				bUseCompactRequestBuffers.load(std::memory_order_relaxed));
+		}
+
+		/**
+		 * \brief Move a contiguous range of @link FSetRequest into the buffer, see
+		 * @link UE_AddSetRequestsToBuffer. Only the added requests are moved from.
+		 */
+		static FORCEINLINE size_t UE_MoveSetRequestsToBuffer(
+			FSetRequest* SetRequests,
+			const size_t Count)
+		{
+			if(bUseDeltaSetRequests.load(std::memory_order_relaxed))
+			{
+				size_t NumberAdded = 0;
+				while(NumberAdded < Count &&
+					UE_AddSetRequestToBuffer(std::move(SetRequests[NumberAdded])))
+				{
+					++NumberAdded;
+				}
+				return NumberAdded;
+			}
+			return AddSetRequestRange<true>(UE_SetRequestBuffer, UE_PrioritySetLane,
+				SetRequests, Count,
+				bUseCompactRequestBuffers.load(std::memory_order_relaxed));
+		}
+		
+		/**
+		 * \brief Take the pending GET a response was for out of the pending buffer.
+		 * \param RequestID The request ID the response carried.
+		 * \param OutRequest Receives the pending request if it was found.
+		 * \return Whether or not there was a pending GET with that ID.
+		 */
+		static FORCEINLINE bool UE_TakePendingGetRequest(
+			const FRequestID RequestID,
+			FPendingGetRequest& OutRequest)
+		{
+			return UE_GetPendingRequestsBuffer.TakeByRequestID(RequestID, OutRequest);
+		}
+
+		/**
+		 * \brief Set the capacity and backpressure policy of the UE @link FGetRequestBuffer
+		 */
+		static FORCEINLINE void UE_ConfigureGetRequestBuffer(
+			const FBufferCapacityConfig& Config)
+		{
+			UE_GetRequestBuffer.Configure(Config);
+			UE_CompactGetRequestBuffer.Configure(Config);
+		}
+
+		/**
+		 * \brief Set the capacity and backpressure policy of the UE @link FPendingGetRequestBuffer.
+		 * It has no file format, so @link EBackpressurePolicy::SPILL_TO_DISK rejects instead.
+		 */
+		static FORCEINLINE void UE_ConfigurePendingGetRequestBuffer(
+			const FBufferCapacityConfig& Config)
+		{
+			UE_GetPendingRequestsBuffer.Configure(Config);
+			// The compact table would spill as GET requests, so it has to reject too
+			FBufferCapacityConfig CompactConfig = Config;
+			if(CompactConfig.Policy == EBackpressurePolicy::SPILL_TO_DISK)
+			{
+				CompactConfig.Policy = EBackpressurePolicy::REJECT;
+			}
+			UE_CompactPendingGetRequests.Configure(CompactConfig);
+		}
+
+		/**
+		 * \brief Set where and how soon the UE @link ERequestPriority::HIGH lanes
+		 * flush themselves.
+		 */
+		static FORCEINLINE void UE_ConfigurePriorityLanes(
+			const FPriorityLaneConfig& Config)
+		{
+			UE_PriorityGetLane.Configure(Config);
+			UE_PrioritySetLane.Configure(Config);
+		}
+
+		/**
+		 * \brief Set when the UE GET buffer is flushed to file by its write thread.
+		 * Applies to the compact GET buffer too.
+		 */
+		static FORCEINLINE void UE_ConfigureGetRequestFlush(
+			const FFlushTriggerConfig& Config)
+		{
+			FlushConfigLock.RunLambdaThroughLock([&]()
+			{
+				UE_GetRequestFlushConfig = Config;
+			});
+			UE_GetRequestBuffer.ConfigureFlushTrigger(Config);
+			UE_CompactGetRequestBuffer.ConfigureFlushTrigger(Config);
+			UE_GetWriteThread.Wake();
+		}
+
+		/**
+		 * \brief Set when the UE SET buffer is flushed to file by its write thread.
+		 * Applies to the compact SET buffer too.
+		 */
+		static FORCEINLINE void UE_ConfigureSetRequestFlush(
+			const FFlushTriggerConfig& Config)
+		{
+			FlushConfigLock.RunLambdaThroughLock([&]()
+			{
+				UE_SetRequestFlushConfig = Config;
+			});
+			UE_SetRequestBuffer.ConfigureFlushTrigger(Config);
+			UE_CompactSetRequestBuffer.ConfigureFlushTrigger(Config);
+			UE_SetWriteThread.Wake();
+		}
+
+		/**
+		 * \brief Write both UE @link ERequestPriority::HIGH lanes to file now.
+		 * \param FileLocation The directory to put the files into
+		 */
+		static FORCEINLINE void UE_FlushPriorityLanes(const std::string& FileLocation)
+		{
+			UE_PriorityGetLane.Flush(FileLocation);
+			UE_PrioritySetLane.Flush(FileLocation);
+		}
+
+		/**
+		 * \brief Only send the attributes of a UE SET that changed since the last
+		 * SET written for that player. A SET counts as written once the file it is
+		 * in has been written. SETs with no changes are dropped, and the Add
+		 * reports success for them.
+		 */
+		static FORCEINLINE void UE_SetUseDeltaSetRequests(const bool bUseDelta)
+		{
+			bUseDeltaSetRequests.store(bUseDelta, std::memory_order_relaxed);
+			if(!bUseDelta)
+			{
+				UE_PlayerShadows.Clear();
+			}
+		}
+
+		/**
+		 * \brief Forget the attributes last sent for a player, so that their next
+		 * SET is sent in full. Use this if a write for them may have been lost.
+		 */
+		static FORCEINLINE void UE_ForgetPlayerShadow(const std::string& PlayerAuthID)
+		{
+			UE_PlayerShadows.Forget(PlayerAuthID);
+		}
+
+		/**
+		 * \brief Set how many players the delta SETs remember, see @link UE_SetUseDeltaSetRequests.
+		 */
+		static FORCEINLINE void UE_SetPlayerShadowCapacity(const size_t Capacity)
+		{
+			UE_PlayerShadows.SetCapacity(Capacity);
+		}
+
+		/**
+		 * \return How many UE SETs were dropped because nothing in them had changed.
+		 */
+		static FORCEINLINE uint64_t UE_GetNumberOfUnchangedSetsDropped() noexcept
+		{
+			return UnchangedSetsDropped.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Merge the UE SETs for the same player into one record per file,
+		 * later SETs overwriting the attributes of earlier ones.
+		 */
+		static FORCEINLINE void UE_SetCoalesceSetRequests(const bool bShouldCoalesce) noexcept
+		{
+			UE_SetRequestBuffer.SetCoalesce(bShouldCoalesce);
+		}
+
+		/**
+		 * \brief Set the capacity and backpressure policy of the UE @link FSetRequestBuffer
+		 */
+		static FORCEINLINE void UE_ConfigureSetRequestBuffer(
+			const FBufferCapacityConfig& Config)
+		{
+			UE_SetRequestBuffer.Configure(Config);
+			UE_CompactSetRequestBuffer.Configure(Config);
+		}
+		
+		/**
+		 * \brief Write the entire @link FGetRequestBuffer to file
+		 * \param FileLocation The directory to put the file into
+		 * \return Whether or not the write worked
+		 */
+		static FORCEINLINE bool UE_WriteGetRequestBufferToFile(
+			const std::string& FileLocation)
+		{
+			UE_PriorityGetLane.Flush(FileLocation);
+			if(bUseCompactRequestBuffers.load(std::memory_order_relaxed))
+			{
+				return UE_CompactGetRequestBuffer.WriteRequestsToFileThroughLock(
+					FileLocation);
+			}
+			if(UE_GetRequestBuffer.IsEmpty())
+			{
+				return false;
+			}
+			
+			UE_GetRequestBuffer.WriteGetRequestsToFileThroughLock(
+				FileLocation);
+			return true;
+		}
+
+		/**
+		 * \brief Write the entire @link FSetRequestBuffer to file
+		 * \param FileLocation The directory to put the file into
+		 * \return Whether or not the write worked
+		 */
+		static FORCEINLINE void UE_WriteSetRequestBufferToFile(
+			const std::string& FileLocation)
+		{
+			UE_PrioritySetLane.Flush(FileLocation);
+			if(bUseCompactRequestBuffers.load(std::memory_order_relaxed))
+			{
+				UE_CompactSetRequestBuffer.WriteRequestsToFileThroughLock(
+					FileLocation);
+				return;
+			}
+			if(UE_SetRequestBuffer.IsEmpty())
+			{
+				return;
+			}
+
+			UE_SetRequestBuffer.WriteSetRequestsToFileThroughLock(
+				FileLocation);
+		}
+
+		/*
+		 * #################################################
+		 * ################# AWS FUNCTIONS #################
+		 * #################################################
+		 */
+		
+		/**
+		 * \brief Initialize the system on the AWS side
+		 */
+		static FORCEINLINE void AWS_Initialize()
+		{
+			AWS_SetRequestBuffer.Initialize();
+			AWS_SetRequestBuffer.SetWakeEvent(AWS_SetWriteThread.GetWakeEvent());
+			AWS_SetWriteThread.StartAdaptiveThread([=]() -> uint32_t
+			{
+				AWS_PrioritySetLane.FlushIfDue();
+				return FlushBufferIfTriggered(AWS_SetRequestBuffer,
+					AWS_SetRequestFlushConfig, AWS_BufferTickRateMS);
+			});
+
+			// Come straight back while the fair scheduler is leaving files behind,
+			// and keep up with segment streams that are still being written
+			AWS_SetReadThread.StartAdaptiveThread([=]() -> uint32_t
+			{
+				return GetIngestWaitMS(ERequestType::SET);
+			});
+			
+			AWS_GetReadThread.StartAdaptiveThread([=]() -> uint32_t
+			{
+				return GetIngestWaitMS(ERequestType::GET);
+			});
+		}
+
+		/*
+		 * \brief Shutdown all threads and erase all bufers on the AWS side
+		 */
+		static FORCEINLINE void AWS_Shutdown()
+		{
+			AWS_SetWriteThread.StopThread();
+			AWS_SetReadThread.StopThread();
+			AWS_GetReadThread.StopThread();
+			
+			// Wait for all threads to shutdown before erasing the buffers...
+			while(AWS_SetWriteThread.GetIsRunning() ||
+				AWS_SetReadThread.GetIsRunning() ||
+				AWS_GetReadThread.GetIsRunning())
+			{
+				std::this_thread::sleep_for(
+					std::chrono::milliseconds(10));
+			}
+			AWS_RequestPipeline.Stop();
+#if IPC_HAS_UNIX_SOCKETS
+			AWS_Transport.Close();
+#endif
+			AWS_SetRequestBuffer.Clear();
+			AWS_PrioritySetLane.Clear();
+			Shutdown();
+		}
+		
+		/**
+		 * \brief Add a @link FSetRequest to the buffer
+		 * \param SetRequest The @link FSetRequest to add to the buffer
+		 * \return Whether or not the Add worked
+		 */
+		static FORCEINLINE bool AWS_AddSetRequestToBuffer(
+			const FSetRequest& SetRequest)
+		{
+			if(SetRequest.IsEmpty())
+			{
+				return false;
+			}
+			if(SetRequest.GetPriority() == ERequestPriority::HIGH)
+			{
+				return AWS_AddPrioritySetRequest(SetRequest);
+			}
+			return AWS_SetRequestBuffer.PushBack(SetRequest);
+		}
+
+		/**
+		 * \brief Move a @link FSetRequest into the buffer, SetRequest is moved
+		 * from if this returns true.
+		 * \param SetRequest The @link FSetRequest to add to the buffer
+		 * \return Whether or not the Add worked
+		 */
+		static FORCEINLINE bool AWS_AddSetRequestToBuffer(
+			FSetRequest&& SetRequest)
+		{
+			if(SetRequest.IsEmpty())
+			{
+				return false;
+			}
+			if(SetRequest.GetPriority() == ERequestPriority::HIGH)
+			{
+				return AWS_AddPrioritySetRequest(std::move(SetRequest));
+			}
+			return AWS_SetRequestBuffer.PushBack(std::move(SetRequest));
+		}
+
+		/**
+		 * \brief Construct a @link FSetRequest once and move it into the buffer.
+		 * \param Args The arguments for one of the @link FSetRequest constructors.
+		 * \return Whether or not the Add worked
+		 */
+		template<typename... TArgs>
+		static FORCEINLINE bool AWS_EmplaceSetRequestToBuffer(TArgs&&... Args)
+		{
+			return AWS_AddSetRequestToBuffer(FSetRequest(std::forward<TArgs>(Args)...));
+		}
+
+		/**
+		 * \brief Add a contiguous range of @link FSetRequest, taking the buffer
+		 * lock as few times as possible.
+		 * \return How many requests from the front of the range were added.
+		 */
+		static FORCEINLINE size_t AWS_AddSetRequestsToBuffer(
+			const FSetRequest* SetRequests,
+			const size_t Count)
+		{
+			return AddSetRequestRange<false>(AWS_SetRequestBuffer, AWS_PrioritySetLane,
+				SetRequests, Count, false);
+		}
+
+		/**
+		 * \brief Move a contiguous range of @link FSetRequest into the buffer.
+		 * Only the added requests are moved from.
+		 */
+		static FORCEINLINE size_t AWS_MoveSetRequestsToBuffer(
+			FSetRequest* SetRequests,
+			const size_t Count)
+		{
+			return AddSetRequestRange<true>(AWS_SetRequestBuffer, AWS_PrioritySetLane,
+				SetRequests, Count, false);
+		}
+
+		/**
+		 * \brief Merge the AWS SETs for the same player into one record per file.
+		 * GET responses carry the request ID of the GET they answer, so they are
+		 * never merged, only rows without a request ID are.
+		 */
+		static FORCEINLINE void AWS_SetCoalesceSetRequests(const bool bShouldCoalesce) noexcept
+		{
+			AWS_SetRequestBuffer.SetCoalesce(bShouldCoalesce);
+		}
+
+		/**
+		 * \brief Set where and how soon the AWS @link ERequestPriority::HIGH lane
+		 * flushes itself.
+		 */
+		static FORCEINLINE void AWS_ConfigurePriorityLane(
+			const FPriorityLaneConfig& Config)
+		{
+			AWS_PrioritySetLane.Configure(Config);
+		}
+
+		/**
+		 * \brief Set when the AWS SET buffer is flushed to file by its write thread.
+		 */
+		static FORCEINLINE void AWS_ConfigureSetRequestFlush(
+			const FFlushTriggerConfig& Config)
+		{
+			FlushConfigLock.RunLambdaThroughLock([&]()
+			{
+				AWS_SetRequestFlushConfig = Config;
+			});
+			AWS_SetRequestBuffer.ConfigureFlushTrigger(Config);
+			AWS_SetWriteThread.Wake();
+		}
+
+		/**
+		 * \brief Set the store the AWS side answers GETs from and applies SETs to.
+		 */
+		static FORCEINLINE void AWS_SetBackend(std::shared_ptr<IAWSBackend> Backend)
+		{
+			AWS_BackendLock.Lock();
+			AWS_Backend.swap(Backend);
+			AWS_BackendLock.Unlock();
+		}
+
+		/** \brief The backend GETs and SETs are sent to, null if none is set. */
+		static FORCEINLINE std::shared_ptr<IAWSBackend> AWS_GetBackend()
+		{
+			AWS_BackendLock.Lock();
+			std::shared_ptr<IAWSBackend> Backend = AWS_Backend;
+			AWS_BackendLock.Unlock();
+			return Backend;
+		}
+
+		/**
+		 * \brief Answer every GET in a file from the backend, buffering one SET
+		 * per GET holding the PlayerAuthID and whichever of the requested
+		 * attributes are stored. Throttled or failed GETs get no response.
+		 * \param FileLocation The full path of the GET file.
+		 * \return How many responses were buffered.
+		 */
+		static FORCEINLINE size_t AWS_ProcessGetRequestFile(const std::string& FileLocation)
+		{
+			const std::shared_ptr<IAWSBackend> Backend = AWS_GetBackend();
+			if(!Backend)
+			{
+				return 0;
+			}
+			std::vector<FGetRequest> Requests;
+			ReadGetRequestsFromFile(FileLocation, Requests);
+			return AWS_ProcessGetRequests(*Backend, Requests);
+		}
+
+		/**
+		 * \brief Apply every SET in a file to the backend.
+		 * \param FileLocation The full path of the SET file.
+		 * \return How many players were stored.
+		 */
+		static FORCEINLINE size_t AWS_ProcessSetRequestFile(const std::string& FileLocation)
+		{
+			const std::shared_ptr<IAWSBackend> Backend = AWS_GetBackend();
+			if(!Backend)
+			{
+				return 0;
+			}
+			std::vector<FPlayerAttributeList> Players;
+			ReadFromFileAndGetAttributes(FileLocation, Players);
+			return AWS_ProcessSetRequests(*Backend, Players);
+		}
+		
+#if IPC_HAS_UNIX_SOCKETS
+		/**
+		 * \brief Accept connections from UE processes on a Unix domain socket.
+		 * The GET and SET batches that arrive are answered and applied as they
+		 * come in, on the transport's own thread, and the responses to a GET
+		 * batch go back on the connection it came in on. The AWS SET buffer
+		 * keeps writing files, its responses could be for any UE process.
+		 * \return Fails if it is already open or the socket couldn't be bound.
+		 */
+		static FORCEINLINE bool AWS_ListenTransport(const FSocketTransportConfig& Config)
+		{
+			return AWS_Transport.Listen(Config, [SocketPath = Config.SocketPath](
+				const ERequestType RequestType,
+				const ERequestPriority Priority,
+				const std::string& Payload,
+				std::string& OutReply)
+			{
+				const std::shared_ptr<IAWSBackend> Backend = AWS_GetBackend();
+				if(!Backend)
+				{
+					return;
+				}
+				std::vector<std::string> Records;
+				VerifyRecordsFromText(SocketPath, Payload, Records);
+				if(RequestType == ERequestType::GET)
+				{
+					std::vector<FGetRequest> Requests;
+					Requests.reserve(Records.size());
+					for(const std::string& Record : Records)
+					{
+						FGetRequest Request;
+						if(ParseGetRecord(Record, Request))
+						{
+							Request.SetPriority(Priority);
+							Requests.push_back(std::move(Request));
+						}
+					}
+					std::vector<FSetRequest> Responses;
+					LookUpGetResponses(*Backend, Requests, Responses);
+					if(!Responses.empty())
+					{
+						FColumnarSetBatch Batch;
+						for(const FSetRequest& Response : Responses)
+						{
+							Batch.AddRow(Response);
+						}
+						FBatchWriter& Writer = GetBatchWriter();
+						SerializeColumnarSetBatch(Writer, Batch);
+						OutReply.assign(Writer.View());
+					}
+				}
+				else if(RequestType == ERequestType::SET)
+				{
+					std::vector<FPlayerAttributeList> Players;
+					Players.reserve(Records.size());
+					for(const std::string& Record : Records)
+					{
+						FPlayerAttributeList PlayerAttributes;
+						if(ParseSetRecord(Record, PlayerAttributes))
+						{
+							Players.push_back(std::move(PlayerAttributes));
+						}
+					}
+					AWS_ProcessSetRequests(*Backend, Players);
+				}
+			});
+		}
+
+		/**
+		 * \brief Close every connection and go back to writing files.
+		 */
+		static FORCEINLINE void AWS_CloseTransport()
+		{
+			AWS_Transport.Close();
+		}
+
+		/** \brief Get a snapshot of the AWS end's socket transport counters. */
+		static FORCEINLINE FSocketTransportStats AWS_GetTransportStats()
+		{
+			return AWS_Transport.GetStats();
+		}
+#endif
+
+		/**
+		 * \brief Start processing the AWS inbox through the pipelined processor.
+		 * Files are picked up by the AWS read threads each tick, so call
+		 * @link AWS_Initialize too.
+		 * \return Fails if it is already running or the config has no inbox.
+		 */
+		static FORCEINLINE bool AWS_StartRequestProcessor(const FAWSProcessorConfig& Config)
+		{
+			return AWS_RequestPipeline.Start(Config);
+		}
+
+		/**
+		 * \brief Stop the processor after finishing every file it has already picked up.
+		 */
+		static FORCEINLINE void AWS_StopRequestProcessor()
+		{
+			AWS_RequestPipeline.Stop();
+		}
+
+		/**
+		 * \brief Per stage throughput of the processor since it was started.
+		 */
+		static FORCEINLINE FAWSProcessorStats AWS_GetRequestProcessorStats()
+		{
+			return AWS_RequestPipeline.GetStats();
+		}
+
+		/**
+		 * \brief Set the share of the AWS ingest a UE process gets. Producers are
+		 * also picked up without registering, as soon as their subdirectory of
+		 * the inbox exists, with a weight of 1.
+		 * \param ProducerName The producer's subdirectory, see @link GetProducerDirectory.
+		 * \param Weight How many quanta it gets per round, see
+		 * @link FAWSProcessorConfig::FairShareQuantumBytes.
+		 */
+		static FORCEINLINE void AWS_RegisterProducer(
+			const std::string& ProducerName,
+			const uint32_t Weight = 1)
+		{
+			AWS_RequestPipeline.RegisterProducer(ProducerName, Weight);
+		}
+
+		/**
+		 * \brief Get the queue depth and lag of every producer writing into the inbox.
+		 * \param OutStats The vector the stats are appended to.
+		 */
+		static FORCEINLINE void AWS_GetProducerStats(std::vector<FProducerStats>& OutStats)
+		{
+			AWS_RequestPipeline.GetProducerStats(OutStats);
+		}
+
+		/**
+		 * \brief The directory a UE process should write its GET and SET files
+		 * to, so the AWS side schedules it fairly against the other processes.
+		 * It is created if it doesn't exist.
+		 * \param InboxDirectory The AWS inbox, see @link FAWSProcessorConfig.
+		 * \param ProducerName A name unique to the UE process, such as its instance ID.
+		 */
+		static FORCEINLINE std::string GetProducerDirectory(
+			const std::string& InboxDirectory,
+			const std::string& ProducerName)
+		{
+			const std::filesystem::path Directory =
+				std::filesystem::path(InboxDirectory) / ProducerName;
+			std::error_code Error;
+			std::filesystem::create_directories(Directory, Error);
+			return Directory.string() + static_cast<char>(std::filesystem::path::preferred_separator);
+		}
+
+		/**
+		 * \brief Set the capacity and backpressure policy of the AWS @link FSetRequestBuffer
+		 */
+		static FORCEINLINE void AWS_ConfigureSetRequestBuffer(
+			const FBufferCapacityConfig& Config)
+		{
+			AWS_SetRequestBuffer.Configure(Config);
+		}
+
+		/**
+		 * \brief Write the entire @link FSetRequestBuffer to file
+		 * \param FileLocation The directory to put the file into
+		 * \return Whether or not the write worked
+		 */
+		static FORCEINLINE void AWS_WriteSetRequestBufferToFile(
+			const std::string& FileLocation)
+		{
+			AWS_PrioritySetLane.Flush(FileLocation);
+			if(AWS_SetRequestBuffer.IsEmpty())
+			{
+				return;
+			}
+			AWS_SetRequestBuffer.WriteSetRequestsToFileThroughLock(FileLocation);
+		}
+		
+		/*
+		 * TODO
+		 */
+		static FORCEINLINE bool WriteAttributeVectorToFile(
+			const std::string& FileLocation,
+			const std::vector<FPlayerAttributeList>& InAttributeArray)
+		{
+			if(InAttributeArray.size() == 0)
+			{
+				return false;
+			}
+			
+			FBatchWriter& Writer = GetBatchWriter();
+			for(int i = 0; i < InAttributeArray.size(); ++i)
+			{
+				const FPlayerAttributeList& PlayerAttributes =
+					InAttributeArray[i];
+				if(IsWritingBinaryRecords())
+				{
+					AppendBinarySetRecord(Writer, PlayerAttributes);
+					Writer.EndRecord();
+					continue;
+				}
+
+				// Write each attribute key and value straight onto the line
+				for(int j = 0; j < PlayerAttributes.Size(); ++j)
+				{
+					if(PlayerAttributes[j] == TableKey_PlayerAuthID.Name)
+					{
+						Writer.Append(TableKey_PlayerAuthID.Key);
+						Writer.Append(ATTRIBUTE_DELIM_CHAR);
+						Writer.Append(PlayerAttributes.GetPlayerAuthID().Value);
+					}
+					else if(PlayerAttributes[j] == TableKey_PlayerName.Name)
+					{
+						Writer.Append(TableKey_PlayerName.Key);
+						Writer.Append(ATTRIBUTE_DELIM_CHAR);
+						Writer.Append(PlayerAttributes.GetPlayerName().Value);
+					}
+					else if(PlayerAttributes[j] == TableKey_IsOnline.Name)
+					{
+						Writer.Append(TableKey_IsOnline.Key);
+						Writer.Append(ATTRIBUTE_DELIM_CHAR);
+						Writer.Append((PlayerAttributes.GetIsOnline().Value) ?
+							(TRUE_STRING) : (FALSE_STRING));
+					}
+					else
+					{
+						continue;
+					}
+					Writer.Append(DELIM_CHAR);
+				}
+
+				Writer.EndRecord(); // add the checksum and newline onto the end
+			}
+			Writer.EndFile(); // add the checksummed footer
+
+			// Generate a unique name for this set request file
+			std::string UniqueFileName;
+			GeneratorUniqueFileName(UniqueFileName, ERequestType::SET);
+			return Writer.WriteToFile(FileLocation + UniqueFileName);
+		}
+
+		/*
+		 * TODO
+		 */
+		static FORCEINLINE void ReadFromFileAndGetAttributes(
+			const std::string& FileLocation,
+			std::vector<FPlayerAttributeList>& OutAttributeVector)
+		{
+			std::vector<std::string> FileLines;
+			ReadVerifiedRecordsFromFile(FileLocation, FileLines);
+			for(int i = 0; i < FileLines.size(); ++i)
+			{
+				FPlayerAttributeList PlayerAttributes;
+				if(ParseSetRecord(FileLines[i], PlayerAttributes))
+				{
+					// Push the now assembled FPlayerAttributeList into the vector
+					OutAttributeVector.push_back(std::move(PlayerAttributes));
+				}
+			}
+		}
+
+		/**
+		 * \brief Read the SET records out of a file along with the request ID
+		 * each one carries, such as the GET responses written by the AWS side.
+		 * \param FileLocation The full path of the file.
+		 * \param OutSetRequests The vector the requests will be appended to.
+		 * \return Fails if the file failed its integrity check, any records that
+		 * verified are still output.
+		 */
+		static FORCEINLINE bool ReadSetRequestsFromFile(
+			const std::string& FileLocation,
+			std::vector<FSetRequest>& OutSetRequests)
+		{
+			std::vector<std::string> FileLines;
+			const bool bVerified = ReadVerifiedRecordsFromFile(FileLocation, FileLines);
+			for(const std::string& Line : FileLines)
+			{
+				FPlayerAttributeList Attributes;
+				FRequestID RequestID;
+				if(ParseSetRecord(Line, Attributes, RequestID))
+				{
+					IAttributeString PlayerAuthID = Attributes.GetPlayerAuthID();
+					OutSetRequests.emplace_back(std::move(PlayerAuthID), RequestID,
+						std::move(Attributes));
+				}
+			}
+			return bVerified;
+		}
+
+		/**
+		 * \brief Parse the payload of one SET record into its attributes.
+		 * \return Fails if there was nothing to update.
+		 */
+		static FORCEINLINE bool ParseSetRecord(
+			const std::string& Record,
+			FPlayerAttributeList& OutAttributes)
+		{
+			FRequestID RequestID;
+			return ParseSetRecord(Record, OutAttributes, RequestID);
+		}
+
+		/**
+		 * \brief Parse the payload of one SET record into its attributes and the
+		 * request ID it carries.
+		 * \param OutRequestID @link RequestIDStatics::None if the record has no ID.
+		 * \return Fails if there was nothing to update.
+		 */
+		static FORCEINLINE bool ParseSetRecord(
+			const std::string& Record,
+			FPlayerAttributeList& OutAttributes,
+			FRequestID& OutRequestID)
+		{
+			OutRequestID = RequestIDStatics::None;
+			if(!Record.empty() && Record[0] == BINARY_RECORD_MARKER)
+			{
+				return DecodeBinarySetRecord(Record, OutAttributes, OutRequestID) &&
+					!OutAttributes.IsEmpty();
+			}
+
+			// Keys never start with a digit, one that does is the RequestID- prefix
+			size_t AttributesStart = 0;
+			if(!Record.empty() && Record[0] >= '0' && Record[0] <= '9')
+			{
+				const size_t IDEnd = Record.find(REQUEST_ID_DELIM_CHAR);
+				if(IDEnd == std::string::npos ||
+					!RequestIDStatics::Parse(std::string_view(Record.data(), IDEnd), OutRequestID))
+				{
+					return false;
+				}
+				AttributesStart = IDEnd + 1;
+			}
+			
+			// Split the line into attributes
+			std::vector<std::string> AttributeStrings;
+			SplitLineIntoAttributeStrings(std::string_view(Record).substr(AttributesStart),
+				AttributeStrings);
+			// Split each attribute into is key/value pair as stringss
+			std::vector<FAttributeStringPair> SplitAttributes;
+			SplitAttributeStrings(AttributeStrings, SplitAttributes);
+			// Put attributes into FPlayerAttributeList
+			ConvertSplitAttributesToPlayerAttributes(
+				SplitAttributes, OutAttributes);
+			// Make sure there was actually something to update
+			return !OutAttributes.IsEmpty();
+		}
+
+		/**
+		 * \brief Read the @link FGetRequest records out of a GET file, the reverse
+		 * of @link FGetRequestBuffer::WriteGetRequestsToFileThroughLock.
+		 * \param FileLocation The full path of the file.
+		 * \param OutGetRequests The vector the requests will be appended to.
+		 * \return Fails if the file failed its integrity check, any records that
+		 * verified are still output.
+		 */
+		static FORCEINLINE bool ReadGetRequestsFromFile(
+			const std::string& FileLocation,
+			std::vector<FGetRequest>& OutGetRequests)
+		{
+			// Requests from a HIGH file stay HIGH, so their responses take the HIGH lane back
+			ERequestType RequestType;
+			FUniqueID ID;
+			ERequestPriority Priority = ERequestPriority::NORMAL;
+			if(!ParseUniqueFileName(FileLocation, RequestType, ID, Priority))
+			{
+				Priority = ERequestPriority::NORMAL;
+			}
+			
+			std::vector<std::string> FileLines;
+			const bool bVerified = ReadVerifiedRecordsFromFile(FileLocation, FileLines);
+			for(const std::string& Line : FileLines)
+			{
+				FGetRequest Request;
+				if(ParseGetRecord(Line, Request))
+				{
+					Request.SetPriority(Priority);
+					OutGetRequests.push_back(std::move(Request));
+				}
+			}
+			return bVerified;
+		}
+		
+		/**
+		 * \brief Create a unique ID for a @link FIPCRequest. IDs from one process
+		 * increase in creation order.
+		 */
+		static FORCEINLINE FRequestID GenerateUniqueRequestID() noexcept
+		{
+			return FUniqueIDGenerator::GenerateRequestID();
+		}
+
+		/**
+		 * \brief Pull the request type and @link FUniqueID back out of a file
+		 * name made by @link GeneratorUniqueFileName, without touching the file.
+		 * \param FilePath The file name, optionally with its directory.
+		 * \return Fails if the name was not made by @link GeneratorUniqueFileName.
+		 */
+		static FORCEINLINE bool ParseUniqueFileName(
+			const std::string& FilePath,
+			ERequestType& OutRequestType,
+			FUniqueID& OutID)
+		{
+			ERequestPriority Priority;
+			return ParseUniqueFileName(FilePath, OutRequestType, OutID, Priority);
+		}
+
+		/**
+		 * \brief See @link ParseUniqueFileName, also pulling out which
+		 * @link ERequestPriority lane the file was written from.
+		 */
+		static FORCEINLINE bool ParseUniqueFileName(
+			const std::string& FilePath,
+			ERequestType& OutRequestType,
+			FUniqueID& OutID,
+			ERequestPriority& OutPriority)
+		{
+			const size_t LastSeparator = FilePath.find_last_of("\\/");
+			const size_t NameStart = (LastSeparator == std::string::npos) ?
+				(0) : (LastSeparator + 1);
+			const size_t TypeEnd = FilePath.find(FILE_DELIM_CHAR, NameStart);
+			if(TypeEnd == std::string::npos)
+			{
+				return false;
+			}
+			
+			size_t TypeLength = TypeEnd - NameStart;
+			OutPriority = ERequestPriority::NORMAL;
+			if(TypeLength > 0 && FilePath[TypeEnd - 1] == PRIORITY_FILE_MARKER_CHAR)
+			{
+				OutPriority = ERequestPriority::HIGH;
+				--TypeLength;
+			}
+			if(FilePath.compare(NameStart, TypeLength, GET_REQUEST_STRING) == 0)
+			{
+				OutRequestType = ERequestType::GET;
+			}
+			else if(FilePath.compare(NameStart, TypeLength, GET_RESPONSE_REQUEST_STRING) == 0)
+			{
+				OutRequestType = ERequestType::GET_RESPONSE;
+			}
+			else if(FilePath.compare(NameStart, TypeLength, SET_REQUEST_STRING) == 0)
+			{
+				OutRequestType = ERequestType::SET;
+			}
+			else
+			{
+				return false;
+			}
+			return FUniqueID::FromString(&FilePath[TypeEnd + 1],
+				FilePath.size() - TypeEnd - 1, OutID);
+		}
+
+		/**
+		 * \brief Sort a list of files into the order they should be consumed in,
+		 * @link ERequestPriority::HIGH files first and then by creation order.
+		 * Files whose names could not be parsed are moved to the end.
+		 */
+		static FORCEINLINE void SortFilesByUniqueID(std::vector<std::string>& FileList)
+		{
+			// Lane 0 is HIGH, 1 is NORMAL and 2 is unparsed
+			std::vector<std::tuple<uint8_t, FUniqueID, size_t>> Keys;
+			Keys.reserve(FileList.size());
+			for(size_t i = 0; i < FileList.size(); ++i)
+			{
+				ERequestType RequestType;
+				FUniqueID ID;
+				ERequestPriority Priority;
+				uint8_t Lane = 2;
+				if(ParseUniqueFileName(FileList[i], RequestType, ID, Priority))
+				{
+					Lane = (Priority == ERequestPriority::HIGH) ? (0) : (1);
+				}
+				Keys.emplace_back(Lane, ID, i);
+			}
+			std::stable_sort(Keys.begin(), Keys.end(),
+				[](const auto& A, const auto& B)
+				{
+					if(std::get<0>(A) != std::get<0>(B))
+					{
+						return std::get<0>(A) < std::get<0>(B);
+					}
+					return std::get<1>(A) < std::get<1>(B);
+				});
+
+			std::vector<std::string> Sorted;
+			Sorted.reserve(FileList.size());
+			for(const auto& Key : Keys)
+			{
+				Sorted.push_back(std::move(FileList[std::get<2>(Key)]));
+			}
+			FileList.swap(Sorted);
+		}
+		
+		/**
+		 * \brief How much memory a buffered request takes with the layout this was
+		 * compiled with, see IPC_PACK_REQUESTS.
+		 */
+		static FORCEINLINE constexpr FRequestFootprint GetRequestFootprint() noexcept
+		{
+			FRequestFootprint Footprint;
+			Footprint.BytesPerGetRequest = sizeof(FGetRequest);
+			Footprint.BytesPerSetRequest = sizeof(FSetRequest);
+			Footprint.BytesPerPendingGetRequest = sizeof(FPendingGetRequest);
+			Footprint.BytesPerCompactRequest = sizeof(FCompactRequest);
+			Footprint.BytesPerAttributeList = sizeof(FPlayerAttributeList);
+			Footprint.BytesPerGetBufferChunk =
+				TChunkedBuffer<FGetRequest>::ElementsPerChunk * sizeof(FGetRequest);
+			Footprint.BytesPerSetBufferChunk =
+				TChunkedBuffer<FSetRequest>::ElementsPerChunk * sizeof(FSetRequest);
+			return Footprint;
+		}
+		
+		/**
+		 * \brief Get a snapshot of the record/file integrity counters.
+		 */
+		static FORCEINLINE FIntegrityStats GetIntegrityStats() noexcept
+		{
+			FIntegrityStats Stats;
+			Stats.RecordsVerified = RecordsVerified.load(std::memory_order_relaxed);
+			Stats.RecordsQuarantined = RecordsQuarantined.load(std::memory_order_relaxed);
+			Stats.RecordsQuarantineDropped =
+				RecordsQuarantineDropped.load(std::memory_order_relaxed);
+			Stats.FilesVerified = FilesVerified.load(std::memory_order_relaxed);
+			Stats.FilesFailed = FilesFailed.load(std::memory_order_relaxed);
+			return Stats;
+		}
+
+		/**
+		 * \brief Move every record that failed its integrity check into an output vector.
+		 * \param OutRecords The vector that the quarantined records will be appended to.
+		 * \return Whether or not there were any quarantined records.
+		 */
+		static FORCEINLINE bool DrainQuarantinedRecords(
+			std::vector<FQuarantinedRecord>& OutRecords)
+		{
+			QuarantineLock.Lock();
+			const bool bHadRecords = !QuarantinedRecords.empty();
+			for(FQuarantinedRecord& Record : QuarantinedRecords)
+			{
+				OutRecords.push_back(std::move(Record));
+			}
+			QuarantinedRecords.clear();
+			QuarantineLock.Unlock();
+			return bHadRecords;
+		}
+		
+	private:
+		/**
+		 * \brief One AWS read thread tick: ingest the inbox for one request type.
+		 * \return How many milliseconds until the next tick.
+		 */
+		static FORCEINLINE uint32_t GetIngestWaitMS(const ERequestType RequestType)
+		{
+			if(AWS_RequestPipeline.Ingest(RequestType))
+			{
+				return 1;
+			}
+			return (AWS_RequestPipeline.IsTailingStream(RequestType)) ?
+				(SEGMENT_TAIL_POLL_MS) : (AWS_BufferTickRateMS);
+		}
+
+		/**
+		 * \brief One write thread tick for a buffer: flush it if any of its
+		 * triggers have been reached and it has somewhere to flush to.
+		 * \return How many milliseconds until the buffer is next due.
+		 */
+		template<typename TBuffer>
+		static FORCEINLINE uint32_t FlushBufferIfTriggered(
+			TBuffer& Buffer,
+			const FFlushTriggerConfig& Config,
+			const uint32_t MaxWaitMS)
+		{
+			const uint32_t WaitMS = Buffer.GetFlushWaitMS(MaxWaitMS);
+			if(WaitMS != 0)
+			{
+				return WaitMS;
+			}
+			
+			std::string FlushDirectory;
+			FlushConfigLock.RunLambdaThroughLock([&]()
+			{
+				FlushDirectory = Config.FlushDirectory;
+			});
+			if((FlushDirectory.empty() && !IsTransportOpen(TBuffer::Platform)) ||
+				!FlushBufferToFile(Buffer, FlushDirectory))
+			{
+				// Try again next tick rather than spinning on a buffer that can't flush
+				return MaxWaitMS;
+			}
+			return Buffer.GetFlushWaitMS(MaxWaitMS);
+		}
+
+		/** \brief Flush a request buffer into a batch file. */
+		template<typename T, ERequestBufferType TBufferPlatform>
+		static FORCEINLINE bool FlushBufferToFile(
+			FRequestBuffer<T, TBufferPlatform>& Buffer,
+			const std::string& FileLocation)
+		{
+			return Buffer.FlushToFileThroughLock(FileLocation);
+		}
+
+		/** \brief Flush a compact request buffer into a batch file. */
+		template<ERequestType TRequestType, ERequestBufferType TBufferPlatform>
+		static FORCEINLINE bool FlushBufferToFile(
+			FCompactRequestBuffer<TRequestType, TBufferPlatform>& Buffer,
+			const std::string& FileLocation)
+		{
+			return Buffer.WriteRequestsToFileThroughLock(FileLocation);
+		}
+
+		/**
+		 * \brief Track a GET as waiting for its response. A GET with no request ID
+		 * can't be matched to one, so it isn't tracked and always succeeds.
+		 */
+		static FORCEINLINE bool UE_AddPendingGetRequest(FPendingGetRequest&& PendingRequest)
+		{
+			if(PendingRequest.GetRequestID() == RequestIDStatics::None)
+			{
+				return true;
+			}
+			return UE_GetPendingRequestsBuffer.PushBack(std::move(PendingRequest));
+		}
+
+		/**
+		 * \brief Stop tracking a GET, because its response was consumed, it timed
+		 * out or it never made it into a buffer. Clears both pending tables.
+		 */
+		static FORCEINLINE void UE_RemovePendingGetRequest(const FRequestID RequestID)
+		{
+			if(RequestID == RequestIDStatics::None)
+			{
+				return;
+			}
+			FPendingGetRequest PendingRequest;
+			if(!UE_GetPendingRequestsBuffer.TakeByRequestID(RequestID, PendingRequest))
+			{
+				UE_CompactPendingGetRequests.RemoveByRequestID(RequestID);
+			}
+		}
+
+		/**
+		 * \brief Stop waiting for the GETs that @link EBackpressurePolicy::DROP_OLDEST
+		 * pushed out of the UE GET buffer. They will never get a response, so
+		 * their pending entries go and their futures fail.
+		 */
+		static FORCEINLINE void UE_FailDroppedGetRequests()
+		{
+			std::vector<FRequestID> Dropped;
+			if(!UE_GetRequestBuffer.TakeDroppedRequestIDs(Dropped) &&
+				!UE_CompactGetRequestBuffer.TakeDroppedRequestIDs(Dropped))
+			{
+				return;
+			}
+			std::vector<std::shared_ptr<FAsyncGetState>> Failed;
+			UE_AsyncGetLock.Lock();
+			for(const FRequestID RequestID : Dropped)
+			{
+				const auto Found = UE_AsyncGets.find(RequestID);
+				if(Found != UE_AsyncGets.end())
+				{
+					Failed.push_back(std::move(Found->second));
+					UE_AsyncGets.erase(Found);
+				}
+			}
+			UE_AsyncGetLock.Unlock();
+
+			for(const FRequestID RequestID : Dropped)
+			{
+				UE_RemovePendingGetRequest(RequestID);
+			}
+			// Continuations run without the lock held, they may start new GETs
+			for(const std::shared_ptr<FAsyncGetState>& State : Failed)
+			{
+				UE_CompleteAsyncGet(State, EAsyncGetStatus::FAILED);
+			}
+		}
+
+		/**
+		 * \brief Flatten a GET into the compact buffer and the compact pending table.
+		 */
+		static FORCEINLINE bool UE_AddCompactGetRequest(const FGetRequest& GetRequest)
+		{
+			const FRequestID RequestID = GetRequest.GetRequestID();
+			if(RequestID != RequestIDStatics::None &&
+				!UE_CompactPendingGetRequests.PushBack(GetRequest))
+			{
+				return false;
+			}
+			if(!UE_CompactGetRequestBuffer.PushBack(GetRequest))
+			{
+				UE_RemovePendingGetRequest(RequestID);
+				return false;
+			}
+			UE_FailDroppedGetRequests();
+			return true;
+		}
+
+		/**
+		 * \brief Stop tracking one asynchronous GET without completing it.
+		 * \return Fails if it had already been taken to be completed.
+		 */
+		static FORCEINLINE bool UE_RemoveAsyncGet(const std::shared_ptr<FAsyncGetState>& State)
+		{
+			bool bRemoved = false;
+			UE_AsyncGetLock.Lock();
+			const auto Found = UE_AsyncGets.find(State->GetRequestID());
+			if(Found != UE_AsyncGets.end() && Found->second == State)
+			{
+				UE_AsyncGets.erase(Found);
+				bRemoved = true;
+			}
+			UE_AsyncGetLock.Unlock();
+			return bRemoved;
+		}
+
+		/**
+		 * \brief Complete an asynchronous GET now, or queue it for
+		 * @link UE_DispatchCompletions if it asked for queued delivery.
+		 */
+		static FORCEINLINE void UE_CompleteAsyncGet(
+			const std::shared_ptr<FAsyncGetState>& State,
+			const EAsyncGetStatus Status,
+			const FPlayerAttributeList* Attributes = nullptr)
+		{
+			if(State->GetDelivery() == ECompletionDelivery::INLINE)
+			{
+				State->Complete(Status, Attributes);
+				return;
+			}
+			FQueuedCompletion Queued;
+			Queued.Completion.Type = ECompletionType::GET;
+			Queued.Completion.RequestID = State->GetRequestID();
+			Queued.Completion.Status = Status;
+			if(Attributes)
+			{
+				Queued.Completion.Attributes = *Attributes;
+			}
+			Queued.State = State;
+			UE_CompletionQueue.Push(std::move(Queued));
+		}
+
+		/**
+		 * \brief Whether anything needs to hear how the write of each UE SET went.
+		 */
+		static FORCEINLINE bool UE_WantsSetWriteResults() noexcept
+		{
+			return bAcknowledgeSetRequests.load(std::memory_order_relaxed) ||
+				bUseDeltaSetRequests.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Commit the delta shadow of one written UE SET, and queue its
+		 * acknowledgement if they were asked for.
+		 */
+		static FORCEINLINE void UE_OnSetRequestWritten(
+			const FRequestID RequestID,
+			const bool bWritten)
+		{
+			if(bUseDeltaSetRequests.load(std::memory_order_relaxed))
+			{
+				UE_PlayerShadows.Acknowledge(RequestID, bWritten);
+			}
+			if(bAcknowledgeSetRequests.load(std::memory_order_relaxed))
+			{
+				UE_AcknowledgeSetRequest(RequestID, bWritten);
+			}
+		}
+
+		/**
+		 * \brief Queue the acknowledgement of one UE SET.
+		 */
+		static FORCEINLINE void UE_AcknowledgeSetRequest(
+			const FRequestID RequestID,
+			const bool bWritten)
+		{
+			FQueuedCompletion Queued;
+			Queued.Completion.Type = ECompletionType::SET;
+			Queued.Completion.RequestID = RequestID;
+			Queued.Completion.Status = (bWritten) ?
+				(EAsyncGetStatus::READY) : (EAsyncGetStatus::FAILED);
+			UE_CompletionQueue.Push(std::move(Queued));
+		}
+
+		/**
+		 * \brief Fail every outstanding asynchronous GET, used on shutdown.
+		 */
+		static FORCEINLINE void UE_CancelAsyncGets()
+		{
+			std::unordered_map<FRequestID, std::shared_ptr<FAsyncGetState>> Cancelled;
+			UE_AsyncGetLock.Lock();
+			Cancelled.swap(UE_AsyncGets);
+			UE_AsyncGetLock.Unlock();
+			for(auto& Entry : Cancelled)
+			{
+				UE_CompleteAsyncGet(Entry.second, EAsyncGetStatus::FAILED);
+			}
+		}
+
+		/**
+		 * \brief Look up every GET in the backend and buffer a response SET for
+		 * each player found. Throttled or failed GETs get no response.
+		 * \return How many responses were buffered.
+		 */
+		static FORCEINLINE size_t AWS_ProcessGetRequests(
+			IAWSBackend& Backend,
+			const std::vector<FGetRequest>& Requests)
+		{
+			std::vector<FSetRequest> Responses;
+			LookUpGetResponses(Backend, Requests, Responses);
+			size_t NumberAnswered = 0;
+			for(FSetRequest& Response : Responses)
+			{
+				if(AWS_AddSetRequestToBuffer(std::move(Response)))
+				{
+					++NumberAnswered;
+				}
+			}
+			return NumberAnswered;
+		}
+
+		/**
+		 * \brief Store every player in the backend.
+		 * \return How many players were stored.
+		 */
+		static FORCEINLINE size_t AWS_ProcessSetRequests(
+			IAWSBackend& Backend,
+			const std::vector<FPlayerAttributeList>& Players)
+		{
+			std::vector<EBackendResult> Results;
+			Backend.SetPlayers(Players, Results);
+			return static_cast<size_t>(std::count(Results.begin(), Results.end(),
+				EBackendResult::OK));
+		}
+
+		/**
+		 * \brief Copy every attribute set in From over the same attribute in Into.
+		 */
+		static FORCEINLINE void MergePlayerAttributes(
+			const FPlayerAttributeList& From,
+			FPlayerAttributeList& Into)
+		{
+			for(size_t i = 0; i < From.Size(); ++i)
+			{
+				switch(From[static_cast<int>(i)])
+				{
+					case EAttributeName::PLAYER_AUTH:
+						Into.SetPlayerAuthID(From.GetPlayerAuthID());
+						break;
+					case EAttributeName::PLAYER_NAME:
+						Into.SetPlayerName(From.GetPlayerName());
+						break;
+					case EAttributeName::IS_ONLINE:
+						Into.SetIsOnline(From.GetIsOnline());
+						break;
+					default:
+						break;
+				}
+			}
+		}
+
+		/**
+		 * \brief Look up every GET in the backend and build a response SET for
+		 * each player found. Throttled or failed GETs get no response.
+		 */
+		static FORCEINLINE void LookUpGetResponses(
+			IAWSBackend& Backend,
+			const std::vector<FGetRequest>& Requests,
+			std::vector<FSetRequest>& OutResponses)
+		{
+			std::vector<std::string> PlayerAuthIDs;
+			PlayerAuthIDs.reserve(Requests.size());
+			for(const FGetRequest& Request : Requests)
+			{
+				PlayerAuthIDs.push_back(Request.GetPlayerAuthIDString());
+			}
+			std::vector<FPlayerAttributeList> Stored;
+			std::vector<EBackendResult> Results;
+			Backend.GetPlayers(PlayerAuthIDs, Stored, Results);
+
+			OutResponses.reserve(OutResponses.size() + Requests.size());
+			for(size_t i = 0; i < Requests.size(); ++i)
+			{
+				if(Results[i] == EBackendResult::OK || Results[i] == EBackendResult::NOT_FOUND)
+				{
+					OutResponses.push_back(MakeGetResponse(Requests[i], Stored[i]));
+				}
+			}
+		}
+
+		/**
+		 * \brief Build the SET that answers a GET, keeping the GET's request ID and priority.
+		 * \param Stored What the backend holds for the player, may be empty.
+		 */
+		static FORCEINLINE FSetRequest MakeGetResponse(
+			const FGetRequest& Request,
+			const FPlayerAttributeList& Stored)
+		{
+			FPlayerAttributeList Response;
+			Response.SetPlayerAuthID(Request.GetPlayerAuthID());
+			const uint8_t StoredMask = GetPresenceMask(Stored);
+			for(size_t i = 0; i < Request.Size(); ++i)
+			{
+				const EAttributeName Name = Request[static_cast<int>(i)];
+				if((StoredMask & FCompactRequest::AttributeBit(Name)) == 0)
+				{
+					continue;
+				}
+				switch(Name)
+				{
+					case EAttributeName::PLAYER_NAME:
+						Response.SetPlayerName(Stored.GetPlayerName());
+						break;
+					case EAttributeName::IS_ONLINE:
+						Response.SetIsOnline(Stored.GetIsOnline());
+						break;
+					default:
+						break;
+				}
+			}
+			FSetRequest SetRequest(Request.GetPlayerAuthID(), Request.GetRequestID(),
+				std::move(Response));
+			SetRequest.SetPriority(Request.GetPriority());
+			return SetRequest;
+		}
+
+		/**
+		 * \brief Mask of @link FCompactRequest::AttributeBit for every attribute set in a list.
+		 */
+		static FORCEINLINE uint8_t GetPresenceMask(const FPlayerAttributeList& Attributes) noexcept
+		{
+			return Attributes.GetAttributeMask();
+		}
+
+		/**
+		 * \brief Add a @link ERequestPriority::HIGH SET to the AWS lane, these
+		 * are normally responses to a HIGH GET.
+		 */
+		template<typename TRequest>
+		static FORCEINLINE bool AWS_AddPrioritySetRequest(TRequest&& SetRequest)
+		{
+			if(!AWS_PrioritySetLane.PushBack(std::forward<TRequest>(SetRequest)))
+			{
+				return false;
+			}
+			AWS_PrioritySetLane.FlushIfImmediate();
+			return true;
+		}
+
+		/**
+		 * \brief Add a @link ERequestPriority::HIGH GET to its lane and register it
+		 * as pending before the lane can be flushed.
+		 */
+		template<typename TRequest>
+		static FORCEINLINE bool UE_AddPriorityGetRequest(TRequest&& GetRequest)
+		{
+			const FRequestID RequestID = GetRequest.GetRequestID();
+			if(!UE_AddPendingGetRequest(FPendingGetRequest(GetRequest)))
+			{
+				return false;
+			}
+			if(!UE_PriorityGetLane.PushBack(std::forward<TRequest>(GetRequest)))
+			{
+				UE_RemovePendingGetRequest(RequestID);
+				return false;
+			}
+			UE_PriorityGetLane.FlushIfImmediate();
+			return true;
+		}
+
+		/**
+		 * \brief Shared implementation of the single UE SET adds. Reduces the SET
+		 * to its changed attributes first when delta SETs are on.
+		 */
+		template<typename TRequest>
+		static FORCEINLINE bool UE_AddSetRequestInternal(TRequest&& SetRequest)
+		{
+			if(SetRequest.IsEmpty())
+			{
+				return false;
+			}
+			if(!bUseDeltaSetRequests.load(std::memory_order_relaxed))
+			{
+				return UE_PushSetRequest(std::forward<TRequest>(SetRequest));
+			}
+
+			const FPlayerAttributeList& Attributes = SetRequest.GetPlayerAttributeList();
+			const uint8_t Changed = UE_PlayerShadows.GetChangedAttributes(SetRequest);
+			if(Changed == 0)
+			{
+				UnchangedSetsDropped.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			// Count what was sent other than the key, if all of it changed the
+			// request can go out as it is
+			const uint8_t Sent = GetPresenceMask(Attributes) &
+				~FCompactRequest::AttributeBit(EAttributeName::PLAYER_AUTH);
+			// Stage before the push, the write thread may acknowledge it straight
+			// away and the request may be moved from
+			const FRequestID RequestID = SetRequest.GetRequestID();
+			UE_PlayerShadows.Stage(SetRequest);
+			if(Sent == Changed)
+			{
+				if(!UE_PushSetRequest(std::forward<TRequest>(SetRequest)))
+				{
+					UE_PlayerShadows.Acknowledge(RequestID, false);
+					return false;
+				}
+				return true;
+			}
+
+			FPlayerAttributeList Delta;
+			for(size_t i = 0; i < Attributes.Size(); ++i)
+			{
+				switch(Attributes[static_cast<int>(i)])
+				{
+					case EAttributeName::PLAYER_AUTH:
+						Delta.SetPlayerAuthID(Attributes.GetPlayerAuthID());
+						break;
+					case EAttributeName::PLAYER_NAME:
+						if(Changed & FCompactRequest::AttributeBit(EAttributeName::PLAYER_NAME))
+						{
+							Delta.SetPlayerName(Attributes.GetPlayerName());
+						}
+						break;
+					case EAttributeName::IS_ONLINE:
+						if(Changed & FCompactRequest::AttributeBit(EAttributeName::IS_ONLINE))
+						{
+							Delta.SetIsOnline(Attributes.GetIsOnline());
+						}
+						break;
+					default:
+						break;
+				}
+			}
+			FSetRequest DeltaRequest(SetRequest.GetPlayerAuthID(),
+				SetRequest.GetRequestID(), std::move(Delta));
+			DeltaRequest.SetPriority(SetRequest.GetPriority());
+			if(!UE_PushSetRequest(std::move(DeltaRequest)))
+			{
+				UE_PlayerShadows.Acknowledge(RequestID, false);
+				return false;
+			}
+			return true;
+		}
+
+		/**
+		 * \brief Push a UE SET into whichever buffer is in use.
+		 */
+		template<typename TRequest>
+		static FORCEINLINE bool UE_PushSetRequest(TRequest&& SetRequest)
+		{
+			if(SetRequest.GetPriority() == ERequestPriority::HIGH)
+			{
+				if(!UE_PrioritySetLane.PushBack(std::forward<TRequest>(SetRequest)))
+				{
+					return false;
+				}
+				UE_PrioritySetLane.FlushIfImmediate();
+				return true;
+			}
+			if(bUseCompactRequestBuffers.load(std::memory_order_relaxed))
+			{
+				return UE_CompactSetRequestBuffer.PushBack(SetRequest);
+			}
+			return UE_SetRequestBuffer.PushBack(std::forward<TRequest>(SetRequest));
+		}
+
+		/**
+		 * \brief Check that none of the requests in a range are empty, so the
+		 * range can be pushed in bulk.
+		 */
+		template<typename TRequest>
+		static FORCEINLINE bool AllRequestsFitBulkLane(
+			const TRequest* Requests,
+			const size_t Count) noexcept
+		{
+			for(size_t i = 0; i < Count; ++i)
+			{
+				if(Requests[i].IsEmpty() ||
+					Requests[i].GetPriority() != ERequestPriority::NORMAL)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * \brief Shared implementation of the bulk GET adds. Every GET in the
+		 * range that was added is also pending, and none of the others are.
+		 * \tparam bMove Whether to move the requests in rather than copy them.
+		 */
+		template<bool bMove, typename TRequest>
+		static FORCEINLINE size_t AddGetRequestRange(
+			TRequest* GetRequests,
+			const size_t Count)
+		{
+			const bool bBulk = !bUseCompactRequestBuffers.load(std::memory_order_relaxed) &&
+				AllRequestsFitBulkLane(GetRequests, Count) &&
+				std::none_of(GetRequests, GetRequests + Count, [](const FGetRequest& Request)
+				{
+					return Request.GetRequestID() == RequestIDStatics::None;
+				});
+			if(!bBulk)
+			{
+				size_t NumberAdded = 0;
+				for(; NumberAdded < Count; ++NumberAdded)
+				{
+					bool bAdded;
+					if constexpr(bMove)
+					{
+						bAdded = UE_AddGetRequestToBuffer(std::move(GetRequests[NumberAdded]));
+					}
+					else
+					{
+						bAdded = UE_AddGetRequestToBuffer(GetRequests[NumberAdded]);
+					}
+					if(!bAdded)
+					{
+						break;
+					}
+				}
+				return NumberAdded;
+			}
+
+			// Pending first, then take back whatever the GET buffer turned away
+			const size_t NumberPending = UE_GetPendingRequestsBuffer.PushBackRange(
+				GetRequests, GetRequests + Count);
+			size_t NumberAdded;
+			if constexpr(bMove)
+			{
+				NumberAdded = UE_GetRequestBuffer.PushBackRange(
+					std::make_move_iterator(GetRequests),
+					std::make_move_iterator(GetRequests + NumberPending));
+			}
+			else
+			{
+				NumberAdded = UE_GetRequestBuffer.PushBackRange(
+					GetRequests, GetRequests + NumberPending);
+			}
+			for(size_t i = NumberAdded; i < NumberPending; ++i)
+			{
+				UE_RemovePendingGetRequest(GetRequests[i].GetRequestID());
+			}
+			UE_FailDroppedGetRequests();
+			return NumberAdded;
+		}
+
+		/**
+		 * \brief Shared implementation of the bulk SET adds.
+		 * \tparam bMove Whether to move the requests in rather than copy them.
+		 * \param bUseCompact Whether to flatten into the UE compact buffer instead.
+		 */
+		template<bool bMove, typename TBuffer, typename TRequest>
+		static FORCEINLINE size_t AddSetRequestRange(
+			TBuffer& Buffer,
+			FPriorityLane<TBuffer>& Lane,
+			TRequest* SetRequests,
+			const size_t Count,
+			const bool bUseCompact)
+		{
+			if(!bUseCompact && AllRequestsFitBulkLane(SetRequests, Count))
+			{
+				if constexpr(bMove)
+				{
+					return Buffer.PushBackRange(std::make_move_iterator(SetRequests),
+						std::make_move_iterator(SetRequests + Count));
+				}
+				else
+				{
+					return Buffer.PushBackRange(SetRequests, SetRequests + Count);
+				}
+			}
+			
+			size_t NumberAdded = 0;
+			for(; NumberAdded < Count; ++NumberAdded)
+			{
+				TRequest& Request = SetRequests[NumberAdded];
+				if(Request.IsEmpty())
+				{
+					break;
+				}
+				bool bAdded;
+				if(Request.GetPriority() == ERequestPriority::HIGH)
+				{
+					if constexpr(bMove)
+					{
+						bAdded = Lane.PushBack(std::move(Request));
+					}
+					else
+					{
+						bAdded = Lane.PushBack(Request);
+					}
+				}
+				else if(bUseCompact)
+				{
+					bAdded = UE_CompactSetRequestBuffer.PushBack(Request);
+				}
+				else if constexpr(bMove)
+				{
+					bAdded = Buffer.PushBack(std::move(Request));
+				}
+				else
+				{
+					bAdded = Buffer.PushBack(Request);
+				}
+				if(!bAdded)
+				{
+					break;
+				}
+			}
+			Lane.FlushIfImmediate();
+			return NumberAdded;
+		}
+		
+		static FORCEINLINE void Initialize()
+		{
+		}
+
+		static FORCEINLINE void Shutdown()
+		{
+		}
+		
+		/**
+		 * \brief Create a file with a given name and location.
+		 * \param FileStream
+		 * \param FileName Name of the file.
+		 * \param Directory Full directory path to put the file in.
+		 */
+		static FORCEINLINE void CreateFile(
+			FILE *FileStream,
+			const std::string& FileName,
+			const std::string& Directory)
+		{
+			const std::string FileLocation = Directory + "\\" + FileName;
+			fopen_s(&FileStream, FileLocation.c_str(), WRITE_MODE);
+		}
+
+		/**
+		 * \brief Delete a certain file.
+		 * \param FileName Name of the file.
+		 * \param Directory Full directory path to put the file in.
+		 */
+		static FORCEINLINE void DeleteFile(
+			const std::string& FileName,
+			const std::string& Directory)
+		{
+			const std::string FileLocation = Directory + "\\" + FileName;
+			remove(FileLocation.c_str());
+		}
+
+		/*
+		 * TODO
+		 */
+		static FORCEINLINE bool WriteStringToFile(
+			const std::string& FullNameAndPath,
+			const std::string& FileString)
+		{
+			FILE *File;
+			fopen_s(&File, FullNameAndPath.c_str(), WRITE_MODE);
+			if(!File)
+			{
+				return false;
+			}
+			const bool bWritten =
+				fwrite(FileString.data(), 1, FileString.size(), File) == FileString.size();
+			return fclose(File) == 0 && bWritten;
+		}
+		
+		/**
+		 * \brief Write a serialized batch to a uniquely named file in FileLocation,
+		 * or send it over the socket transport if TBufferPlatform has one open,
+		 * or put it in a free segment, or append it to a segment stream, if a
+		 * segment pool is open for FileLocation.
+		 * \param Writer The records and footer, exactly as they go in the file.
+		 * \return Whether or not the batch was written or sent.
+		 */
+		template<ERequestBufferType TBufferPlatform>
+		static FORCEINLINE bool WriteBatch(
+			const std::string& FileLocation,
+			const ERequestType RequestType,
+			const ERequestPriority Priority,
+			FBatchWriter& Writer)
+		{
+#if IPC_HAS_UNIX_SOCKETS || IPC_HAS_SEGMENT_FILES
+			// The transport and the segments want the batch in one piece
+			bool bHasContiguousSink = IsTransportOpen(TBufferPlatform);
+#if IPC_HAS_SEGMENT_FILES
+			bHasContiguousSink |= TBufferPlatform == ERequestBufferType::UE &&
+				UE_SegmentPool.IsOpen();
+#endif
+			if(!bHasContiguousSink)
+			{
+				// Files take the chunks as they are, with no copy
+				return WriteBatchFile(FileLocation, RequestType, Priority, Writer);
+			}
+			const std::string_view Payload = Writer.View();
+#endif
+#if IPC_HAS_UNIX_SOCKETS
+			if(IsTransportOpen(TBufferPlatform))
+			{
+				// A batch without a credit stays buffered until the next flush
+				return UE_Transport.Send(RequestType, Priority, Payload);
+			}
+#endif
+#if IPC_HAS_SEGMENT_FILES
+			if(TBufferPlatform == ERequestBufferType::UE)
+			{
+				if(Priority == ERequestPriority::NORMAL && UE_SegmentPool.IsStreaming())
+				{
+					// The stream takes the records without the footer, whatever
+					// it couldn't take goes in a file with a footer of its own
+					const size_t RecordsEnd = Payload.rfind(NEWLINE_CHAR) + 1;
+					const size_t Committed = UE_SegmentPool.Append(FileLocation, RequestType,
+						std::string_view(Payload).substr(0, RecordsEnd));
+					if(Committed == RecordsEnd)
+					{
+						return true;
+					}
+					if(Committed > 0)
+					{
+						std::string Remainder(Payload.substr(Committed, RecordsEnd - Committed));
+						AppendFileFooter(Remainder);
+						return WriteBatchFile(FileLocation, RequestType, Priority, Remainder);
+					}
+				}
+				else if(UE_SegmentPool.Write(FileLocation, RequestType, Priority, Payload))
+				{
+					return true;
+				}
+			}
+#endif
+			return WriteBatchFile(FileLocation, RequestType, Priority, Writer);
+		}
 
-		template<ERequestBufferType TBufferRequestType> using FWriteBufferThread =
-			FBufferThread<TBufferRequestType>;
-		template<ERequestBufferType TBufferRequestType> using FReadBufferThread =
-			FBufferThread<TBufferRequestType>;
-		
-		IPCFileManager() = default;
-		~IPCFileManager() = default;
+		/**
+		 * \brief Write a serialized batch to a new, uniquely named file in FileLocation.
+		 */
+		static FORCEINLINE bool WriteBatchFile(
+			const std::string& FileLocation,
+			const ERequestType RequestType,
+			const ERequestPriority Priority,
+			const std::string& Payload)
+		{
+			return WriteStringToFile(
+				MakeBatchFilePath(FileLocation, RequestType, Priority), Payload);
+		}
 
+		/**
+		 * \brief Write the chunks of a serialized batch to a new, uniquely
+		 * named file in FileLocation, with a single writev.
+		 */
+		static FORCEINLINE bool WriteBatchFile(
+			const std::string& FileLocation,
+			const ERequestType RequestType,
+			const ERequestPriority Priority,
+			FBatchWriter& Writer)
+		{
+			return Writer.WriteToFile(MakeBatchFilePath(FileLocation, RequestType, Priority));
+		}
 
-		
-		/* 
-		 * The AWS Process will never need to make a get request to the
-		 * unreal process, the AWS process will only make a set request to
-		 * the unreal process, after the unreal process makes a get request
-		 *
-		 * UE get request -> AWS Process -> Loads from DynamoDB ->
-		 * AWS set request -> UE Process
-		 *
-		 * UE set request -> AWS Process -> Set in DynamoDB
+		/** \brief The path of a new batch file for the request type and priority. */
+		static FORCEINLINE std::string MakeBatchFilePath(
+			const std::string& FileLocation,
+			const ERequestType RequestType,
+			const ERequestPriority Priority)
+		{
+			std::string UniqueFileName;
+			GeneratorUniqueFileName(UniqueFileName, RequestType, Priority);
+			return FileLocation + FILE_DIRECTORY_DELIM + UniqueFileName + FILE_EXTENSION;
+		}
+
+		/**
+		 * \brief The writer the calling thread serializes its batches into,
+		 * emptied and ready for a new batch.
 		 */
-		
-		/*
-		 * #################################################
-		 * ############### UNREAL FUNCTIONS ################
-		 * #################################################
+		static FORCEINLINE FBatchWriter& GetBatchWriter()
+		{
+			thread_local FBatchWriter Writer;
+			Writer.Reset();
+			return Writer;
+		}
+
+		/**
+		 * \brief Whether the buffers of a platform send their batches over the
+		 * socket transport instead of writing files. Only the UE side does, and
+		 * only while it is connected, the AWS side replies from the transport.
 		 */
+		static FORCEINLINE bool IsTransportOpen(const ERequestBufferType Platform)
+		{
+#if IPC_HAS_UNIX_SOCKETS
+			return Platform == ERequestBufferType::UE && UE_Transport.IsConnected();
+#else
+			(void)Platform;
+			return false;
+#endif
+		}
 		
 		/**
-		 * \brief Initialize the system on the UE side
+		 * \brief Serialize a batch of @link FCompactRequest into a file, in the
+		 * same format as the @link FGetRequestBuffer and @link FSetRequestBuffer.
+		 * \param FileLocation The directory to write the file to.
+		 * \param RequestType Whether the batch holds GET or SET requests.
+		 * \return Whether or not the file was written.
 		 */
-		static FORCEINLINE void UE_Initialize()
+		template<ERequestBufferType TBufferPlatform>
+		static FORCEINLINE bool WriteCompactBatchToFile(
+			const std::string& FileLocation,
+			const ERequestType RequestType,
+			const FCompactRequestBatch& Batch)
 		{
-			Initialize();
-			UE_GetRequestBuffer.Initialize();
-			UE_GetWriteThread.StartThread([=]()
-			{
-				// TODO
-			});
-			
-			UE_SetRequestBuffer.Initialize();
-			UE_SetWriteThread.StartThread([=]()
+			FBatchWriter& Writer = GetBatchWriter();
+			const bool bBinary = IsWritingBinaryRecords();
+			for(const FCompactRequest& Request : Batch.Records)
 			{
-				// TODO
-			});
+				if(RequestType == ERequestType::GET)
+				{
+					if(bBinary)
+					{
+						AppendBinaryCompactGetRecord(Writer, Request, Batch.Arena);
+					}
+					else
+					{
+						AppendCompactGetRecord(Writer, Request, Batch.Arena);
+					}
+				}
+				else
+				{
+					if(bBinary)
+					{
+						AppendBinaryCompactSetRecord(Writer, Request, Batch.Arena);
+					}
+					else
+					{
+						AppendCompactSetRecord(Writer, Request, Batch.Arena);
+					}
+				}
+				Writer.EndRecord();
+			}
+			Writer.EndFile();
+			return WriteBatch<TBufferPlatform>(FileLocation, RequestType,
+				ERequestPriority::NORMAL, Writer);
+		}
 
-			UE_SetReadThread.StartThread([=]()
-			{
-				// TODO
-			});
+		/**
+		 * \brief Serialize a @link FColumnarSetBatch into a SET file, one record per row.
+		 * \param FileLocation The directory to write the file to.
+		 * \return Whether or not the file was written.
+		 */
+		template<ERequestBufferType TBufferPlatform>
+		static FORCEINLINE bool WriteColumnarSetBatchToFile(
+			const std::string& FileLocation,
+			const FColumnarSetBatch& Batch,
+			const ERequestPriority Priority = ERequestPriority::NORMAL)
+		{
+			FBatchWriter& Writer = GetBatchWriter();
+			SerializeColumnarSetBatch(Writer, Batch);
+			return WriteBatch<TBufferPlatform>(FileLocation, ERequestType::SET,
+				Priority, Writer);
+		}
 
-			UE_GetPendingRequestsBuffer.Initialize();
-			UE_GetPendingThread.StartThread([=]()
+		/**
+		 * \brief Serialize a @link FColumnarSetBatch in the SET file format, one
+		 * record per row and the footer.
+		 */
+		static FORCEINLINE void SerializeColumnarSetBatch(
+			FBatchWriter& Writer,
+			const FColumnarSetBatch& Batch)
+		{
+			const bool bBinary = IsWritingBinaryRecords();
+			for(size_t Row = 0; Row < Batch.Size(); ++Row)
 			{
-				// TODO
-			});
+				if(bBinary)
+				{
+					RecordStatics::FBinarySetRecordEncoder Encoder(Writer);
+					Encoder.SetRequestID(Batch.RequestIDs[Row]);
+					if(Batch.HasAttribute(Row, EAttributeName::PLAYER_AUTH))
+					{
+						Encoder.AddString(EAttributeName::PLAYER_AUTH, Batch.PlayerAuthIDs[Row]);
+					}
+					if(Batch.HasAttribute(Row, EAttributeName::PLAYER_NAME))
+					{
+						Encoder.AddString(EAttributeName::PLAYER_NAME, Batch.PlayerNames[Row]);
+					}
+					if(Batch.HasAttribute(Row, EAttributeName::IS_ONLINE))
+					{
+						Encoder.AddBool(EAttributeName::IS_ONLINE, Batch.IsOnline[Row] != 0);
+					}
+					Encoder.Write();
+					Writer.EndRecord();
+					continue;
+				}
+				AppendSetRecordID(Writer, Batch.RequestIDs[Row]);
+				if(Batch.HasAttribute(Row, EAttributeName::PLAYER_AUTH))
+				{
+					Writer.Append(TableKey_PlayerAuthID.Key);
+					Writer.Append(ATTRIBUTE_DELIM_CHAR);
+					Writer.Append(Batch.PlayerAuthIDs[Row]);
+					Writer.Append(DELIM_CHAR);
+				}
+				if(Batch.HasAttribute(Row, EAttributeName::PLAYER_NAME))
+				{
+					Writer.Append(TableKey_PlayerName.Key);
+					Writer.Append(ATTRIBUTE_DELIM_CHAR);
+					Writer.Append(Batch.PlayerNames[Row]);
+					Writer.Append(DELIM_CHAR);
+				}
+				if(Batch.HasAttribute(Row, EAttributeName::IS_ONLINE))
+				{
+					Writer.Append(TableKey_IsOnline.Key);
+					Writer.Append(ATTRIBUTE_DELIM_CHAR);
+					Writer.Append((Batch.IsOnline[Row]) ? (TRUE_STRING) : (FALSE_STRING));
+					Writer.Append(DELIM_CHAR);
+				}
+				Writer.EndRecord();
+			}
+			Writer.EndFile();
 		}
-		
+
 		/**
-		 * \brief Shutdown the threads and erase all buffers on the UE side
+		 * \brief Append RequestID-PlayerAuth,Key,Key, for a compact GET.
 		 */
-		static FORCEINLINE void UE_Shutdown()
+		static FORCEINLINE void AppendCompactGetRecord(
+			FBatchWriter& Writer,
+			const FCompactRequest& Request,
+			const FRequestArena& Arena)
 		{
-			UE_SetWriteThread.StopThread();
-			UE_SetReadThread.StopThread();
-			UE_GetWriteThread.StopThread();
-			UE_GetPendingThread.StopThread();
-			
-			// Wait for all threads to shutdown before erasing the buffers...
-			while(UE_SetWriteThread.GetIsRunning() ||
-				UE_SetReadThread.GetIsRunning() ||
-				UE_GetWriteThread.GetIsRunning() ||
-				UE_GetPendingThread.GetIsRunning())
+			Writer.AppendNumber(Request.RequestID);
+			Writer.Append(REQUEST_ID_DELIM_CHAR);
+			Writer.Append(Arena.View(Request.PlayerAuthID));
+			Writer.Append(DELIM_CHAR);
+			if(Request.HasAttribute(EAttributeName::PLAYER_AUTH))
 			{
-				std::this_thread::sleep_for(
-					std::chrono::milliseconds(10));
+				Writer.Append(TableKey_PlayerAuthID.Key);
+				Writer.Append(DELIM_CHAR);
+			}
+			if(Request.HasAttribute(EAttributeName::PLAYER_NAME))
+			{
+				Writer.Append(TableKey_PlayerName.Key);
+				Writer.Append(DELIM_CHAR);
+			}
+			if(Request.HasAttribute(EAttributeName::IS_ONLINE))
+			{
+				Writer.Append(TableKey_IsOnline.Key);
+				Writer.Append(DELIM_CHAR);
 			}
-			UE_GetRequestBuffer.Clear();
-			UE_SetRequestBuffer.Clear();
-			UE_GetPendingRequestsBuffer.Clear();
-			Shutdown();
 		}
 
 		/**
-		 * \brief Add a @link FGetRequest to the buffer
-		 * \param GetRequest The @link FGetRequest to add to the buffer
-		 * \return Whether or not the Add worked
+		 * \brief Append RequestID-Key:Value, for each attribute of a compact SET.
 		 */
-		static FORCEINLINE bool UE_AddGetRequestToBuffer(
-			const FGetRequest& GetRequest)
+		static FORCEINLINE void AppendCompactSetRecord(
+			FBatchWriter& Writer,
+			const FCompactRequest& Request,
+			const FRequestArena& Arena)
 		{
-			if(GetRequest.IsEmpty())
+			AppendSetRecordID(Writer, Request.RequestID);
+			if(Request.HasAttribute(EAttributeName::PLAYER_AUTH))
 			{
-				return false;
+				Writer.Append(TableKey_PlayerAuthID.Key);
+				Writer.Append(ATTRIBUTE_DELIM_CHAR);
+				Writer.Append(Arena.View(Request.PlayerAuthID));
+				Writer.Append(DELIM_CHAR);
 			}
-			UE_GetRequestBuffer.PushBack(GetRequest);
-			UE_GetPendingRequestsBuffer.PushBack(
-				FPendingGetRequest(GetRequest, GetRequest.GetRequestID()));
-			return true;
-		} 
+			if(Request.HasAttribute(EAttributeName::PLAYER_NAME))
+			{
+				Writer.Append(TableKey_PlayerName.Key);
+				Writer.Append(ATTRIBUTE_DELIM_CHAR);
+				Writer.Append(Arena.View(Request.PlayerName));
+				Writer.Append(DELIM_CHAR);
+			}
+			if(Request.HasAttribute(EAttributeName::IS_ONLINE))
+			{
+				Writer.Append(TableKey_IsOnline.Key);
+				Writer.Append(ATTRIBUTE_DELIM_CHAR);
+				Writer.Append((Request.bIsOnline) ? (TRUE_STRING) : (FALSE_STRING));
+				Writer.Append(DELIM_CHAR);
+			}
+		}
 		
 		/**
-		 * \brief Add a @link FSetRequest to the buffer
-		 * \param SetRequest The @link FSetRequest to add to the buffer
-		 * \return Whether or not the Add worked
+		 * \brief Start a text SET record with RequestID-, so that a GET response
+		 * can be matched to its GET. Keys never start with a digit, which is
+		 * how a reader tells the prefix apart.
 		 */
-		static FORCEINLINE bool UE_AddSetRequestToBuffer(
-			const FSetRequest& SetRequest)
+		static FORCEINLINE void AppendSetRecordID(FBatchWriter& Writer, const FRequestID RequestID)
 		{
-			if(SetRequest.IsEmpty())
+			if(RequestID != RequestIDStatics::None)
 			{
-				return false;
+				Writer.AppendNumber(RequestID);
+				Writer.Append(REQUEST_ID_DELIM_CHAR);
 			}
-			UE_SetRequestBuffer.PushBack(SetRequest);
-			return true;
 		}
-		
+
 		/**
-		 * \brief Write the entire @link FGetRequestBuffer to file
-		 * \param FileLocation The directory to put the file into
-		 * \return Whether or not the write worked
+		 * \brief The binary form of @link AppendCompactGetRecord.
 		 */
-		static FORCEINLINE bool UE_WriteGetRequestBufferToFile(
-			const std::string& FileLocation)
+		static FORCEINLINE void AppendBinaryCompactGetRecord(
+			FBatchWriter& Writer,
+			const FCompactRequest& Request,
+			const FRequestArena& Arena)
 		{
-			if(UE_GetRequestBuffer.IsEmpty())
+			RecordStatics::BeginBinaryGetRecord(Writer, Request.RequestID,
+				Arena.View(Request.PlayerAuthID), BitStatics::PopCount(Request.AttributeMask));
+			for(uint32_t Remaining = Request.AttributeMask; Remaining != 0; Remaining &= Remaining - 1)
 			{
-				return false;
+				Writer.Append(static_cast<char>(BitStatics::CountTrailingZeros(Remaining)));
 			}
-			
-			UE_GetRequestBuffer.WriteGetRequestsToFileThroughLock(
-				FileLocation);
-			return true;
 		}
 
 		/**
-		 * \brief Write the entire @link FSetRequestBuffer to file
-		 * \param FileLocation The directory to put the file into
-		 * \return Whether or not the write worked
+		 * \brief The binary form of @link AppendCompactSetRecord.
 		 */
-		static FORCEINLINE void UE_WriteSetRequestBufferToFile(
-			const std::string& FileLocation)
+		static FORCEINLINE void AppendBinaryCompactSetRecord(
+			FBatchWriter& Writer,
+			const FCompactRequest& Request,
+			const FRequestArena& Arena)
 		{
-			if(UE_SetRequestBuffer.IsEmpty())
+			RecordStatics::FBinarySetRecordEncoder Encoder(Writer);
+			Encoder.SetRequestID(Request.RequestID);
+			if(Request.HasAttribute(EAttributeName::PLAYER_AUTH))
 			{
-				return;
+				Encoder.AddString(EAttributeName::PLAYER_AUTH, Arena.View(Request.PlayerAuthID));
 			}
-
-			UE_SetRequestBuffer.WriteSetRequestsToFileThroughLock(
-				FileLocation);
+			if(Request.HasAttribute(EAttributeName::PLAYER_NAME))
+			{
+				Encoder.AddString(EAttributeName::PLAYER_NAME, Arena.View(Request.PlayerName));
+			}
+			if(Request.HasAttribute(EAttributeName::IS_ONLINE))
+			{
+				Encoder.AddBool(EAttributeName::IS_ONLINE, Request.bIsOnline);
+			}
+			Encoder.Write();
 		}
 
-		/*
-		 * #################################################
-		 * ################# AWS FUNCTIONS #################
-		 * #################################################
+		/**
+		 * \brief Write the attributes of a @link FPlayerAttributeList as a binary SET record.
 		 */
+		static FORCEINLINE void AppendBinarySetRecord(
+			FBatchWriter& Writer,
+			const FPlayerAttributeList& Attributes)
+		{
+			RecordStatics::FBinarySetRecordEncoder Encoder(Writer);
+			for(size_t i = 0; i < Attributes.Size(); ++i)
+			{
+				switch(Attributes[i])
+				{
+					case EAttributeName::PLAYER_AUTH:
+						Encoder.AddString(EAttributeName::PLAYER_AUTH, Attributes.GetPlayerAuthID().Value);
+						break;
+					case EAttributeName::PLAYER_NAME:
+						Encoder.AddString(EAttributeName::PLAYER_NAME, Attributes.GetPlayerName().Value);
+						break;
+					case EAttributeName::IS_ONLINE:
+						Encoder.AddBool(EAttributeName::IS_ONLINE, Attributes.GetIsOnline().Value);
+						break;
+					default:
+						break;
+				}
+			}
+			Encoder.Write();
+		}
+
+		/** \brief Whether records are written in the binary encoding. */
+		static FORCEINLINE bool IsWritingBinaryRecords() noexcept
+		{
+			return RecordEncoding.load(std::memory_order_relaxed) == ERecordEncoding::BINARY;
+		}
 		
 		/**
-		 * \brief Initialize the system on the AWS side
+		 * \brief Read a list of player attribute strings from a file, stores
+		 * them in an output variable.
+		 * \param FileLocation the location of the file (C:\\dir\\dir\\file)
+		 * \param OutStringArray Output string vector to store the player attribute
+		 * strings in.
 		 */
-		static FORCEINLINE void AWS_Initialize()
+		static FORCEINLINE bool ReadLinesFromFile(
+			const std::string& FileLocation,
+			std::vector<std::string>& OutStringArray)
 		{
-			AWS_SetRequestBuffer.Initialize();
-			AWS_SetWriteThread.StartThread([=]()
+			const std::ifstream File(FileLocation, std::ios::binary);
+			std::stringstream StreamBuffer;
+			StreamBuffer << File.rdbuf(); // hate doing this
+			const std::string FileText = StreamBuffer.str();
+			if(FileText.size() == 0)
 			{
-				// TODO
-			});
+				return false;
+			}
 
-			AWS_SetReadThread.StartThread([=]()
+			std::string LineBuffer = "";
+			for(int i = 0; i < FileText.size(); ++i)
 			{
-				// TODO
-			});
+				if(FileText[i] == NEWLINE_CHAR)
+				{
+					OutStringArray.push_back(LineBuffer);
+					LineBuffer.erase();
+				}
+				else
+				{
+					LineBuffer += FileText[i];
+				}
+			}
 			
-			AWS_GetReadThread.StartThread([=]()
-			{
-				// TODO
-			});
+			return (OutStringArray.size() > 0);
 		}
 
-		/*
-		 * \brief Shutdown all threads and erase all bufers on the AWS side
+		/**
+		 * \brief Append a checksum as a fixed width hex string.
 		 */
-		static FORCEINLINE void AWS_Shutdown()
+		static FORCEINLINE void AppendChecksum(std::string& Out, const uint32_t Crc)
 		{
-			AWS_SetWriteThread.StopThread();
-			AWS_SetReadThread.StopThread();
-			AWS_GetReadThread.StopThread();
-			
-			// Wait for all threads to shutdown before erasing the buffers...
-			while(AWS_SetWriteThread.GetIsRunning() ||
-				AWS_SetReadThread.GetIsRunning() ||
-				AWS_GetReadThread.GetIsRunning())
+			char Buffer[CHECKSUM_HEX_LENGTH];
+			HexStatics::Write(Buffer, Crc, CHECKSUM_HEX_LENGTH);
+			Out.append(Buffer, CHECKSUM_HEX_LENGTH);
+		}
+
+		/**
+		 * \brief Parse a fixed width hex checksum written by @link AppendChecksum.
+		 * \return Fails if any of the characters are not hex digits.
+		 */
+		static FORCEINLINE bool ParseChecksum(const char* In, uint32_t& OutCrc)
+		{
+			uint64_t Value;
+			if(!HexStatics::Parse(In, CHECKSUM_HEX_LENGTH, Value))
 			{
-				std::this_thread::sleep_for(
-					std::chrono::milliseconds(10));
+				return false;
 			}
-			AWS_SetRequestBuffer.Clear();
-			Shutdown();
+			OutCrc = static_cast<uint32_t>(Value);
+			return true;
+		}
+
+		/**
+		 * \brief Append the footer, which holds the CRC32C of everything before it.
+		 * \param CompleteFileString All of the terminated records for the file.
+		 */
+		static FORCEINLINE void AppendFileFooter(std::string& CompleteFileString)
+		{
+			const uint32_t Crc = FCrc32C::Compute(CompleteFileString);
+			CompleteFileString.append(FILE_FOOTER_STRING);
+			CompleteFileString += CHECKSUM_DELIM_CHAR;
+			AppendChecksum(CompleteFileString, Crc);
 		}
-		
+
 		/**
-		 * \brief Add a @link FSetRequest to the buffer
-		 * \param SetRequest The @link FSetRequest to add to the buffer
-		 * \return Whether or not the Add worked
+		 * \brief Check a single record line against its trailing checksum.
+		 * \param Line The record, including its checksum but not the newline.
+		 * \param OutPayloadSize The size of the record without its checksum.
 		 */
-		static FORCEINLINE bool AWS_AddSetRequestToBuffer(
-			const FSetRequest& SetRequest)
+		static FORCEINLINE EIntegrityError VerifyRecord(
+			const char* Line,
+			const size_t LineSize,
+			size_t& OutPayloadSize)
 		{
-			if(SetRequest.IsEmpty())
+			static constexpr size_t SuffixSize = CHECKSUM_HEX_LENGTH + 1;
+			uint32_t ExpectedCrc;
+			if(LineSize < SuffixSize ||
+				Line[LineSize - SuffixSize] != CHECKSUM_DELIM_CHAR ||
+				!ParseChecksum(Line + LineSize - CHECKSUM_HEX_LENGTH, ExpectedCrc))
 			{
-				return false;
+				return EIntegrityError::RECORD_MALFORMED;
 			}
-			AWS_SetRequestBuffer.PushBack(SetRequest);
-			return true;
+			OutPayloadSize = LineSize - SuffixSize;
+			if(FCrc32C::Compute(Line, OutPayloadSize) != ExpectedCrc)
+			{
+				return EIntegrityError::RECORD_CHECKSUM_MISMATCH;
+			}
+			return EIntegrityError::NONE;
 		}
 
 		/**
-		 * \brief Write the entire @link FSetRequestBuffer to file
-		 * \param FileLocation The directory to put the file into
-		 * \return Whether or not the write worked
+		 * \brief Put a record that failed verification into quarantine. Once
+		 * MAX_QUARANTINED_RECORDS are waiting to be drained the record is
+		 * dropped and counted instead, so a stream of corrupt files cannot
+		 * grow the quarantine without bound.
 		 */
-		static FORCEINLINE void AWS_WriteSetRequestBufferToFile(
-			const std::string& FileLocation)
+		static FORCEINLINE void QuarantineRecord(
+			const std::string& FileLocation,
+			std::string&& Record,
+			const EIntegrityError Reason)
 		{
-			if(AWS_SetRequestBuffer.IsEmpty())
+			RecordsQuarantined.fetch_add(1, std::memory_order_relaxed);
+			QuarantineLock.Lock();
+			if(QuarantinedRecords.size() >= MAX_QUARANTINED_RECORDS)
 			{
+				QuarantineLock.Unlock();
+				RecordsQuarantineDropped.fetch_add(1, std::memory_order_relaxed);
 				return;
 			}
-			AWS_SetRequestBuffer.WriteSetRequestsToFileThroughLock(FileLocation);
+			QuarantinedRecords.push_back(
+				FQuarantinedRecord{FileLocation, std::move(Record), Reason});
+			QuarantineLock.Unlock();
 		}
 		
-		/*
-		 * TODO
+		/**
+		 * \brief Read the records from a file, checking the footer checksum and
+		 * the checksum of every record. Records that fail are quarantined rather
+		 * than returned.
+		 * \param FileLocation the location of the file (C:\\dir\\dir\\file)
+		 * \param OutRecords Output string vector to store the verified records in,
+		 * without their checksums.
+		 * \return Fails if the file is missing, truncated or its footer checksum
+		 * does not match. Any records that verified are still output.
 		 */
-		static FORCEINLINE bool WriteAttributeVectorToFile(
+		static FORCEINLINE bool ReadVerifiedRecordsFromFile(
 			const std::string& FileLocation,
-			const std::vector<FPlayerAttributeList>& InAttributeArray)
+			std::vector<std::string>& OutRecords)
 		{
-			if(InAttributeArray.size() == 0)
+			const std::ifstream File(FileLocation, std::ios::binary);
+			std::stringstream StreamBuffer;
+			StreamBuffer << File.rdbuf();
+			return VerifyRecordsFromText(FileLocation, StreamBuffer.str(), OutRecords);
+		}
+
+		/**
+		 * \brief The checks of @link ReadVerifiedRecordsFromFile, on a file's text
+		 * that is already in memory, such as a batch from the socket transport.
+		 * \param Source Where the text came from, recorded against quarantined records.
+		 */
+		static FORCEINLINE bool VerifyRecordsFromText(
+			const std::string& Source,
+			const std::string& FileText,
+			std::vector<std::string>& OutRecords)
+		{
+			if(FileText.size() == 0)
 			{
 				return false;
 			}
-			
-			std::string CompleteFileString = "";
-			for(int i = 0; i < InAttributeArray.size(); ++i)
-			{
-				std::string CurrentLine = "";
-				const FPlayerAttributeList PlayerAttributes =
-					InAttributeArray[i];
-
-				// Combine each attribute key and value into a string
-				// then append it to the line.
-				FAttributeStringPair StringPair;
-				std::string AttributeString = "";
-				for(int j = 0; j < PlayerAttributes.Size(); ++j)
-				{
-					if(PlayerAttributes[j] == TableKey_PlayerAuthID.Name)
-					{
-						StringPair.KeyString = TableKey_PlayerAuthID.Key;
-						StringPair.ValueString =
-							PlayerAttributes.GetPlayerAuthID().Value;
-					}
-					else if(PlayerAttributes[j] == TableKey_PlayerName.Name)
-					{
-						StringPair.KeyString = TableKey_PlayerName.Key;
-						StringPair.ValueString =
-							PlayerAttributes.GetPlayerName().Value;
-					}
-					else if(PlayerAttributes[j] == TableKey_IsOnline.Name)
-					{
-						StringPair.KeyString = TableKey_IsOnline.Key;
-						StringPair.ValueString =
-							(PlayerAttributes.GetIsOnline().Value) ?
-								(TRUE_STRING) : (FALSE_STRING);
-					}
 
-					AttributeString = StringPair.KeyString +
-						ATTRIBUTE_DELIM_CHAR + StringPair.ValueString + DELIM_CHAR;
-					CurrentLine.append(AttributeString);
-				}
+			size_t RecordsEnd;
+			const EIntegrityError FileError = VerifyFileFooter(FileText, RecordsEnd);
+			VerifyRecordLines(Source, FileText, RecordsEnd, OutRecords);
+			return CountFileIntegrity(FileError);
+		}
 
-				CurrentLine += NEWLINE_CHAR; // add the newline char onto the end
-				CompleteFileString.append(CurrentLine); // add the line to the file text
+		/**
+		 * \brief Check the footer of a file's text and the checksum of
+		 * everything before it.
+		 * \param OutRecordsEnd Where the records end. A missing footer means the
+		 * file was cut short, the trailing partial line is a record that never
+		 * finished being written and is left in for the record checks to catch.
+		 */
+		static FORCEINLINE EIntegrityError VerifyFileFooter(
+			const std::string& FileText,
+			size_t& OutRecordsEnd)
+		{
+			// The footer is everything after the last newline
+			const size_t LastNewline = FileText.rfind(NEWLINE_CHAR);
+			const size_t FooterStart = (LastNewline == std::string::npos) ?
+				(0) : (LastNewline + 1);
+			static constexpr size_t FooterPrefixSize =
+				sizeof(FILE_FOOTER_STRING) - 1;
+			uint32_t ExpectedFileCrc;
+			if(FileText.size() - FooterStart !=
+					FooterPrefixSize + 1 + CHECKSUM_HEX_LENGTH ||
+				FileText.compare(FooterStart, FooterPrefixSize, FILE_FOOTER_STRING) != 0 ||
+				FileText[FooterStart + FooterPrefixSize] != CHECKSUM_DELIM_CHAR ||
+				!ParseChecksum(&FileText[FooterStart + FooterPrefixSize + 1], ExpectedFileCrc))
+			{
+				OutRecordsEnd = FileText.size();
+				return EIntegrityError::FILE_FOOTER_MISSING;
 			}
-			CompleteFileString.append(FILE_FOOTER_STRING); // add the footer
-
-			// Generate a unique name for this set request file
-			std::string UniqueFileName;
-			GeneratorUniqueFileName(UniqueFileName, ERequestType::SET);
-			const std::string FullPath = FileLocation + UniqueFileName;
-			
-			// write the data to the file
-			FILE *File;
-			fopen_s(&File, FullPath.c_str(), WRITE_MODE);
-			if(!File)
+			OutRecordsEnd = FooterStart;
+			if(FCrc32C::Compute(FileText.data(), FooterStart) != ExpectedFileCrc)
 			{
-				return false;
+				return EIntegrityError::FILE_CHECKSUM_MISMATCH;
 			}
-			fputs(CompleteFileString.c_str(), File);
-			fclose(File);
-			return true;
+			return EIntegrityError::NONE;
 		}
 
-		/*
-		 * TODO
+		/**
+		 * \brief Count a file as verified or failed.
+		 * \return Whether it verified.
 		 */
-		static FORCEINLINE void ReadFromFileAndGetAttributes(
-			const std::string& FileLocation,
-			std::vector<FPlayerAttributeList>& OutAttributeVector)
+		static FORCEINLINE bool CountFileIntegrity(const EIntegrityError FileError) noexcept
 		{
-			std::vector<std::string> FileLines;
-			ReadLinesFromFile(FileLocation, FileLines);
-			// Split attributes into strings
-			for(int i = 0; i < FileLines.size(); ++i)
+			if(FileError != EIntegrityError::NONE)
 			{
-				// Split the line into attributes
-				const std::string LineString = FileLines[i];
-				std::vector<std::string> AttributeStrings;
-				SplitLineIntoAttributeStrings(LineString, AttributeStrings);
-				// Split each attribute into is key/value pair as stringss
-				std::vector<FAttributeStringPair> SplitAttributes;
-				SplitAttributeStrings(AttributeStrings, SplitAttributes);
-				// Put attributes into FPlayerAttributeList
-				FPlayerAttributeList PlayerAttributes;
-				ConvertSplitAttributesToPlayerAttributes(
-					SplitAttributes, PlayerAttributes);
-				// Make sure there was actually something to update
-				if(!PlayerAttributes.IsEmpty())
-				{
-					// Push the now assembled FPlayerAttributeList into the vector
-					OutAttributeVector.push_back(PlayerAttributes);
-				}
+				FilesFailed.fetch_add(1, std::memory_order_relaxed);
+				return false;
 			}
+			FilesVerified.fetch_add(1, std::memory_order_relaxed);
+			return true;
 		}
 
 		/**
-		 * \brief Create a unique ID for a @link FIPCRequest
+		 * \brief Check each record line before RecordsEnd against its own
+		 * checksum, quarantining the ones that fail. Segment streams have no
+		 * footer, so their records only get this check.
 		 */
-		static FORCEINLINE std::string GenerateUniqueRequestID() noexcept
-		{
-			const FToken UniqueIDToken = FToken::GenerateNewToken();
-			const std::string UniqueIDString = UniqueIDToken.ToString();
-			return UniqueIDString;
-		}
-		
-	private:
-		static FORCEINLINE void Initialize()
+		static FORCEINLINE void VerifyRecordLines(
+			const std::string& Source,
+			const std::string& Text,
+			const size_t RecordsEnd,
+			std::vector<std::string>& OutRecords)
 		{
+			VerifyRecordLines(Source, Text, 0, RecordsEnd, OutRecords);
 		}
 
-		static FORCEINLINE void Shutdown()
+		/**
+		 * \brief @link VerifyRecordLines for the records from RecordsStart, which
+		 * must be the start of a record, such as a chunk from
+		 * @link RecordStatics::FindChunkEnd.
+		 */
+		static FORCEINLINE void VerifyRecordLines(
+			const std::string& Source,
+			const std::string& Text,
+			const size_t RecordsStart,
+			const size_t RecordsEnd,
+			std::vector<std::string>& OutRecords)
 		{
+			const std::string_view Records(Text.data(), RecordsEnd);
+			size_t LineStart = RecordsStart;
+			while(LineStart < RecordsEnd)
+			{
+				const size_t RecordEnd = RecordStatics::FindRecordEnd(Records, LineStart);
+				const size_t LineEnd = (RecordEnd == std::string_view::npos) ?
+					(RecordsEnd) : (RecordEnd - 1);
+				
+				size_t PayloadSize = 0;
+				const EIntegrityError RecordError = VerifyRecord(
+					&Text[LineStart], LineEnd - LineStart, PayloadSize);
+				if(RecordError == EIntegrityError::NONE)
+				{
+					RecordsVerified.fetch_add(1, std::memory_order_relaxed);
+					OutRecords.emplace_back(Text, LineStart, PayloadSize);
+				}
+				else
+				{
+					QuarantineRecord(Source,
+						Text.substr(LineStart, LineEnd - LineStart),
+						RecordError);
+				}
+				LineStart = LineEnd + 1;
+			}
 		}
-		
+
 		/**
-		 * \brief Create a file with a given name and location.
-		 * \param FileStream
-		 * \param FileName Name of the file.
-		 * \param Directory Full directory path to put the file in.
+		 * \brief Parse one GET record, RequestID-PlayerAuth,Key,Key,
+		 * \return Fails if the request ID is not a number or there is no player auth.
 		 */
-		static FORCEINLINE void CreateFile(
-			FILE *FileStream,
-			const std::string& FileName,
-			const std::string& Directory)
+		static FORCEINLINE bool ParseGetRecord(
+			const std::string& Line,
+			FGetRequest& OutRequest)
 		{
-			const std::string FileLocation = Directory + "\\" + FileName;
-			fopen_s(&FileStream, FileLocation.c_str(), WRITE_MODE);
+			if(!Line.empty() && Line[0] == BINARY_RECORD_MARKER)
+			{
+				return DecodeBinaryGetRecord(Line, OutRequest);
+			}
+			
+			const size_t IDEnd = Line.find(REQUEST_ID_DELIM_CHAR);
+			const size_t AuthEnd = Line.find(DELIM_CHAR);
+			FRequestID RequestID;
+			if(IDEnd == std::string::npos || AuthEnd == std::string::npos ||
+				AuthEnd < IDEnd ||
+				!RequestIDStatics::Parse(std::string_view(Line.data(), IDEnd), RequestID))
+			{
+				return false;
+			}
+
+			FGetRequest Request(
+				IAttributeString(EAttributeName::PLAYER_AUTH,
+					Line.substr(IDEnd + 1, AuthEnd - IDEnd - 1)),
+				RequestID);
+			size_t KeyStart = AuthEnd + 1;
+			while(KeyStart < Line.size())
+			{
+				size_t KeyEnd = Line.find(DELIM_CHAR, KeyStart);
+				if(KeyEnd == std::string::npos)
+				{
+					break;
+				}
+				const std::string_view Key(Line.data() + KeyStart, KeyEnd - KeyStart);
+				if(Key == TableKey_PlayerAuthID.Key)
+				{
+					Request.AddAttributeToGet(EAttributeName::PLAYER_AUTH);
+				}
+				else if(Key == TableKey_PlayerName.Key)
+				{
+					Request.AddAttributeToGet(EAttributeName::PLAYER_NAME);
+				}
+				else if(Key == TableKey_IsOnline.Key)
+				{
+					Request.AddAttributeToGet(EAttributeName::IS_ONLINE);
+				}
+				KeyStart = KeyEnd + 1;
+			}
+			OutRequest = std::move(Request);
+			return true;
 		}
 
 		/**
-		 * \brief Delete a certain file.
-		 * \param FileName Name of the file.
-		 * \param Directory Full directory path to put the file in.
+		 * \brief Step past the marker and length of a binary record.
+		 * \return Fails unless the length covers exactly the rest of the record.
 		 */
-		static FORCEINLINE void DeleteFile(
-			const std::string& FileName,
-			const std::string& Directory)
+		static FORCEINLINE bool OpenBinaryRecord(
+			const std::string& Record,
+			const char*& OutIn,
+			const char*& OutEnd) noexcept
 		{
-			const std::string FileLocation = Directory + "\\" + FileName;
-			remove(FileLocation.c_str());
+			OutIn = Record.data() + 1;
+			OutEnd = Record.data() + Record.size();
+			uint64_t Length;
+			return ValueCodecStatics::ReadVarint(OutIn, OutEnd, Length) &&
+				Length == static_cast<uint64_t>(OutEnd - OutIn);
 		}
 
-		/*
-		 * TODO
+		/**
+		 * \brief Decode a GET record written by @link RecordStatics::BeginBinaryGetRecord.
 		 */
-		static FORCEINLINE bool WriteStringToFile(
-			const std::string& FullNameAndPath,
-			const std::string& FileString)
+		static FORCEINLINE bool DecodeBinaryGetRecord(
+			const std::string& Record,
+			FGetRequest& OutRequest)
 		{
-			FILE *File;
-			fopen_s(&File, FullNameAndPath.c_str(), WRITE_MODE);
-			if(!File)
+			using namespace ValueCodecStatics;
+			const char* In;
+			const char* End;
+			uint64_t RequestID;
+			std::string PlayerAuthID;
+			uint64_t Count;
+			if(!OpenBinaryRecord(Record, In, End) ||
+				!ReadVarint(In, End, RequestID) ||
+				!TValueCodec<EAttributeTypes::STRING>::Decode(In, End, PlayerAuthID) ||
+				!ReadVarint(In, End, Count) ||
+				Count != static_cast<uint64_t>(End - In))
 			{
 				return false;
 			}
-			fputs(FileString.c_str(), File);
-			fclose(File);
+
+			FGetRequest Request(
+				IAttributeString(EAttributeName::PLAYER_AUTH, PlayerAuthID), RequestID);
+			for(; In < End; ++In)
+			{
+				const EAttributeName Name = static_cast<EAttributeName>(*In);
+				if(TableDataStatics::GetAttributeType(Name) != EAttributeTypes::NONE)
+				{
+					Request.AddAttributeToGet(Name);
+				}
+			}
+			OutRequest = std::move(Request);
 			return true;
 		}
-		
+
 		/**
-		 * \brief Read a list of player attribute strings from a file, stores
-		 * them in an output variable.
-		 * \param FileLocation the location of the file (C:\\dir\\dir\\file)
-		 * \param OutStringArray Output string vector to store the player attribute
-		 * strings in.
+		 * \brief Decode a SET record written by @link RecordStatics::FBinarySetRecordEncoder.
+		 * \return Fails if the record is cut short or names an attribute with no type.
 		 */
-		static FORCEINLINE bool ReadLinesFromFile(
-			const std::string& FileLocation,
-			std::vector<std::string>& OutStringArray)
+		static FORCEINLINE bool DecodeBinarySetRecord(
+			const std::string& Record,
+			FPlayerAttributeList& OutAttributes,
+			FRequestID& OutRequestID)
 		{
-			const std::ifstream File(FileLocation);
-			std::stringstream StreamBuffer;
-			StreamBuffer << File.rdbuf(); // hate doing this
-			const std::string FileText = StreamBuffer.str();
-			if(FileText.size() == 0)
+			using namespace ValueCodecStatics;
+			constexpr uint64_t BoolMask = RecordStatics::GetBoolAttributeMask();
+			const char* In;
+			const char* End;
+			uint64_t Mask;
+			uint64_t BoolBits = 0;
+			if(!OpenBinaryRecord(Record, In, End) ||
+				!ReadVarint(In, End, Mask))
+			{
+				return false;
+			}
+			if(Mask & RecordStatics::BinaryRequestIDBit)
+			{
+				Mask &= ~RecordStatics::BinaryRequestIDBit;
+				if(!ReadVarint(In, End, OutRequestID))
+				{
+					return false;
+				}
+			}
+			if((Mask & BoolMask) && !ReadVarint(In, End, BoolBits))
 			{
 				return false;
 			}
 
-			std::string LineBuffer = "";
-			for(int i = 0; i < FileText.size(); ++i)
+			int NumberOfBools = 0;
+			std::string String;
+			for(int Index = 0; Index < 64; ++Index)
 			{
-				if(FileText[i] == NEWLINE_CHAR)
+				if((Mask & (uint64_t(1) << Index)) == 0)
 				{
-					OutStringArray.push_back(LineBuffer);
-					LineBuffer.erase();
+					continue;
 				}
-				else
+				const EAttributeName Name = static_cast<EAttributeName>(Index);
+				switch(TableDataStatics::GetAttributeType(Name))
 				{
-					LineBuffer += FileText[i];
+					case EAttributeTypes::STRING:
+						if(!TValueCodec<EAttributeTypes::STRING>::Decode(In, End, String))
+						{
+							return false;
+						}
+						if(Name == EAttributeName::PLAYER_AUTH)
+						{
+							OutAttributes.SetPlayerAuthID(IAttributeString(Name, String));
+						}
+						else if(Name == EAttributeName::PLAYER_NAME)
+						{
+							OutAttributes.SetPlayerName(IAttributeString(Name, String));
+						}
+						break;
+					case EAttributeTypes::INT:
+					{
+						// No attribute holds an int yet, the value is only stepped over
+						int64_t Int;
+						if(!TValueCodec<EAttributeTypes::INT>::Decode(In, End, Int))
+						{
+							return false;
+						}
+						break;
+					}
+					case EAttributeTypes::FLOAT:
+					{
+						float Float;
+						if(!TValueCodec<EAttributeTypes::FLOAT>::Decode(In, End, Float))
+						{
+							return false;
+						}
+						break;
+					}
+					case EAttributeTypes::BOOL:
+					{
+						const bool bValue = ((BoolBits >> NumberOfBools++) & 1) != 0;
+						if(Name == EAttributeName::IS_ONLINE)
+						{
+							OutAttributes.SetIsOnline(IAttributeBool(Name, bValue));
+						}
+						break;
+					}
+					default:
+						return false;
 				}
 			}
-			
-			return (OutStringArray.size() > 0);
+			return In == End;
 		}
 
 		/*
 		 * TODO
 		 */
 		static FORCEINLINE void SplitLineIntoAttributeStrings(
-			const std::string& LineString,
+			const std::string_view LineString,
 			std::vector<std::string>& AttributeStrings
 			)
 		{
@@ -1804,6 +13015,89 @@ namespace IPCFile
 			}
 		}
 		
+		/**
+		 * \brief Call a functor with the name and type of each entry in a
+		 * directory, other than . and .. On Linux the entries come straight
+		 * from getdents64, so only a file system that doesn't fill in d_type
+		 * costs a stat per entry.
+		 * \param Functor Called as (const char* Name, size_t Length, @link EDirectoryEntryType).
+		 * \return Fails if the directory couldn't be opened or read.
+		 */
+		template<typename TFunctor>
+		static FORCEINLINE bool ForEachDirectoryEntry(const std::string& Directory, TFunctor&& Functor)
+		{
+#if defined(_WIN64) || defined(_WIN32)
+			std::error_code Error;
+			std::filesystem::directory_iterator Entries(Directory, Error);
+			if(Error)
+			{
+				return false;
+			}
+			for(const auto& Entry : Entries)
+			{
+				const std::string Name = Entry.path().filename().string();
+				const EDirectoryEntryType Type = (Entry.is_regular_file(Error)) ?
+					(EDirectoryEntryType::FILE) : ((Entry.is_directory(Error)) ?
+						(EDirectoryEntryType::DIRECTORY) : (EDirectoryEntryType::OTHER));
+				Functor(Name.c_str(), Name.size(), Type);
+			}
+			return true;
+#else
+			const int Handle = open(Directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+			if(Handle < 0)
+			{
+				return false;
+			}
+			
+			// linux_dirent64: ino(8) off(8) reclen(2) type(1) name
+			constexpr size_t RecordLengthOffset = 16;
+			constexpr size_t TypeOffset = 18;
+			constexpr size_t NameOffset = 19;
+			alignas(8) char Buffer[32768];
+			for(;;)
+			{
+				const long Read = syscall(SYS_getdents64, Handle, Buffer, sizeof(Buffer));
+				if(Read < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				if(Read <= 0)
+				{
+					close(Handle);
+					return Read == 0;
+				}
+				
+				for(long Offset = 0; Offset < Read;)
+				{
+					const char* Record = Buffer + Offset;
+					uint16_t RecordLength;
+					std::memcpy(&RecordLength, Record + RecordLengthOffset, sizeof(RecordLength));
+					Offset += RecordLength;
+					const char* Name = Record + NameOffset;
+					if(Name[0] == '.' && (Name[1] == '\0' || (Name[1] == '.' && Name[2] == '\0')))
+					{
+						continue;
+					}
+					
+					unsigned char EntryType = static_cast<unsigned char>(Record[TypeOffset]);
+					if(EntryType == DT_UNKNOWN)
+					{
+						struct stat Status;
+						if(fstatat(Handle, Name, &Status, AT_SYMLINK_NOFOLLOW) != 0)
+						{
+							continue;
+						}
+						EntryType = (S_ISREG(Status.st_mode)) ?
+							(DT_REG) : ((S_ISDIR(Status.st_mode)) ? (DT_DIR) : (DT_UNKNOWN));
+					}
+					Functor(Name, std::strlen(Name), (EntryType == DT_REG) ?
+						(EDirectoryEntryType::FILE) : ((EntryType == DT_DIR) ?
+							(EDirectoryEntryType::DIRECTORY) : (EDirectoryEntryType::OTHER)));
+				}
+			}
+#endif
+		}
+		
 		/**
 		 * \brief Get a list of files in a particular directory
 		 * \param Directory The directory to search for files in
@@ -1814,74 +13108,49 @@ namespace IPCFile
 			const std::string& Directory,
 			std::vector<std::string>& OutFileList)
 		{
-			if(!std::filesystem::exists(Directory))
-			{
-				return false;
-			}
-			
-			for(const auto& File :
-				std::filesystem::directory_iterator(Directory))
-			{
-				OutFileList.push_back(File.path().string());
-			}
-			return OutFileList.size() > 0;
+			const std::filesystem::path Root(Directory);
+			const size_t FirstFile = OutFileList.size();
+			ForEachDirectoryEntry(Directory,
+				[&Root, &OutFileList](const char* Name, const size_t Length, const EDirectoryEntryType)
+				{
+					OutFileList.push_back((Root / std::string_view(Name, Length)).string());
+				});
+			return OutFileList.size() > FirstFile;
 		}
 		
 		/**
-		 * \brief Create a unique file name
+		 * \brief Create a unique file name, TYPE#TIME#INSTANCE#SEQUENCE, that
+		 * sorts lexically in creation order for a given request type. HIGH
+		 * priority files are marked TYPE!#..., which sorts before TYPE#...
 		 * \param Out The string to store the generated name in
 		 * \param RequestType The type of request the file name is for
+		 * \param Priority The lane the requests in the file came from
 		 */
 		static FORCEINLINE void GeneratorUniqueFileName(std::string& Out,
-			const ERequestType& RequestType)
+			const ERequestType& RequestType,
+			const ERequestPriority Priority = ERequestPriority::NORMAL)
 		{
-			const FToken UniqueIDToken = FToken::GenerateNewToken();
-			const std::string UniqueIDString = UniqueIDToken.ToString();
-			std::string RequestTypeString;
+			Out.clear();
 			switch(RequestType)
 			{
 				case ERequestType::GET:
-					RequestTypeString = GET_REQUEST_STRING;
+					Out.append(GET_REQUEST_STRING);
 					break;
 				case ERequestType::GET_RESPONSE:
-					RequestTypeString = GET_RESPONSE_REQUEST_STRING;
+					Out.append(GET_RESPONSE_REQUEST_STRING);
 					break;
 				case ERequestType::SET:
-					RequestTypeString = SET_REQUEST_STRING;
+					Out.append(SET_REQUEST_STRING);
 					break;
 				default:
 					break;
 			}
-			const std::string SystemTime = GetSystemTimeAsString();
-			if(SystemTime == NULL_STRING)
-			{
-				Out = NULL_STRING;
-				return;
-			}
-			// Output the file name
-			Out = RequestTypeString + FILE_DELIM_CHAR + UniqueIDString +
-				FILE_DELIM_CHAR + SystemTime;
-		}
-		
-		/**
-		 * \brief Get the system time as a @link std::string
-		 * \return An @link std::string that represents the current local time.
-		 */
-		static FORCEINLINE std::string GetSystemTimeAsString() noexcept
-		{
-			time_t CurrentTime;
-			tm *TimeStruct = new tm();
-			time(&CurrentTime);
-			localtime_s(TimeStruct, &CurrentTime);
-			std::string Time = NULL_STRING;
-			if(TimeStruct)
+			if(Priority == ERequestPriority::HIGH)
 			{
-				Time = std::to_string(TimeStruct->tm_hour) + FILE_TIME_DELIM_CHAR + 
-					std::to_string(TimeStruct->tm_min) + FILE_TIME_DELIM_CHAR + 
-					std::to_string(TimeStruct->tm_sec);
+				Out += PRIORITY_FILE_MARKER_CHAR;
 			}
-			delete TimeStruct;
-			return Time;
+			Out += FILE_DELIM_CHAR;
+			FUniqueIDGenerator::GenerateFileID(RequestType).AppendTo(Out);
 		}
 
 	private:
@@ -1891,24 +13160,74 @@ namespace IPCFile
 		inline static FSetRequestBuffer			<ERequestBufferType::UE>		UE_SetRequestBuffer;
 		inline static FWriteBufferThread		<ERequestBufferType::UE>		UE_SetWriteThread;
 		inline static FReadBufferThread			<ERequestBufferType::UE>		UE_SetReadThread;
+		/** A response file that fails its integrity check is read this many times before it is removed */
+		static constexpr uint8_t MaxResponseReadAttempts = 3;
+		inline static FSpinLoop<false> UE_ResponseScanLock;
+		inline static FDirectoryScanner UE_ResponseScanner;
+		inline static std::unordered_map<std::string, uint8_t> UE_ResponseReadAttempts;
 
 		inline static FPendingGetRequestBuffer	<ERequestBufferType::UE>		UE_GetPendingRequestsBuffer;
 		inline static FReadBufferThread			<ERequestBufferType::UE>		UE_GetPendingThread;
+
+		inline static std::atomic<bool> bUseCompactRequestBuffers = {false};
+		inline static std::atomic<bool> bUseDeltaSetRequests = {false};
+		inline static std::atomic<uint64_t> UnchangedSetsDropped = {0};
+		inline static FPlayerShadowTable UE_PlayerShadows;
+		inline static FCompactRequestBuffer<ERequestType::GET, ERequestBufferType::UE> UE_CompactGetRequestBuffer{true};
+		inline static FCompactRequestBuffer<ERequestType::SET, ERequestBufferType::UE> UE_CompactSetRequestBuffer;
+		inline static FCompactRequestBuffer<ERequestType::GET, ERequestBufferType::UE> UE_CompactPendingGetRequests;
+		inline static FPriorityLane<FGetRequestBuffer<ERequestBufferType::UE>> UE_PriorityGetLane;
+		inline static FPriorityLane<FSetRequestBuffer<ERequestBufferType::UE>> UE_PrioritySetLane;
+		inline static FSpinLoop<false> UE_AsyncGetLock;
+		inline static std::unordered_map<FRequestID, std::shared_ptr<FAsyncGetState>> UE_AsyncGets;
+		inline static TMPSCQueue<FQueuedCompletion> UE_CompletionQueue;
+		inline static FSpinLoop<false> UE_CompletionHandlerLock;
+		inline static std::shared_ptr<const std::function<void(const FIPCCompletion&)>> UE_CompletionHandler;
+		inline static std::atomic<bool> bIsDispatchingCompletions = {false};
+		inline static std::atomic<bool> bAcknowledgeSetRequests = {false};
+		inline static FFlushTriggerConfig UE_GetRequestFlushConfig;
+		inline static FFlushTriggerConfig UE_SetRequestFlushConfig;
+#if IPC_HAS_UNIX_SOCKETS
+		inline static FSocketTransport UE_Transport;
+#endif
+#if IPC_HAS_SEGMENT_FILES
+		inline static FSegmentPool UE_SegmentPool;
+#endif
 		
 		inline static FSetRequestBuffer			<ERequestBufferType::AWS>		AWS_SetRequestBuffer;
 		inline static FWriteBufferThread		<ERequestBufferType::AWS>		AWS_SetWriteThread;
 		inline static FReadBufferThread			<ERequestBufferType::AWS>		AWS_SetReadThread;
 		inline static FReadBufferThread			<ERequestBufferType::AWS>		AWS_GetReadThread;
+		inline static FPriorityLane<FSetRequestBuffer<ERequestBufferType::AWS>> AWS_PrioritySetLane;
+		inline static FFlushTriggerConfig AWS_SetRequestFlushConfig;
+#if IPC_HAS_UNIX_SOCKETS
+		inline static FSocketTransport AWS_Transport;
+#endif
+		inline static FSpinLoop<false> AWS_BackendLock;
+		inline static std::shared_ptr<IAWSBackend> AWS_Backend;
+		inline static FAWSRequestPipeline AWS_RequestPipeline;
+
+		inline static std::atomic<ERecordEncoding> RecordEncoding = {ERecordEncoding::TEXT};
+		inline static std::atomic<uint64_t> RecordsVerified = {0};
+		inline static std::atomic<uint64_t> RecordsQuarantined = {0};
+		inline static std::atomic<uint64_t> RecordsQuarantineDropped = {0};
+		inline static std::atomic<uint64_t> FilesVerified = {0};
+		inline static std::atomic<uint64_t> FilesFailed = {0};
+		inline static FSpinLoop<false> QuarantineLock;
+		inline static FSpinLoop<false> FlushConfigLock;
+		inline static std::vector<FQuarantinedRecord> QuarantinedRecords;
 	};
 }
 
 #undef SPIN_LOOP_PAUSE
+#undef IPC_SSE42_TARGET
 
 #undef NEWLINE_CHAR
 #undef DELIM_CHAR
 #undef WRITE_MODE
 #undef READ_MODE
 #undef FILE_EXTENSION
+#undef UNVERIFIED_FILE_EXTENSION
 #undef ATTRIBUTE_DELIM_CHAR
 #undef TRUE_STRING
 #undef FALSE_STRING
@@ -1919,22 +13238,65 @@ namespace IPCFile
 #undef GET_RESPONSE_REQUEST_STRING
 #undef SET_REQUEST_STRING		
 #undef FILE_DELIM_CHAR
-#undef FILE_TIME_DELIM_CHAR
+#undef PRIORITY_FILE_MARKER_CHAR
 #undef FILE_FOOTER_STRING
+#undef CHECKSUM_DELIM_CHAR
+#undef CHECKSUM_HEX_LENGTH
+#undef BINARY_RECORD_MARKER
 #undef FILE_DIRECTORY_DELIM
 
 #undef ATTRIBUTE_CHAR_MAX
 
-#undef UE_BUFFER_MAX
-#undef AWS_BUFFER_MAX
+#undef REQUEST_BUFFER_CHUNK_BYTES
+#undef REQUEST_BUFFER_MAX_FREE_CHUNKS
+#undef MAX_QUARANTINED_RECORDS
 #undef PENDING_REQUEST_RESERVE_SIZE
 
+#undef UE_BUFFER_CAPACITY
+#undef AWS_BUFFER_CAPACITY
+#undef BUFFER_BLOCK_TIMEOUT_MS
+#undef ASYNC_GET_TIMEOUT_MS
+#undef PLAYER_SHADOW_CAPACITY
+
+#undef COMPACT_BATCH_RESERVE_SIZE
+#undef COMPACT_ARENA_RESERVE_SIZE
+
 #undef UE_BUFFER_TICK_RATE
 #undef AWS_BUFFER_TICK_RATE
 
+#undef AWS_PIPELINE_IN_FLIGHT
+#undef AWS_PIPELINE_BATCH_SIZE
+#undef AWS_PIPELINE_QUEUE_CAPACITY
+#undef AWS_PIPELINE_PARSE_WORKERS
+#undef AWS_PARSE_CHUNK_BYTES
+#undef AWS_PRODUCER_QUANTUM_BYTES
+
+#undef SOCKET_FRAME_MAGIC
+#undef SOCKET_DEFAULT_CREDITS
+#undef SOCKET_MAX_FRAME_BYTES
+#undef SOCKET_RECONNECT_INTERVAL_MS
+
+#undef SEGMENT_MAGIC
+#undef SEGMENT_FILE_PREFIX
+#undef SEGMENT_FILE_EXTENSION
+#undef SEGMENT_PAYLOAD_OFFSET
+#undef SEGMENT_DEFAULT_COUNT
+#undef SEGMENT_DEFAULT_BYTES
+#undef SEGMENT_RESCAN_INTERVAL_MS
+#undef SEGMENT_COMMIT_BYTES
+#undef SEGMENT_ROTATE_AFTER_MS
+#undef SEGMENT_TAIL_POLL_MS
+#undef SEGMENT_CURSOR_EXTENSION
+
 #undef IPC_PLATFORM_CACHE_LINE_SIZE
 #undef IPC_ALIGN_TO_CACHE_LINE
+#undef IPC_ALIGN_REQUEST_PAYLOAD
+#undef IPC_PACK_REQUESTS
 
 #undef SPIN_LOOP_SLEEP_TIME_MS
 
+#undef IPC_HAS_COROUTINES
+#undef IPC_HAS_UNIX_SOCKETS
+#undef IPC_HAS_SEGMENT_FILES
+
 #endif